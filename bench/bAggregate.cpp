@@ -0,0 +1,133 @@
+/**
+ * \file bAggregate.cpp
+ * \date Oct 16, 2026
+ *
+ * Field aggregates over a run of records: a loop of get<X>() calls versus
+ * the aggregation kernels at each SIMD level, and the threaded reduction.
+ */
+
+#include "bench.hpp"
+
+#include <cppbitfield/bitfield_aggregate.hpp>
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+DEFINE_BITFIELD_ENUM(
+     TaskEnum,
+           State,
+           Flags,
+           Prio,
+           Owner);
+
+DEFINE_BITFIELD_SIZES(
+    TaskSizes,
+           3,
+           4,
+           2,
+          23);
+
+DEFINE_BITFIELDS(
+    Task,
+    TaskEnum,
+    TaskSizes);
+
+namespace {
+
+    const std::size_t NUM_RECORDS = 1 << 24;
+    const int REPEATS = 10;
+
+#if defined(__GNUC__)
+    __attribute__((noinline))
+#endif
+    void histogramByHand(const std::vector<Task> & recs, uint64_t * counts)
+    {
+        for (std::size_t v = 0; v < 8; ++v) {
+            counts[v] = 0;
+        }
+        for (std::size_t i = 0; i < recs.size(); ++i) {
+            ++counts[recs[i].get<TaskEnum::State>()];
+        }
+    }
+
+#if defined(__GNUC__)
+    __attribute__((noinline))
+#endif
+    uint64_t sumByHand(const std::vector<Task> & recs)
+    {
+        uint64_t total = 0;
+        for (std::size_t i = 0; i < recs.size(); ++i) {
+            total += recs[i].get<TaskEnum::Owner>();
+        }
+        return total;
+    }
+
+    template <class Fn>
+    double nsPerRecord(Fn fn)
+    {
+        bench::Timer t;
+        for (int r = 0; r < REPEATS; ++r) {
+            fn();
+            // the memory clobber keeps pure calls from being hoisted out
+            bench::doNotOptimize(r);
+        }
+        return t.elapsedSec() * 1e9 / (double(NUM_RECORDS) * REPEATS);
+    }
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    bench::Report report(argc, argv, "bAggregate");
+    std::vector<Task> recs(NUM_RECORDS);
+    uint64_t state = 1;
+    for (std::size_t i = 0; i < recs.size(); ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        // states change rarely, as in a real state column
+        const uint32_t bits = static_cast<uint32_t>(state >> 32) & ~7u;
+        recs[i] = Task::fromBits(bits | static_cast<uint32_t>((i >> 12) % 5));
+    }
+    uint64_t counts[8];
+    uint64_t total = 0;
+
+    const double histHand = nsPerRecord([&]() { histogramByHand(recs, counts); });
+    const double sumHand = nsPerRecord([&]() { total += sumByHand(recs); });
+    std::printf("%-14s histogram %7.3f  sum %7.3f ns/record\n", "get<X>()", histHand, sumHand);
+    report.add("histogram/get", histHand);
+    report.add("sum/get", sumHand);
+
+    const char * names[] = { "scalar", "sse2", "avx2", "avx512" };
+    for (int l = 0; l <= static_cast<int>(cppbitfield::simdLevel()); ++l) {
+        const cppbitfield::SimdLevel level = static_cast<cppbitfield::SimdLevel>(l);
+        const double hist = nsPerRecord([&]() {
+            cppbitfield::histogram<Task, TaskEnum::State>(recs.data(), NUM_RECORDS, counts, level);
+        });
+        const double sum = nsPerRecord([&]() {
+            total += cppbitfield::sum<Task, TaskEnum::Owner>(recs.data(), NUM_RECORDS, level);
+        });
+        const double mm = nsPerRecord([&]() {
+            total += cppbitfield::minmax<Task, TaskEnum::Owner>(recs.data(), NUM_RECORDS, level).second;
+        });
+        const double cnt = nsPerRecord([&]() {
+            total += cppbitfield::count<Task, TaskEnum::Prio>(recs.data(), NUM_RECORDS, 2, level);
+        });
+        std::printf("%-14s histogram %7.3f  sum %7.3f  minmax %7.3f  count %7.3f ns/record\n",
+                    names[l], hist, sum, mm, cnt);
+        report.add(std::string("histogram/") + names[l], hist);
+        report.add(std::string("sum/") + names[l], sum);
+        report.add(std::string("minmax/") + names[l], mm);
+        report.add(std::string("count/") + names[l], cnt);
+    }
+
+    const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    const double threaded = nsPerRecord([&]() {
+        cppbitfield::histogram<Task, TaskEnum::State>(recs.data(), NUM_RECORDS, counts, cppbitfield::simdLevel(), 0);
+    });
+    std::printf("%-14s histogram %7.3f ns/record on %u threads\n", "threaded", threaded, hw);
+    report.add("histogram/threads", threaded);
+    bench::doNotOptimize(total);
+    bench::doNotOptimize(counts[0]);
+    return 0;
+}
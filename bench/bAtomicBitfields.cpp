@@ -0,0 +1,120 @@
+/**
+ * \file bAtomicBitfields.cpp
+ * \date Oct 16, 2026
+ *
+ * Contention benchmark: threads hammer different fields of one shared
+ * status word, once through AtomicBitFields and once through a mutex
+ * guarding a plain BitFields.
+ */
+
+#include "bench.hpp"
+
+#include <cppbitfield/bitfield_atomic.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+DEFINE_BITFIELD_ENUM(
+     StatusEnum,
+           RefCount,
+           State,
+           Flags);
+
+DEFINE_BITFIELD_SIZES(
+    StatusSizes,
+          40,
+           8,
+          16);
+
+DEFINE_BITFIELDS(
+    Status,
+    StatusEnum,
+    StatusSizes);
+
+DEFINE_ATOMIC_BITFIELDS(
+    AtomicStatus,
+    StatusEnum,
+    StatusSizes);
+
+namespace {
+
+    const uint64_t OPS_PER_THREAD = 1000000;
+
+    struct LockedStatus
+    {
+        std::mutex lock;
+        Status value;
+    };
+
+    // thread 0 mod 3 bumps the refcount, 1 cycles the state, 2 rewrites flags
+    void lockedWorker(LockedStatus & s, int id)
+    {
+        for (uint64_t i = 0; i < OPS_PER_THREAD; ++i) {
+            std::lock_guard<std::mutex> guard(s.lock);
+            switch (id % 3) {
+              case 0:
+                s.value.set<StatusEnum::RefCount>(s.value.get<StatusEnum::RefCount>() + 1);
+                break;
+              case 1:
+                s.value.set<StatusEnum::State>(i & 0xFF);
+                break;
+              default:
+                s.value.set<StatusEnum::Flags>(i & 0xFFFF);
+                break;
+            }
+        }
+    }
+
+    void atomicWorker(AtomicStatus & s, int id)
+    {
+        uint64_t prev;
+        for (uint64_t i = 0; i < OPS_PER_THREAD; ++i) {
+            switch (id % 3) {
+              case 0:
+                s.fetch_add<StatusEnum::RefCount>(1, prev, std::memory_order_relaxed);
+                break;
+              case 1:
+                s.store<StatusEnum::State>(i & 0xFF, std::memory_order_relaxed);
+                break;
+              default:
+                s.store<StatusEnum::Flags>(i & 0xFFFF, std::memory_order_relaxed);
+                break;
+            }
+        }
+    }
+
+    template <class Shared, class Worker>
+    double run(int numThreads, Worker worker)
+    {
+        Shared shared;
+        std::vector<std::thread> threads;
+        bench::Timer timer;
+        for (int t = 0; t < numThreads; ++t) {
+            threads.push_back(std::thread(worker, std::ref(shared), t));
+        }
+        for (size_t t = 0; t < threads.size(); ++t) {
+            threads[t].join();
+        }
+        return timer.elapsedSec() * 1e9 / (OPS_PER_THREAD * numThreads);
+    }
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    bench::Report report(argc, argv, "bAtomicBitfields");
+    const int maxThreads = std::max(4, static_cast<int>(std::thread::hardware_concurrency()));
+    std::printf("%8s %14s %14s\n", "threads", "mutex ns/op", "atomic ns/op");
+    for (int n = 1; n <= maxThreads; n *= 2) {
+        const double locked = run<LockedStatus>(n, lockedWorker);
+        const double atomic = run<AtomicStatus>(n, atomicWorker);
+        std::printf("%8d %14.2f %14.2f\n", n, locked, atomic);
+        report.add("mutex/" + std::to_string(n) + "t", locked);
+        report.add("atomic/" + std::to_string(n) + "t", atomic);
+    }
+    return 0;
+}
@@ -0,0 +1,279 @@
+/**
+ * \file bBitfields.cpp
+ * \date Oct 16, 2026
+ *
+ * BitFields against C bitfields and hand-written shifts and masks, for every
+ * storage width: get, set and read-modify-write of the middle field, in
+ * sequential and random order, on one thread and on all hardware threads,
+ * plus the latency of a dependent chain of gets.
+ */
+
+#include "bench.hpp"
+
+#include <cppbitfield/bitfield.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+DEFINE_BITFIELD_ENUM(
+     LayoutEnum,
+           A,
+           B,
+           C);
+
+namespace {
+
+    const std::size_t NUM_RECORDS = 1 << 20;
+    const int REPEATS = 8;
+
+    // Three flavours of the same A/B/C layout per width. Each exposes Rec,
+    // getA, getB and setB; B is always the middle field.
+#define BENCH_LAYOUT(W, T, SA, SB, SC)                                                          \
+    struct Lib##W                                                                              \
+    {                                                                                          \
+        using Rec = cppbitfield::BitFields<LayoutEnum, cppbitfield::BitFieldSizes<SA, SB, SC> >; \
+        static const uint64_t MAX_B = (static_cast<uint64_t>(1) << SB) - 1;                    \
+        static uint64_t getA(const Rec & r) { return r.get<LayoutEnum::A>(); }                 \
+        static uint64_t getB(const Rec & r) { return r.get<LayoutEnum::B>(); }                 \
+        static void setB(Rec & r, uint64_t v) { r.set<LayoutEnum::B>(static_cast<T>(v)); }     \
+    };                                                                                         \
+                                                                                               \
+    struct Native##W                                                                           \
+    {                                                                                          \
+        struct Rec                                                                             \
+        {                                                                                      \
+            T a : SA;                                                                          \
+            T b : SB;                                                                          \
+            T c : SC;                                                                          \
+        };                                                                                     \
+        static const uint64_t MAX_B = (static_cast<uint64_t>(1) << SB) - 1;                    \
+        static uint64_t getA(const Rec & r) { return r.a; }                                    \
+        static uint64_t getB(const Rec & r) { return r.b; }                                    \
+        static void setB(Rec & r, uint64_t v) { r.b = static_cast<T>(v); }                     \
+    };                                                                                         \
+                                                                                               \
+    struct Mask##W                                                                             \
+    {                                                                                          \
+        using Rec = T;                                                                         \
+        static const uint64_t MAX_B = (static_cast<uint64_t>(1) << SB) - 1;                    \
+        static uint64_t getA(Rec r) { return r & ((static_cast<uint64_t>(1) << SA) - 1); }     \
+        static uint64_t getB(Rec r) { return (r >> SA) & MAX_B; }                              \
+        static void setB(Rec & r, uint64_t v)                                                  \
+        {                                                                                      \
+            r = static_cast<T>((r & ~(MAX_B << SA)) | (v << SA));                              \
+        }                                                                                      \
+    }
+
+    BENCH_LAYOUT(8, uint8_t, 3, 2, 3);
+    BENCH_LAYOUT(16, uint16_t, 5, 6, 5);
+    BENCH_LAYOUT(32, uint32_t, 10, 12, 10);
+    BENCH_LAYOUT(64, uint64_t, 20, 24, 20);
+
+#undef BENCH_LAYOUT
+
+    // 128 bits: B straddles the word boundary.
+    struct Lib128
+    {
+        using Rec = cppbitfield::BitFields<LayoutEnum, cppbitfield::BitFieldSizes<40, 48, 40> >;
+        static const uint64_t MAX_B = (static_cast<uint64_t>(1) << 48) - 1;
+        static uint64_t getA(const Rec & r) { return r.get<LayoutEnum::A>(); }
+        static uint64_t getB(const Rec & r) { return r.get<LayoutEnum::B>(); }
+        static void setB(Rec & r, uint64_t v) { r.set<LayoutEnum::B>(v); }
+    };
+
+    // the compiler starts B on a fresh 64-bit unit, so this one is 24 bytes
+    struct Native128
+    {
+        struct Rec
+        {
+            uint64_t a : 40;
+            uint64_t b : 48;
+            uint64_t c : 40;
+        };
+        static const uint64_t MAX_B = (static_cast<uint64_t>(1) << 48) - 1;
+        static uint64_t getA(const Rec & r) { return r.a; }
+        static uint64_t getB(const Rec & r) { return r.b; }
+        static void setB(Rec & r, uint64_t v) { r.b = v; }
+    };
+
+    struct Mask128
+    {
+        struct Rec
+        {
+            uint64_t w[2];
+        };
+        static const uint64_t MAX_B = (static_cast<uint64_t>(1) << 48) - 1;
+        static uint64_t getA(const Rec & r) { return r.w[0] & ((static_cast<uint64_t>(1) << 40) - 1); }
+        static uint64_t getB(const Rec & r) { return ((r.w[0] >> 40) | (r.w[1] << 24)) & MAX_B; }
+        static void setB(Rec & r, uint64_t v)
+        {
+            r.w[0] = (r.w[0] & ((static_cast<uint64_t>(1) << 40) - 1)) | (v << 40);
+            r.w[1] = (r.w[1] & ~((static_cast<uint64_t>(1) << 24) - 1)) | (v >> 24);
+        }
+    };
+
+    enum Op { GET, SET, MIXED };
+
+    const char * OP_NAMES[] = { "get", "set", "mixed" };
+
+    template <class Impl, bool Random>
+    struct Kernels
+    {
+        using Rec = typename Impl::Rec;
+
+        static std::size_t index(const uint32_t * order, std::size_t i)
+        {
+            return Random ? order[i] : i;
+        }
+
+        static void run(Op op, Rec * recs, const uint32_t * order, std::size_t begin, std::size_t end)
+        {
+            uint64_t sum = 0;
+            for (int r = 0; r < REPEATS; ++r) {
+                switch (op) {
+                  case GET:
+                    for (std::size_t i = begin; i < end; ++i) {
+                        sum += Impl::getB(recs[index(order, i)]);
+                    }
+                    break;
+                  case SET:
+                    for (std::size_t i = begin; i < end; ++i) {
+                        Impl::setB(recs[index(order, i)], (i + r) & Impl::MAX_B);
+                    }
+                    break;
+                  default:
+                    for (std::size_t i = begin; i < end; ++i) {
+                        Rec & rec = recs[index(order, i)];
+                        Impl::setB(rec, (Impl::getA(rec) + Impl::getB(rec)) & Impl::MAX_B);
+                    }
+                    break;
+                }
+            }
+            bench::doNotOptimize(sum);
+            bench::doNotOptimize(recs[begin]);
+        }
+    };
+
+    // Every thread owns one contiguous slice; random order stays within it.
+    std::vector<uint32_t> sliceOrder(std::size_t n, int threads)
+    {
+        std::vector<uint32_t> order(n);
+        uint64_t state = 12345;
+        for (int t = 0; t < threads; ++t) {
+            const std::size_t begin = n * t / threads;
+            const std::size_t end = n * (t + 1) / threads;
+            for (std::size_t i = begin; i < end; ++i) {
+                order[i] = static_cast<uint32_t>(i);
+            }
+            for (std::size_t i = end - 1; i > begin; --i) {
+                state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+                std::swap(order[i], order[begin + (state >> 33) % (i - begin + 1)]);
+            }
+        }
+        return order;
+    }
+
+    template <class Impl, bool Random>
+    double throughput(Op op, std::vector<typename Impl::Rec> & recs, const std::vector<uint32_t> & order, int threads)
+    {
+        std::vector<std::thread> pool;
+        bench::Timer timer;
+        for (int t = 0; t < threads; ++t) {
+            const std::size_t begin = recs.size() * t / threads;
+            const std::size_t end = recs.size() * (t + 1) / threads;
+            pool.push_back(std::thread(&Kernels<Impl, Random>::run, op, recs.data(), order.data(), begin, end));
+        }
+        for (std::size_t t = 0; t < pool.size(); ++t) {
+            pool[t].join();
+        }
+        return timer.elapsedSec() * 1e9 / (static_cast<double>(recs.size()) * REPEATS);
+    }
+
+    // Each index depends on the previous value read: exposes load-to-use
+    // latency instead of throughput.
+    template <class Impl>
+    double latency(const std::vector<typename Impl::Rec> & recs)
+    {
+        const std::size_t mask = recs.size() - 1;
+        std::size_t idx = 0;
+        bench::Timer timer;
+        for (std::size_t i = 0; i < recs.size() * REPEATS; ++i) {
+            idx = (idx * 0x9E3779B1u + Impl::getB(recs[idx]) + 1) & mask;
+        }
+        bench::doNotOptimize(idx);
+        return timer.elapsedSec() * 1e9 / (static_cast<double>(recs.size()) * REPEATS);
+    }
+
+    template <class Impl>
+    std::vector<typename Impl::Rec> makeRecords()
+    {
+        std::vector<typename Impl::Rec> recs(NUM_RECORDS);
+        for (std::size_t i = 0; i < recs.size(); ++i) {
+            Impl::setB(recs[i], (i * 2654435761u) & Impl::MAX_B);
+        }
+        return recs;
+    }
+
+    template <class L, class N, class M>
+    void runWidth(bench::Report & report, const char * width, int maxThreads)
+    {
+        std::vector<typename L::Rec> lib = makeRecords<L>();
+        std::vector<typename N::Rec> native = makeRecords<N>();
+        std::vector<typename M::Rec> mask = makeRecords<M>();
+
+        std::printf("\n%s: %u/%u/%u bytes per record (BitFields/native/mask)\n", width,
+                    static_cast<unsigned>(sizeof(typename L::Rec)), static_cast<unsigned>(sizeof(typename N::Rec)),
+                    static_cast<unsigned>(sizeof(typename M::Rec)));
+        std::printf("%-28s %10s %10s %10s   (ns/op)\n", "", "BitFields", "native", "mask");
+
+        const int threadCounts[] = { 1, maxThreads };
+        for (int tc = 0; tc < 2; ++tc) {
+            const int threads = threadCounts[tc];
+            const std::vector<uint32_t> order = sliceOrder(NUM_RECORDS, threads);
+            for (int rnd = 0; rnd < 2; ++rnd) {
+                for (int op = GET; op <= MIXED; ++op) {
+                    double ns[3];
+                    if (rnd == 0) {
+                        ns[0] = throughput<L, false>(static_cast<Op>(op), lib, order, threads);
+                        ns[1] = throughput<N, false>(static_cast<Op>(op), native, order, threads);
+                        ns[2] = throughput<M, false>(static_cast<Op>(op), mask, order, threads);
+                    }
+                    else {
+                        ns[0] = throughput<L, true>(static_cast<Op>(op), lib, order, threads);
+                        ns[1] = throughput<N, true>(static_cast<Op>(op), native, order, threads);
+                        ns[2] = throughput<M, true>(static_cast<Op>(op), mask, order, threads);
+                    }
+                    const std::string name = std::string(OP_NAMES[op]) + "/" + (rnd ? "random" : "sequential") + "/" +
+                                             std::to_string(threads) + "t";
+                    std::printf("%-28s %10.3f %10.3f %10.3f\n", name.c_str(), ns[0], ns[1], ns[2]);
+                    report.add(name + "/" + width + "/bitfields", ns[0]);
+                    report.add(name + "/" + width + "/native", ns[1]);
+                    report.add(name + "/" + width + "/mask", ns[2]);
+                }
+            }
+        }
+
+        const double ns[3] = { latency<L>(lib), latency<N>(native), latency<M>(mask) };
+        std::printf("%-28s %10.3f %10.3f %10.3f\n", "get/latency/1t", ns[0], ns[1], ns[2]);
+        report.add(std::string("get/latency/1t/") + width + "/bitfields", ns[0]);
+        report.add(std::string("get/latency/1t/") + width + "/native", ns[1]);
+        report.add(std::string("get/latency/1t/") + width + "/mask", ns[2]);
+    }
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    bench::Report report(argc, argv, "bBitfields");
+    const int maxThreads = std::max(2, static_cast<int>(std::thread::hardware_concurrency()));
+
+    runWidth<Lib8, Native8, Mask8>(report, "u8", maxThreads);
+    runWidth<Lib16, Native16, Mask16>(report, "u16", maxThreads);
+    runWidth<Lib32, Native32, Mask32>(report, "u32", maxThreads);
+    runWidth<Lib64, Native64, Mask64>(report, "u64", maxThreads);
+    runWidth<Lib128, Native128, Mask128>(report, "w128", maxThreads);
+    return 0;
+}
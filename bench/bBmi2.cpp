@@ -0,0 +1,133 @@
+/**
+ * \file bBmi2.cpp
+ * \date Oct 16, 2026
+ *
+ * Gather/scatter of field subsets through PEXT/PDEP versus the portable
+ * shift/mask path, per record and in bulk. Adjacent fields favour shifts
+ * (one shift and mask either way); many scattered fields favour PEXT/PDEP on
+ * CPUs that implement them in hardware.
+ */
+
+#include "bench.hpp"
+
+#include <cppbitfield/bitfield_bmi2.hpp>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+DEFINE_BITFIELD_ENUM(
+     FooEnum,
+           F0, F1, F2, F3, F4, F5, F6, F7,
+           F8, F9, F10, F11, F12, F13, F14, F15);
+
+DEFINE_BITFIELD_SIZES(
+    FooSizes,
+           3, 5, 2, 6, 4, 3, 5, 4,
+           3, 5, 2, 6, 4, 3, 5, 4);
+
+DEFINE_BITFIELDS(
+    Foo,
+    FooEnum,
+    FooSizes);
+
+namespace {
+
+    using Pack = cppbitfield::BitFieldPack<Foo>;
+
+    const std::size_t NUM_RECORDS = 1 << 16;
+    const int REPEATS = 200;
+
+    template <FooEnum... Xs>
+    struct Case
+    {
+        static double singleGather(const std::vector<Foo> & recs, bool usePext)
+        {
+            bench::Timer timer;
+            uint64_t acc = 0;
+            for (int r = 0; r < REPEATS; ++r) {
+                for (std::size_t i = 0; i < recs.size(); ++i) {
+                    acc += Pack::gather<Xs...>(recs[i], usePext);
+                }
+            }
+            bench::doNotOptimize(acc);
+            return timer.elapsedSec() * 1e9 / (static_cast<double>(recs.size()) * REPEATS);
+        }
+
+        static double bulkGather(const std::vector<Foo> & recs, std::vector<uint64_t> & out, bool usePext)
+        {
+            bench::Timer timer;
+            for (int r = 0; r < REPEATS; ++r) {
+                Pack::gather<Xs...>(recs.data(), recs.size(), out.data(), usePext);
+                bench::doNotOptimize(out[r]);
+            }
+            return timer.elapsedSec() * 1e9 / (static_cast<double>(recs.size()) * REPEATS);
+        }
+
+        static double bulkScatter(std::vector<Foo> & recs, const std::vector<uint64_t> & in, bool usePext)
+        {
+            bench::Timer timer;
+            for (int r = 0; r < REPEATS; ++r) {
+                Pack::scatter<Xs...>(recs.data(), recs.size(), in.data(), usePext);
+                bench::doNotOptimize(recs[r].bits());
+            }
+            return timer.elapsedSec() * 1e9 / (static_cast<double>(recs.size()) * REPEATS);
+        }
+
+        static void run(bench::Report & report, const char * name, std::vector<Foo> & recs)
+        {
+            const char * paths[] = { "shift", "pext" };
+            std::vector<uint64_t> vals(recs.size());
+            Pack::gather<Xs...>(recs.data(), recs.size(), vals.data(), false);
+            std::printf("%-22s", name);
+            for (int p = 0; p < 2; ++p) {
+                const double ns = singleGather(recs, p == 1);
+                std::printf(" %8.3f", ns);
+                report.add(std::string(name) + "/get/" + paths[p], ns);
+            }
+            for (int p = 0; p < 2; ++p) {
+                const double ns = bulkGather(recs, vals, p == 1);
+                std::printf(" %8.3f", ns);
+                report.add(std::string(name) + "/gather/" + paths[p], ns);
+            }
+            for (int p = 0; p < 2; ++p) {
+                const double ns = bulkScatter(recs, vals, p == 1);
+                std::printf(" %8.3f", ns);
+                report.add(std::string(name) + "/scatter/" + paths[p], ns);
+            }
+            std::printf("\n");
+        }
+    };
+
+    const char * levelName(cppbitfield::Bmi2Level level)
+    {
+        switch (level) {
+          case cppbitfield::Bmi2Level::Fast: return "fast";
+          case cppbitfield::Bmi2Level::Microcoded: return "microcoded";
+          default: return "none";
+        }
+    }
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    bench::Report report(argc, argv, "bBmi2");
+    std::vector<Foo> recs(NUM_RECORDS);
+    uint64_t state = 1;
+    for (std::size_t i = 0; i < recs.size(); ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        recs[i] = Foo::fromBits(state);
+    }
+
+    std::printf("BMI2: %s (default path: %s)\n", levelName(cppbitfield::bmi2Level()),
+                cppbitfield::preferPext() ? "pext" : "shift");
+    std::printf("%-22s %8s %8s %8s %8s %8s %8s   (ns/record)\n", "fields",
+                "get", "get/pext", "gather", "g/pext", "scatter", "s/pdep");
+    using E = FooEnum;
+    Case<E::F1, E::F2>::run(report, "2 adjacent", recs);
+    Case<E::F1, E::F6>::run(report, "2 apart", recs);
+    Case<E::F0, E::F5, E::F9, E::F14>::run(report, "4 scattered", recs);
+    Case<E::F0, E::F2, E::F4, E::F6, E::F8, E::F10, E::F12, E::F14>::run(report, "8 scattered", recs);
+    return 0;
+}
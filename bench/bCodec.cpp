@@ -0,0 +1,71 @@
+/**
+ * \file bCodec.cpp
+ * \date Oct 16, 2026
+ *
+ * Column compression: ratio against the field length and decode speed of
+ * each data shape at each SIMD level.
+ */
+
+#include "bench.hpp"
+
+#include <cppbitfield/bitfield_codec.hpp>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+    const std::size_t NUM_VALUES = 1 << 22;
+    const int REPEATS = 20;
+
+    struct Shape
+    {
+        const char * name;
+        int fieldLength;
+        std::vector<uint32_t> vals;
+    };
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    bench::Report report(argc, argv, "bCodec");
+
+    Shape shapes[] = { { "state", 3, std::vector<uint32_t>(NUM_VALUES) },
+                       { "sequence", 32, std::vector<uint32_t>(NUM_VALUES) },
+                       { "clustered", 20, std::vector<uint32_t>(NUM_VALUES) },
+                       { "random", 12, std::vector<uint32_t>(NUM_VALUES) } };
+    uint64_t state = 1;
+    uint32_t s = 0;
+    for (std::size_t i = 0; i < NUM_VALUES; ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        const uint32_t r = static_cast<uint32_t>(state >> 32);
+        if (r % 500 == 0) {
+            s = (r >> 12) % 8;
+        }
+        shapes[0].vals[i] = s;
+        shapes[1].vals[i] = static_cast<uint32_t>(i * 2 + (r & 1));
+        shapes[2].vals[i] = 500000 + (r & 0xFF);
+        shapes[3].vals[i] = r & 0xFFF;
+    }
+
+    const char * names[] = { "scalar", "sse2", "avx2", "avx512" };
+    std::vector<uint32_t> out(NUM_VALUES);
+    for (const Shape & sh : shapes) {
+        const cppbitfield::CompressedColumn col = cppbitfield::CompressedColumn::encode(sh.vals.data(), NUM_VALUES);
+        const double ratio = double(NUM_VALUES) * sh.fieldLength / 8 / double(col.sizeInBytes());
+        std::printf("%-10s %6.2fx vs %d-bit field\n", sh.name, ratio, sh.fieldLength);
+        for (int l = 0; l <= static_cast<int>(cppbitfield::simdLevel()); ++l) {
+            bench::Timer t;
+            for (int r = 0; r < REPEATS; ++r) {
+                col.decode(out.data(), static_cast<cppbitfield::SimdLevel>(l));
+                bench::doNotOptimize(out[r]);
+            }
+            const double ns = t.elapsedSec() * 1e9 / (double(NUM_VALUES) * REPEATS);
+            std::printf("  %-8s %8.3f ns/value %6.2f GB/s decoded\n", names[l], ns, 4 / ns);
+            report.add(std::string("decode/") + sh.name + "/" + names[l], ns);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,118 @@
+/**
+ * \file bCompile.cpp
+ * \date Oct 16, 2026
+ *
+ * Cost of compiling the library for wide layouts: generates translation
+ * units declaring records of 8, 32 and 64 fields that read and write
+ * every field, compiles each with the compiler of this build and records
+ * the wall time and the compiler's peak resident memory. A unit that only
+ * includes bitfield.hpp is the baseline.
+ */
+
+#include "bench.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+    // distinct records per unit, so every layout is instantiated anew
+    const int RECORDS_PER_UNIT = 8;
+    const int REPEATS = 3;
+
+    std::string generate(int numFields)
+    {
+        std::string src = "#include <cppbitfield/bitfield.hpp>\n\n";
+        for (int r = 0; r < RECORDS_PER_UNIT && numFields > 0; ++r) {
+            const std::string rec = "R" + std::to_string(r);
+            std::string fields;
+            std::string sizes;
+            for (int i = 0; i < numFields; ++i) {
+                fields += ", F" + std::to_string(i);
+                sizes += ", " + std::to_string(1 + (i * 7 + r) % 8);
+            }
+            src += "DEFINE_BITFIELD_ENUM(" + rec + "Enum" + fields + ");\n";
+            src += "DEFINE_BITFIELD_SIZES(" + rec + "Sizes" + sizes + ");\n";
+            src += "DEFINE_BITFIELDS(" + rec + ", " + rec + "Enum, " + rec + "Sizes);\n\n";
+            src += "void touch" + rec + "(" + rec + " & rec)\n{\n";
+            for (int i = 1; i < numFields; ++i) {
+                src += "    rec.set<" + rec + "Enum::F" + std::to_string(i) + ">(rec.get<" + rec + "Enum::F" +
+                       std::to_string(i - 1) + ">() & 1);\n";
+            }
+            src += "}\n\n";
+        }
+        return src;
+    }
+
+    struct Cost
+    {
+        double sec;
+        long peakKib;
+    };
+
+    // Runs the compiler on `path`; the rusage of the driver includes the
+    // compiler proper it waited for.
+    bool compile(const std::string & path, Cost & cost)
+    {
+        const std::string inc = std::string("-I") + CPPBITFIELD_BENCH_INCLUDE;
+        const char * argv[] = { CPPBITFIELD_BENCH_CXX, "-std=c++11", "-O1", inc.c_str(), "-c", path.c_str(),
+                                "-o", "/dev/null", nullptr };
+        bench::Timer t;
+        const pid_t pid = fork();
+        if (pid == 0) {
+            execvp(argv[0], const_cast<char * const *>(argv));
+            _exit(127);
+        }
+        int status = 0;
+        struct rusage usage;
+        if (pid < 0 || wait4(pid, &status, 0, &usage) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            return false;
+        }
+        cost.sec = t.elapsedSec();
+        cost.peakKib = usage.ru_maxrss;
+        return true;
+    }
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    bench::Report report(argc, argv, "bCompile");
+
+    const int widths[] = { 0, 8, 32, 64 };
+    for (int w = 0; w < 4; ++w) {
+        const std::string path = std::string(CPPBITFIELD_BENCH_WORK_DIR) + "/bCompile_" + std::to_string(widths[w]) + ".cpp";
+        std::FILE * f = std::fopen(path.c_str(), "w");
+        if (f == nullptr) {
+            std::fprintf(stderr, "cannot write %s\n", path.c_str());
+            return 1;
+        }
+        const std::string src = generate(widths[w]);
+        std::fwrite(src.data(), 1, src.size(), f);
+        std::fclose(f);
+
+        Cost best = { 0, 0 };
+        for (int r = 0; r < REPEATS; ++r) {
+            Cost c;
+            if (!compile(path, c)) {
+                std::fprintf(stderr, "compiling %s failed\n", path.c_str());
+                return 1;
+            }
+            if (r == 0 || c.sec < best.sec) {
+                best.sec = c.sec;
+            }
+            best.peakKib = c.peakKib > best.peakKib ? c.peakKib : best.peakKib;
+        }
+
+        const std::string name = widths[w] == 0 ? std::string("baseline") : std::to_string(widths[w]) + " fields";
+        std::printf("%-10s x%d  %8.3f s  %8ld KiB peak\n", name.c_str(), widths[w] == 0 ? 1 : RECORDS_PER_UNIT,
+                    best.sec, best.peakKib);
+        report.add("compile/" + name, best.sec * 1e9, static_cast<double>(best.peakKib));
+    }
+    return 0;
+}
@@ -0,0 +1,174 @@
+/**
+ * \file bDelta.cpp
+ * \date Oct 16, 2026
+ *
+ * Delta replication of a table of 40-bit records: encode and apply
+ * throughput and stream size at change rates of 0.1%, 1% and 5%, from
+ * plain record arrays and from packed BitFieldArrays, against copying the
+ * whole table. The table has 100M records unless `--records <n>` says
+ * otherwise; both versions of it plus a replica stay in memory.
+ */
+
+#include "bench.hpp"
+
+#include <cppbitfield/bitfield_delta.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+DEFINE_BITFIELD_ENUM(
+  AccountEnum,
+        Status,
+        Tier,
+        Region,
+        Balance,
+        Visits,
+        Flagged);
+
+DEFINE_BITFIELD_SIZES(
+ AccountSizes,
+            2,
+            3,
+            6,
+           20,
+            8,
+            1);
+
+DEFINE_BITFIELDS(
+    Account,
+    AccountEnum,
+    AccountSizes);
+
+DEFINE_BITFIELD_ARRAY(
+    AccountArray,
+    AccountEnum,
+    AccountSizes);
+
+namespace {
+
+    using Delta = cppbitfield::DeltaStream<AccountEnum, AccountSizes>;
+
+    const std::size_t DEFAULT_RECORDS = 100000000;
+
+    uint64_t nextRand(uint64_t & s)
+    {
+        s = s * 6364136223846793005ULL + 1442695040888963407ULL;
+        return s >> 16;
+    }
+
+    // Typical update: the balance and visit count of an account, now and
+    // then its status or tier too.
+    Account update(uint64_t & seed, Account a)
+    {
+        a.set<AccountEnum::Balance>(nextRand(seed) & 0xFFFFF);
+        a.set<AccountEnum::Visits>((a.get<AccountEnum::Visits>() + 1) & 0xFF);
+        if (nextRand(seed) % 8 == 0) {
+            a.set<AccountEnum::Status>(nextRand(seed) & 3);
+        }
+        if (nextRand(seed) % 32 == 0) {
+            a.set<AccountEnum::Tier>(nextRand(seed) & 7);
+        }
+        return a;
+    }
+
+    std::size_t parseRecords(int argc, char ** argv)
+    {
+        for (int i = 1; i + 1 < argc; ++i) {
+            if (std::strcmp(argv[i], "--records") == 0) {
+                return static_cast<std::size_t>(std::strtoull(argv[i + 1], nullptr, 10));
+            }
+        }
+        return DEFAULT_RECORDS;
+    }
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    bench::Report report(argc, argv, "bDelta");
+    const std::size_t n = parseRecords(argc, argv);
+    const double rates[] = { 0.001, 0.01, 0.05 };
+    const char * names[] = { "0.1%", "1%", "5%" };
+
+    std::vector<Account> prev(n);
+    uint64_t seed = 7;
+    for (std::size_t i = 0; i < n; ++i) {
+        const uint64_t r = nextRand(seed);
+        prev[i] = Account::make(AccountEnum::Status, r & 3, AccountEnum::Tier, (r >> 2) & 7,
+                                AccountEnum::Region, (r >> 5) & 63, AccountEnum::Balance, (r >> 11) & 0xFFFFF,
+                                AccountEnum::Visits, (r >> 31) & 0xFF);
+    }
+    std::vector<Account> next(n);
+    std::vector<Account> replica(n);
+
+    bench::Timer copy;
+    replica = prev;
+    bench::doNotOptimize(replica.data());
+    const double copyNs = copy.elapsedSec() * 1e9 / double(n);
+    std::printf("%-22s %8.3f ns/record %10.1f MiB\n", "full copy", copyNs, double(n * sizeof(Account)) / (1 << 20));
+    report.add("snapshot/copy", copyNs);
+
+    for (int r = 0; r < 3; ++r) {
+        next = prev;
+        const std::size_t changes = static_cast<std::size_t>(double(n) * rates[r]);
+        for (std::size_t k = 0; k < changes; ++k) {
+            const std::size_t i = static_cast<std::size_t>(nextRand(seed) % n);
+            next[i] = update(seed, next[i]);
+        }
+
+        bench::Timer enc;
+        const Delta delta = Delta::encode(prev.data(), next.data(), n);
+        const double encNs = enc.elapsedSec() * 1e9 / double(n);
+
+        replica = prev;
+        bench::Timer app;
+        const bool ok = delta.apply(replica.data(), n) == cppbitfield::DeltaStatus::Ok;
+        const double appNs = app.elapsedSec() * 1e9 / double(delta.numChanges() ? delta.numChanges() : 1);
+        const bool same = ok && std::memcmp(replica.data(), next.data(), n * sizeof(Account)) == 0;
+
+        std::printf("records %-5s encode %8.3f ns/record  apply %8.3f ns/change  %8.2f bytes/change  %6.3f%% of table%s\n",
+                    names[r], encNs, appNs, double(delta.sizeInBytes()) / double(delta.numChanges() ? delta.numChanges() : 1),
+                    100.0 * double(delta.sizeInBytes()) / double(n * sizeof(Account)), same ? "" : " (MISMATCH)");
+        report.add(std::string("records/encode/") + names[r], encNs);
+        report.add(std::string("records/apply/") + names[r], appNs);
+    }
+
+    // packed storage: 40 bits per record instead of 64
+    replica = std::vector<Account>();
+    AccountArray a(n);
+    AccountArray b(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        a.set(i, prev[i]);
+    }
+    prev = std::vector<Account>();
+    next = std::vector<Account>();
+
+    for (int r = 0; r < 3; ++r) {
+        b = a;
+        const std::size_t changes = static_cast<std::size_t>(double(n) * rates[r]);
+        for (std::size_t k = 0; k < changes; ++k) {
+            const std::size_t i = static_cast<std::size_t>(nextRand(seed) % n);
+            b.set(i, update(seed, b.get(i)));
+        }
+
+        bench::Timer enc;
+        const Delta delta = Delta::encode(a, b);
+        const double encNs = enc.elapsedSec() * 1e9 / double(n);
+
+        AccountArray copyOfA = a;
+        bench::Timer app;
+        const bool ok = delta.apply(copyOfA) == cppbitfield::DeltaStatus::Ok;
+        const double appNs = app.elapsedSec() * 1e9 / double(delta.numChanges() ? delta.numChanges() : 1);
+        const bool same = ok && std::memcmp(copyOfA.words(), b.words(), b.sizeInBytes()) == 0;
+
+        std::printf("array   %-5s encode %8.3f ns/record  apply %8.3f ns/change  %8.2f bytes/change  %6.3f%% of table%s\n",
+                    names[r], encNs, appNs, double(delta.sizeInBytes()) / double(delta.numChanges() ? delta.numChanges() : 1),
+                    100.0 * double(delta.sizeInBytes()) / double(b.sizeInBytes()), same ? "" : " (MISMATCH)");
+        report.add(std::string("array/encode/") + names[r], encNs);
+        report.add(std::string("array/apply/") + names[r], appNs);
+    }
+    return 0;
+}
@@ -0,0 +1,134 @@
+/**
+ * \file bDiff.cpp
+ * \date Oct 16, 2026
+ *
+ * Change masks between two versions of a run of records: a get<X>()
+ * comparison per field versus diff(), and the bulk diff at each SIMD level
+ * with one record in a hundred changed.
+ */
+
+#include "bench.hpp"
+
+#include <cppbitfield/bitfield_diff.hpp>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+DEFINE_BITFIELD_ENUM(
+  SessionEnum,
+        State,
+        Flags,
+        Prio,
+        Retries,
+        Window,
+        Owner,
+        Epoch,
+        Dirty);
+
+DEFINE_BITFIELD_SIZES(
+ SessionSizes,
+           3,
+           4,
+           2,
+           5,
+          12,
+          20,
+          17,
+           1);
+
+DEFINE_BITFIELDS(
+    Session,
+    SessionEnum,
+    SessionSizes);
+
+namespace {
+
+    const std::size_t NUM_RECORDS = 1 << 20;
+    const int REPEATS = 20;
+
+    template <SessionEnum X>
+    uint64_t changedBit(const Session & a, const Session & b)
+    {
+        return static_cast<uint64_t>(a.get<X>() != b.get<X>()) << static_cast<int>(X);
+    }
+
+#if defined(__GNUC__)
+    __attribute__((noinline))
+#endif
+    uint64_t diffByHand(const std::vector<Session> & a, const std::vector<Session> & b)
+    {
+        uint64_t all = 0;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            all += changedBit<SessionEnum::State>(a[i], b[i]) | changedBit<SessionEnum::Flags>(a[i], b[i]) |
+                   changedBit<SessionEnum::Prio>(a[i], b[i]) | changedBit<SessionEnum::Retries>(a[i], b[i]) |
+                   changedBit<SessionEnum::Window>(a[i], b[i]) | changedBit<SessionEnum::Owner>(a[i], b[i]) |
+                   changedBit<SessionEnum::Epoch>(a[i], b[i]) | changedBit<SessionEnum::Dirty>(a[i], b[i]);
+        }
+        return all;
+    }
+
+#if defined(__GNUC__)
+    __attribute__((noinline))
+#endif
+    uint64_t diffEach(const std::vector<Session> & a, const std::vector<Session> & b)
+    {
+        uint64_t all = 0;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            all += cppbitfield::diff(a[i], b[i]);
+        }
+        return all;
+    }
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    bench::Report report(argc, argv, "bDiff");
+    std::vector<Session> a(NUM_RECORDS);
+    std::vector<Session> b(NUM_RECORDS);
+    uint64_t state = 1;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        a[i] = Session::fromBits(state);
+        b[i] = a[i];
+        if ((state >> 20) % 100 == 0) {
+            b[i] = Session::fromBits(state ^ (1ULL << ((state >> 40) % 64)));
+        }
+    }
+
+    bench::Timer timer;
+    uint64_t sum = 0;
+    for (int r = 0; r < REPEATS; ++r) {
+        // the loops only read the records: keep them from being hoisted
+        bench::doNotOptimize(a.data());
+        sum += diffByHand(a, b);
+    }
+    const double byHand = timer.elapsedSec() * 1e9 / (double(NUM_RECORDS) * REPEATS);
+    std::printf("%-12s %8.3f ns/record\n", "get<X>()", byHand);
+    report.add("mask/get", byHand);
+
+    bench::Timer each;
+    uint64_t check = 0;
+    for (int r = 0; r < REPEATS; ++r) {
+        bench::doNotOptimize(a.data());
+        check += diffEach(a, b);
+    }
+    const double perRecord = each.elapsedSec() * 1e9 / (double(NUM_RECORDS) * REPEATS);
+    std::printf("%-12s %8.3f ns/record%s\n", "diff()", perRecord, check == sum ? "" : " (MISMATCH)");
+    report.add("mask/diff", perRecord);
+
+    std::vector<cppbitfield::FieldChange> out(NUM_RECORDS);
+    const char * names[] = { "scalar", "sse2", "avx2", "avx512" };
+    for (int l = 0; l <= static_cast<int>(cppbitfield::simdLevel()); ++l) {
+        bench::Timer t;
+        std::size_t changes = 0;
+        for (int r = 0; r < REPEATS; ++r) {
+            changes = cppbitfield::diff(a.data(), b.data(), a.size(), out.data(), static_cast<cppbitfield::SimdLevel>(l));
+        }
+        const double ns = t.elapsedSec() * 1e9 / (double(NUM_RECORDS) * REPEATS);
+        std::printf("%-12s %8.3f ns/record (%zu changed)\n", names[l], ns, changes);
+        report.add(std::string("bulk/") + names[l], ns);
+    }
+    return 0;
+}
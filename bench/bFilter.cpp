@@ -0,0 +1,93 @@
+/**
+ * \file bFilter.cpp
+ * \date Oct 16, 2026
+ *
+ * Selection over a run of records: a hand-written loop of get<X>() calls
+ * versus the folded predicate at each SIMD level.
+ */
+
+#include "bench.hpp"
+
+#include <cppbitfield/bitfield_predicate.hpp>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+DEFINE_BITFIELD_ENUM(
+     TaskEnum,
+           State,
+           Flags,
+           Prio,
+           Owner);
+
+DEFINE_BITFIELD_SIZES(
+    TaskSizes,
+           3,
+           4,
+           2,
+          23);
+
+DEFINE_BITFIELDS(
+    Task,
+    TaskEnum,
+    TaskSizes);
+
+namespace {
+
+    const std::size_t NUM_RECORDS = 1 << 20;
+    const int REPEATS = 20;
+
+#if defined(__GNUC__)
+    __attribute__((noinline))
+#endif
+    std::size_t selectByHand(const std::vector<Task> & recs, uint32_t * out)
+    {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < recs.size(); ++i) {
+            const Task & r = recs[i];
+            if (r.get<TaskEnum::State>() == 3 && (r.get<TaskEnum::Flags>() & 0x4) && r.get<TaskEnum::Prio>() < 2) {
+                out[count++] = static_cast<uint32_t>(i);
+            }
+        }
+        return count;
+    }
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    bench::Report report(argc, argv, "bFilter");
+    std::vector<Task> recs(NUM_RECORDS);
+    uint64_t state = 1;
+    for (std::size_t i = 0; i < recs.size(); ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        recs[i] = Task::fromBits(static_cast<uint32_t>(state >> 32));
+    }
+    std::vector<uint32_t> out(NUM_RECORDS);
+
+    using cppbitfield::field;
+    const auto pred = field<Task, TaskEnum::State>() == 3 && (field<Task, TaskEnum::Flags>() & 0x4) &&
+                      field<Task, TaskEnum::Prio>() < 2;
+
+    bench::Timer timer;
+    std::size_t hits = 0;
+    for (int r = 0; r < REPEATS; ++r) {
+        hits = selectByHand(recs, out.data());
+    }
+    const double byHand = timer.elapsedSec() * 1e9 / (double(NUM_RECORDS) * REPEATS);
+    std::printf("%-12s %8.3f ns/record (%zu hits)\n", "get<X>()", byHand, hits);
+    report.add("select/get", byHand);
+
+    const char * names[] = { "scalar", "sse2", "avx2", "avx512" };
+    for (int l = 0; l <= static_cast<int>(cppbitfield::simdLevel()); ++l) {
+        bench::Timer t;
+        for (int r = 0; r < REPEATS; ++r) {
+            hits = cppbitfield::select(recs.data(), recs.size(), pred, out.data(), static_cast<cppbitfield::SimdLevel>(l));
+        }
+        const double ns = t.elapsedSec() * 1e9 / (double(NUM_RECORDS) * REPEATS);
+        std::printf("%-12s %8.3f ns/record (%zu hits)\n", names[l], ns, hits);
+        report.add(std::string("select/") + names[l], ns);
+    }
+    return 0;
+}
@@ -0,0 +1,90 @@
+/**
+ * \file bMultiField.cpp
+ * \date Oct 16, 2026
+ *
+ * Full record writes through chained single-field set<X>() calls versus one
+ * variadic set<A, B, C, D>() call, on records that live in memory.
+ */
+
+#include "bench.hpp"
+
+#include <cppbitfield/bitfield.hpp>
+
+#include <cstdio>
+#include <vector>
+
+DEFINE_BITFIELD_ENUM(
+     FooEnum,
+           State,
+           Prio,
+           Flags,
+           Id);
+
+DEFINE_BITFIELD_SIZES(
+    FooSizes,
+           3,
+           2,
+           8,
+          19);
+
+DEFINE_BITFIELDS(
+    Foo,
+    FooEnum,
+    FooSizes);
+
+namespace {
+
+    const size_t NUM_RECORDS = 1 << 20;
+    const int REPEATS = 50;
+
+#if defined(__GNUC__)
+    __attribute__((noinline))
+#endif
+    void writeChained(std::vector<Foo> & recs, uint32_t seed)
+    {
+        for (size_t i = 0; i < recs.size(); ++i) {
+            const uint32_t v = static_cast<uint32_t>(i) ^ seed;
+            recs[i].set<FooEnum::State>(v & 0x7);
+            recs[i].set<FooEnum::Prio>((v >> 3) & 0x3);
+            recs[i].set<FooEnum::Flags>((v >> 5) & 0xFF);
+            recs[i].set<FooEnum::Id>((v >> 13) & 0x7FFFF);
+        }
+    }
+
+#if defined(__GNUC__)
+    __attribute__((noinline))
+#endif
+    void writeMulti(std::vector<Foo> & recs, uint32_t seed)
+    {
+        for (size_t i = 0; i < recs.size(); ++i) {
+            const uint32_t v = static_cast<uint32_t>(i) ^ seed;
+            recs[i].set<FooEnum::State, FooEnum::Prio, FooEnum::Flags, FooEnum::Id>(
+                v & 0x7, (v >> 3) & 0x3, (v >> 5) & 0xFF, (v >> 13) & 0x7FFFF);
+        }
+    }
+
+    template <class Fn>
+    double timeIt(std::vector<Foo> & recs, Fn fn)
+    {
+        bench::Timer timer;
+        for (int r = 0; r < REPEATS; ++r) {
+            fn(recs, static_cast<uint32_t>(r));
+            bench::doNotOptimize(recs[r].bits());
+        }
+        return timer.elapsedSec() * 1e9 / (static_cast<double>(NUM_RECORDS) * REPEATS);
+    }
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    bench::Report report(argc, argv, "bMultiField");
+    std::vector<Foo> recs(NUM_RECORDS);
+    const double chained = timeIt(recs, writeChained);
+    const double multi = timeIt(recs, writeMulti);
+    std::printf("%-24s %10.3f ns/record\n", "chained set<X>()", chained);
+    std::printf("%-24s %10.3f ns/record\n", "set<A, B, C, D>()", multi);
+    report.add("set/chained", chained);
+    report.add("set/multi", multi);
+    return 0;
+}
@@ -0,0 +1,117 @@
+/**
+ * \file bNarrow.cpp
+ * \date Oct 16, 2026
+ *
+ * Byte-aligned fields of a BitFieldArray: the narrow loads and stores
+ * BitFieldArray uses for them against the general funnel read-modify-write
+ * on the same words. Consecutive read-modify-writes of records sharing a
+ * word wait on each other's stores; narrow stores never load.
+ */
+
+#include "bench.hpp"
+
+#include <cppbitfield/bitfield_array.hpp>
+
+#include <cstdio>
+
+DEFINE_BITFIELD_ENUM(
+     PktEnum,
+        Kind,
+        Port,
+       Flags,
+         Len);
+
+// 56 bit records: Kind and Port are whole bytes of every record
+DEFINE_BITFIELD_SIZES(
+    PktSizes,
+           8,
+          16,
+           8,
+          24);
+
+DEFINE_BITFIELD_ARRAY(
+    PktArray,
+    PktEnum,
+    PktSizes);
+
+namespace {
+
+    const std::size_t NUM_RECORDS = 1 << 20;
+    const int REPEATS = 20;
+
+    const int PORT_OFFSET = PktArray::Field<PktEnum::Port>::offset;
+
+    template <class Fn>
+    double nsPerRecord(Fn fn)
+    {
+        bench::Timer t;
+        for (int r = 0; r < REPEATS; ++r) {
+            fn(r);
+        }
+        return t.elapsedSec() * 1e9 / (double(NUM_RECORDS) * REPEATS);
+    }
+
+    void report(bench::Report & rep, const char * name, double ns)
+    {
+        std::printf("%-22s %8.3f ns/record\n", name, ns);
+        rep.add(name, ns);
+    }
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    bench::Report rep(argc, argv, "bNarrow");
+    PktArray arr(NUM_RECORDS);
+    uint64_t * words = arr.words();
+
+    report(rep, "set/narrow", nsPerRecord([&](int r) {
+        for (std::size_t i = 0; i < NUM_RECORDS; ++i) {
+            arr.set<PktEnum::Port>(i, static_cast<uint16_t>(i + r));
+        }
+        bench::doNotOptimize(words[r]);
+    }));
+
+    report(rep, "set/read_modify_write", nsPerRecord([&](int r) {
+        for (std::size_t i = 0; i < NUM_RECORDS; ++i) {
+            cppbitfield::detail::storeBits<16>(words, i * PktArray::NumBits + PORT_OFFSET, static_cast<uint16_t>(i + r));
+        }
+        bench::doNotOptimize(words[r]);
+    }));
+
+    report(rep, "get/narrow", nsPerRecord([&](int) {
+        uint64_t sum = 0;
+        for (std::size_t i = 0; i < NUM_RECORDS; ++i) {
+            sum += arr.get<PktEnum::Port>(i);
+        }
+        bench::doNotOptimize(sum);
+    }));
+
+    report(rep, "get/funnel", nsPerRecord([&](int) {
+        uint64_t sum = 0;
+        for (std::size_t i = 0; i < NUM_RECORDS; ++i) {
+            sum += cppbitfield::detail::loadBits<16>(words, i * PktArray::NumBits + PORT_OFFSET);
+        }
+        bench::doNotOptimize(sum);
+    }));
+
+    // set one field, read its neighbour in the same record
+    report(rep, "set_get/narrow", nsPerRecord([&](int r) {
+        uint64_t sum = 0;
+        for (std::size_t i = 0; i < NUM_RECORDS; ++i) {
+            arr.set<PktEnum::Port>(i, static_cast<uint16_t>(i + r));
+            sum += arr.get<PktEnum::Kind>(i);
+        }
+        bench::doNotOptimize(sum);
+    }));
+
+    report(rep, "set_get/funnel", nsPerRecord([&](int r) {
+        uint64_t sum = 0;
+        for (std::size_t i = 0; i < NUM_RECORDS; ++i) {
+            cppbitfield::detail::storeBits<16>(words, i * PktArray::NumBits + PORT_OFFSET, static_cast<uint16_t>(i + r));
+            sum += cppbitfield::detail::loadBits<8>(words, i * PktArray::NumBits);
+        }
+        bench::doNotOptimize(sum);
+    }));
+    return 0;
+}
@@ -0,0 +1,124 @@
+/**
+ * \file bParallel.cpp
+ * \date Oct 16, 2026
+ *
+ * Scaling of parallelForEach and parallelTransform over a packed
+ * BitFieldArray from one thread to every hardware thread: clear a flag on
+ * every record in a given state, and project records onto a narrower type.
+ */
+
+#include "bench.hpp"
+
+#include <cppbitfield/bitfield_parallel.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+DEFINE_BITFIELD_ENUM(
+     JobEnum,
+          Id,
+       State,
+        Flag,
+       Owner);
+
+// 39 bit records: no two consecutive records start in the same bit of a word
+DEFINE_BITFIELD_SIZES(
+    JobSizes,
+          24,
+           3,
+           1,
+          11);
+
+DEFINE_BITFIELD_ARRAY(
+    JobArray,
+    JobEnum,
+    JobSizes);
+
+DEFINE_BITFIELD_ENUM(
+     OwnerEnum,
+         Owner,
+          Flag);
+
+DEFINE_BITFIELD_SIZES(
+    OwnerSizes,
+            11,
+             1);
+
+DEFINE_BITFIELD_ARRAY(
+    OwnerArray,
+    OwnerEnum,
+    OwnerSizes);
+
+namespace {
+
+    const std::size_t NUM_RECORDS = 1 << 24;
+    const int REPEATS = 4;
+
+    using Job = JobArray::value_type;
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    bench::Report report(argc, argv, "bParallel");
+    JobArray jobs(NUM_RECORDS);
+    uint64_t state = 1;
+    for (std::size_t i = 0; i < NUM_RECORDS; ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        jobs[i] = Job::make(JobEnum::Id, i & 0xFFFFFF, JobEnum::State, (state >> 40) & 7,
+                            JobEnum::Flag, 1, JobEnum::Owner, (state >> 50) & 0x7FF);
+    }
+
+    // the same update as a plain loop: the cost every thread count is measured against
+    bench::Timer s;
+    for (int r = 0; r < REPEATS; ++r) {
+        const unsigned target = static_cast<unsigned>(r % 8);
+        for (std::size_t i = 0; i < NUM_RECORDS; ++i) {
+            Job job = jobs[i];
+            if (job.get<JobEnum::State>() == target) {
+                job.set<JobEnum::Flag>(0);
+                jobs[i] = job;
+            }
+        }
+    }
+    const double serial = s.elapsedSec() * 1e9 / (double(NUM_RECORDS) * REPEATS);
+    std::printf("    serial  for_each %7.3f ns/record\n", serial);
+    report.add("for_each/serial", serial);
+
+    const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1; ; threads = std::min(hw, threads * 2)) {
+        cppbitfield::ThreadPool pool(threads);
+
+        bench::Timer t;
+        for (int r = 0; r < REPEATS; ++r) {
+            const unsigned target = static_cast<unsigned>(r % 8);
+            cppbitfield::parallelForEach(jobs, [target](Job & job) {
+                if (job.get<JobEnum::State>() == target) {
+                    job.set<JobEnum::Flag>(0);
+                }
+            }, pool);
+        }
+        const double forEach = t.elapsedSec() * 1e9 / (double(NUM_RECORDS) * REPEATS);
+
+        OwnerArray owners;
+        bench::Timer u;
+        for (int r = 0; r < REPEATS; ++r) {
+            cppbitfield::parallelTransform(jobs, owners, [](const Job & job) {
+                return OwnerArray::value_type::make(OwnerEnum::Owner, job.get<JobEnum::Owner>(),
+                                                    OwnerEnum::Flag, job.get<JobEnum::Flag>());
+            }, pool);
+        }
+        const double transform = u.elapsedSec() * 1e9 / (double(NUM_RECORDS) * REPEATS);
+        bench::doNotOptimize(owners.words()[0]);
+
+        std::printf("%2u threads  for_each %7.3f ns/record  transform %7.3f ns/record\n", threads, forEach, transform);
+        report.add("for_each/" + std::to_string(threads), forEach);
+        report.add("transform/" + std::to_string(threads), transform);
+        if (threads == hw) {
+            break;
+        }
+    }
+    return 0;
+}
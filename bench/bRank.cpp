@@ -0,0 +1,99 @@
+/**
+ * \file bRank.cpp
+ * \date Oct 16, 2026
+ *
+ * Rank and select at random positions over a large flag column, against
+ * counting with a scan of get<X>(), and equality rank over a 3-bit field.
+ */
+
+#include "bench.hpp"
+
+#include <cppbitfield/bitfield_rank.hpp>
+
+#include <cstdio>
+#include <vector>
+
+DEFINE_BITFIELD_ENUM(
+     EventEnum,
+           Flag,
+           State);
+
+DEFINE_BITFIELD_SIZES(
+    EventSizes,
+           1,
+           3);
+
+DEFINE_BITFIELD_COLUMNS(
+    Events,
+    EventEnum,
+    EventSizes);
+
+namespace {
+
+    const std::size_t NUM_RECORDS = 1 << 27;
+    const std::size_t NUM_QUERIES = 1 << 22;
+    const std::size_t SCAN_QUERIES = 16;
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    bench::Report report(argc, argv, "bRank");
+    Events events(NUM_RECORDS);
+    uint64_t state = 1;
+    for (std::size_t i = 0; i < NUM_RECORDS; ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        events.set<EventEnum::Flag>(i, (state >> 60) < 4);
+        events.set<EventEnum::State>(i, (state >> 40) % 6);
+    }
+    std::vector<std::size_t> pos(NUM_QUERIES);
+    for (std::size_t q = 0; q < NUM_QUERIES; ++q) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        pos[q] = static_cast<std::size_t>(state >> 33) % NUM_RECORDS;
+    }
+
+    std::size_t sum = 0;
+    bench::Timer scan;
+    for (std::size_t q = 0; q < SCAN_QUERIES; ++q) {
+        for (std::size_t i = 0; i < pos[q]; ++i) {
+            sum += events.get<EventEnum::Flag, std::size_t>(i);
+        }
+    }
+    bench::doNotOptimize(sum);
+    const double nsScan = scan.elapsedSec() * 1e9 / SCAN_QUERIES;
+    std::printf("%-16s %12.1f ns/query\n", "scan get<X>()", nsScan);
+    report.add("rank/scan", nsScan);
+
+    const cppbitfield::RankSelect flags(events.column<EventEnum::Flag>());
+    std::printf("%-16s %12.2f %% of the column\n", "index overhead",
+                100.0 * double(flags.indexSizeInBytes()) / double(NUM_RECORDS / 8));
+
+    bench::Timer rank;
+    for (std::size_t q = 0; q < NUM_QUERIES; ++q) {
+        sum += flags.rank1(pos[q]);
+    }
+    bench::doNotOptimize(sum);
+    const double nsRank = rank.elapsedSec() * 1e9 / NUM_QUERIES;
+    std::printf("%-16s %12.1f ns/query\n", "rank1", nsRank);
+    report.add("rank/rank1", nsRank);
+
+    bench::Timer select;
+    for (std::size_t q = 0; q < NUM_QUERIES; ++q) {
+        sum += flags.select1(pos[q] % flags.count());
+    }
+    bench::doNotOptimize(sum);
+    const double nsSelect = select.elapsedSec() * 1e9 / NUM_QUERIES;
+    std::printf("%-16s %12.1f ns/query\n", "select1", nsSelect);
+    report.add("rank/select1", nsSelect);
+
+    const cppbitfield::ValueRank<3> states(events.column<EventEnum::State>());
+    bench::Timer value;
+    for (std::size_t q = 0; q < NUM_QUERIES; ++q) {
+        sum += states.rank(static_cast<uint32_t>(q % 6), pos[q]);
+    }
+    bench::doNotOptimize(sum);
+    const double nsValue = value.elapsedSec() * 1e9 / NUM_QUERIES;
+    std::printf("%-16s %12.1f ns/query\n", "value rank", nsValue);
+    report.add("rank/value", nsValue);
+    return 0;
+}
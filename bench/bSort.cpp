@@ -0,0 +1,98 @@
+/**
+ * \file bSort.cpp
+ * \date Oct 16, 2026
+ *
+ * Sorting records by (Prio, State, Id): std::sort comparing get<X>() tuples
+ * versus radixSort, serial and threaded.
+ */
+
+#include "bench.hpp"
+
+#include <cppbitfield/bitfield_sort.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+DEFINE_BITFIELD_ENUM(
+     JobEnum,
+           Id,
+           State,
+           Prio,
+           Owner);
+
+DEFINE_BITFIELD_SIZES(
+    JobSizes,
+          20,
+           3,
+           2,
+           7);
+
+DEFINE_BITFIELDS(
+    Job,
+    JobEnum,
+    JobSizes);
+
+namespace {
+
+    const std::size_t NUM_RECORDS = 1 << 22;
+    const int REPEATS = 5;
+
+    bool byFields(const Job & a, const Job & b)
+    {
+        if (a.get<JobEnum::Prio>() != b.get<JobEnum::Prio>()) {
+            return a.get<JobEnum::Prio>() < b.get<JobEnum::Prio>();
+        }
+        if (a.get<JobEnum::State>() != b.get<JobEnum::State>()) {
+            return a.get<JobEnum::State>() < b.get<JobEnum::State>();
+        }
+        return a.get<JobEnum::Id>() < b.get<JobEnum::Id>();
+    }
+
+    template <class Fn>
+    double nsPerRecord(const std::vector<Job> & input, Fn fn)
+    {
+        double sec = 0;
+        for (int r = 0; r < REPEATS; ++r) {
+            std::vector<Job> recs(input);
+            bench::Timer t;
+            fn(recs);
+            sec += t.elapsedSec();
+            bench::doNotOptimize(recs[r].bits());
+        }
+        return sec * 1e9 / (double(NUM_RECORDS) * REPEATS);
+    }
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    bench::Report report(argc, argv, "bSort");
+    std::vector<Job> input(NUM_RECORDS);
+    uint64_t state = 1;
+    for (std::size_t i = 0; i < input.size(); ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        input[i] = Job::fromBits(static_cast<uint32_t>(state >> 32));
+    }
+
+    const double comparison = nsPerRecord(input, [](std::vector<Job> & recs) {
+        std::sort(recs.begin(), recs.end(), byFields);
+    });
+    std::printf("%-14s %8.3f ns/record\n", "std::sort", comparison);
+    report.add("sort/std", comparison);
+
+    const double radix = nsPerRecord(input, [](std::vector<Job> & recs) {
+        cppbitfield::radixSort<Job, JobEnum::Prio, JobEnum::State, JobEnum::Id>(recs.data(), recs.size());
+    });
+    std::printf("%-14s %8.3f ns/record\n", "radixSort", radix);
+    report.add("sort/radix", radix);
+
+    const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    const double threaded = nsPerRecord(input, [](std::vector<Job> & recs) {
+        cppbitfield::radixSort<Job, JobEnum::Prio, JobEnum::State, JobEnum::Id>(recs.data(), recs.size(), 0);
+    });
+    std::printf("%-14s %8.3f ns/record on %u threads\n", "radixSort", threaded, hw);
+    report.add("sort/radix_threads", threaded);
+    return 0;
+}
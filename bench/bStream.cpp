@@ -0,0 +1,132 @@
+/**
+ * \file bStream.cpp
+ * \date Oct 16, 2026
+ *
+ * Sustained throughput of the chunked record stream on a local file (warm
+ * page cache): the writer, a single-threaded read-then-decode loop, and the
+ * pipelined reader with a growing decode pool. GB/s counts packed bytes.
+ */
+
+#include "bench.hpp"
+
+#include <cppbitfield/bitfield_stream.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+DEFINE_BITFIELD_ENUM(
+     TradeEnum,
+           Side,
+           Venue,
+           Qty,
+           Price);
+
+DEFINE_BITFIELD_SIZES(
+    TradeSizes,
+           1,
+           5,
+          20,
+          24);
+
+DEFINE_BITFIELDS(
+    Trade,
+    TradeEnum,
+    TradeSizes);
+
+namespace {
+
+    const uint64_t NUM_RECORDS = 1 << 24;
+    const std::size_t RECORDS_PER_BLOCK = 1 << 16;
+    const char * const PATH = "bStream.bin";
+
+    double gbPerSec(double nsPerRecord)
+    {
+        return Trade::NumBits / 8.0 / nsPerRecord;
+    }
+
+    void print(bench::Report & report, const std::string & name, double ns)
+    {
+        std::printf("%-24s %8.3f ns/record %8.2f GB/s\n", name.c_str(), ns, gbPerSec(ns));
+        report.add(name, ns);
+    }
+
+    // Plain loop for comparison: read one block, verify, decode, consume.
+    uint64_t readSerial()
+    {
+        std::FILE * f = std::fopen(PATH, "rb");
+        cppbitfield::BitFieldStreamHeader hdr;
+        uint64_t sum = 0;
+        if (std::fread(&hdr, sizeof(hdr), 1, f) != 1) {
+            std::fclose(f);
+            return 0;
+        }
+        std::vector<uint64_t> raw(2 + cppbitfield::detail::blockWords<Trade::NumBits>(hdr.recordsPerBlock));
+        std::vector<Trade> recs(hdr.recordsPerBlock);
+        for (uint64_t left = hdr.numRecords; left > 0;) {
+            const uint64_t n = std::min<uint64_t>(left, hdr.recordsPerBlock);
+            const std::size_t words = cppbitfield::detail::blockWords<Trade::NumBits>(n);
+            if (std::fread(raw.data(), sizeof(uint64_t), 2 + words, f) != 2 + words ||
+                raw[1] != cppbitfield::detail::blockChecksum(raw.data() + 2, words)) {
+                break;
+            }
+            for (std::size_t i = 0; i < n; ++i) {
+                recs[i] = Trade::fromBits(cppbitfield::detail::loadBits<Trade::NumBits>(raw.data() + 2, i * Trade::NumBits));
+            }
+            for (std::size_t i = 0; i < n; ++i) {
+                sum += recs[i].get<TradeEnum::Qty>();
+            }
+            left -= n;
+        }
+        std::fclose(f);
+        return sum;
+    }
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    bench::Report report(argc, argv, "bStream");
+
+    {
+        cppbitfield::BitFieldStreamWriter<TradeEnum, TradeSizes> w;
+        bench::Timer timer;
+        w.open(PATH, RECORDS_PER_BLOCK);
+        for (uint64_t i = 0; i < NUM_RECORDS; ++i) {
+            w.push(Trade::make(TradeEnum::Side, i & 1, TradeEnum::Venue, i % 31, TradeEnum::Qty, i & 0xFFFFF,
+                               TradeEnum::Price, (i * 2654435761u) & 0xFFFFFF));
+        }
+        w.close();
+        print(report, "write", timer.elapsedSec() * 1e9 / NUM_RECORDS);
+    }
+
+    // warm the page cache
+    bench::doNotOptimize(readSerial());
+    {
+        bench::Timer timer;
+        bench::doNotOptimize(readSerial());
+        print(report, "read/serial", timer.elapsedSec() * 1e9 / NUM_RECORDS);
+    }
+
+    const unsigned maxWorkers = std::max(4u, std::thread::hardware_concurrency());
+    for (unsigned workers = 1; workers <= maxWorkers; workers *= 2) {
+        cppbitfield::BitFieldStreamReader<TradeEnum, TradeSizes> r;
+        bench::Timer timer;
+        r.open(PATH, workers);
+        uint64_t sum = 0;
+        const Trade * recs;
+        std::size_t n;
+        while (r.nextBlock(recs, n)) {
+            for (std::size_t i = 0; i < n; ++i) {
+                sum += recs[i].get<TradeEnum::Qty>();
+            }
+        }
+        bench::doNotOptimize(sum);
+        print(report, "read/pipelined/" + std::to_string(workers) + "w", timer.elapsedSec() * 1e9 / NUM_RECORDS);
+    }
+
+    std::remove(PATH);
+    return 0;
+}
@@ -0,0 +1,141 @@
+/**
+ * \file bench.hpp
+ * \date Oct 16, 2026
+ */
+
+#ifndef CPPBITFIELD_BENCH_HPP
+#define CPPBITFIELD_BENCH_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace bench {
+
+    class Timer
+    {
+      public:
+        Timer() : m_start(std::chrono::steady_clock::now()) { }
+
+        double elapsedSec() const
+        {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+        }
+
+      private:
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+    // Keeps `val` alive so the optimizer cannot drop the computation.
+    template <class T>
+    inline void doNotOptimize(const T & val)
+    {
+#if defined(__GNUC__)
+        asm volatile("" : : "g"(val) : "memory");
+#else
+        static volatile T sink;
+        sink = val;
+#endif
+    }
+
+    /**
+     * Collects the results of one benchmark executable. When run with
+     * `--json <file>` the results are written there on destruction, so the
+     * `bench` target can archive them and compare releases.
+     */
+    class Report
+    {
+      public:
+        Report(int argc, char ** argv, const char * suite) : m_suite(suite)
+        {
+            for (int i = 1; i + 1 < argc; ++i) {
+                if (std::strcmp(argv[i], "--json") == 0) {
+                    m_path = argv[i + 1];
+                }
+            }
+        }
+
+        ~Report()
+        {
+            if (m_path.empty()) {
+                return;
+            }
+            std::FILE * f = std::fopen(m_path.c_str(), "w");
+            if (f == nullptr) {
+                std::fprintf(stderr, "cannot write %s\n", m_path.c_str());
+                return;
+            }
+            std::fprintf(f, "{\n  \"suite\": \"%s\",\n", escape(m_suite).c_str());
+            std::fprintf(f, "  \"compiler\": \"%s\",\n", escape(compiler()).c_str());
+            std::fprintf(f, "  \"hardware_threads\": %u,\n", std::thread::hardware_concurrency());
+            std::fprintf(f, "  \"results\": [");
+            for (std::size_t i = 0; i < m_results.size(); ++i) {
+                std::fprintf(f, "%s\n    { \"name\": \"%s\", \"ns_per_op\": %.4f, \"mops_per_sec\": %.2f",
+                             i == 0 ? "" : ",", escape(m_results[i].name).c_str(),
+                             m_results[i].nsPerOp, m_results[i].nsPerOp > 0 ? 1e3 / m_results[i].nsPerOp : 0.0);
+                if (m_results[i].peakKib >= 0) {
+                    std::fprintf(f, ", \"peak_rss_kib\": %.0f", m_results[i].peakKib);
+                }
+                std::fprintf(f, " }");
+            }
+            std::fprintf(f, "\n  ]\n}\n");
+            std::fclose(f);
+        }
+
+        void add(const std::string & name, double nsPerOp)
+        {
+            add(name, nsPerOp, -1);
+        }
+
+        // A result that also records peak memory, e.g. of a compiler run.
+        void add(const std::string & name, double nsPerOp, double peakKib)
+        {
+            Result r = { name, nsPerOp, peakKib };
+            m_results.push_back(r);
+        }
+
+      private:
+        struct Result
+        {
+            std::string name;
+            double nsPerOp;
+            double peakKib;
+        };
+
+        static std::string escape(const std::string & s)
+        {
+            std::string ret;
+            for (std::size_t i = 0; i < s.size(); ++i) {
+                if (s[i] == '"' || s[i] == '\\') {
+                    ret += '\\';
+                }
+                ret += s[i];
+            }
+            return ret;
+        }
+
+        static std::string compiler()
+        {
+#if defined(__clang__)
+            return std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+            return std::string("gcc ") + __VERSION__;
+#elif defined(_MSC_VER)
+            return "msvc " + std::to_string(_MSC_VER);
+#else
+            return "unknown";
+#endif
+        }
+
+        std::string m_suite;
+        std::string m_path;
+        std::vector<Result> m_results;
+    };
+
+} // namespace bench
+
+#endif/*CPPBITFIELD_BENCH_HPP*/
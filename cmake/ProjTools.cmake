@@ -482,6 +482,22 @@ function(install_tgt libname)
           RUNTIME DESTINATION ${PROJ_INSTALL_BIN_DIR})
 endfunction(install_tgt)
 
+# -- BENCHMARK RELATED HELPERS
+
+# 'bench' runs every benchmark and collects its JSON results
+set(PROJ_BENCH_RESULT_DIR "${CMAKE_BINARY_DIR}/bench_results")
+add_custom_target(bench)
+
+# -- add_bench_exe: Add benchmark executable, run by the bench target
+function(add_bench_exe benchname filename)
+  add_exe(${ARGV})
+  add_custom_target(${benchname}_run
+                    COMMAND ${CMAKE_COMMAND} -E make_directory ${PROJ_BENCH_RESULT_DIR}
+                    COMMAND ${benchname} --json ${PROJ_BENCH_RESULT_DIR}/${benchname}.json
+                    DEPENDS ${benchname})
+  add_dependencies(bench ${benchname}_run)
+endfunction(add_bench_exe)
+
 # -- TEST RELATED HELPERS
 
 # enable testing for test subfolder
@@ -2,7 +2,31 @@
 # -- Headers
 # export
 set(cppbitfield_exp_hdr
-    include/cppbitfield/bitfield.hpp)
+    include/cppbitfield/bitfield.hpp
+    include/cppbitfield/bitfield_aggregate.hpp
+    include/cppbitfield/bitfield_array.hpp
+    include/cppbitfield/bitfield_atomic.hpp
+    include/cppbitfield/bitfield_bmi2.hpp
+    include/cppbitfield/bitfield_codec.hpp
+    include/cppbitfield/bitfield_columns.hpp
+    include/cppbitfield/bitfield_delta.hpp
+    include/cppbitfield/bitfield_diff.hpp
+    include/cppbitfield/bitfield_endian.hpp
+    include/cppbitfield/bitfield_file.hpp
+    include/cppbitfield/bitfield_optimized.hpp
+    include/cppbitfield/bitfield_parallel.hpp
+    include/cppbitfield/bitfield_predicate.hpp
+    include/cppbitfield/bitfield_profile.hpp
+    include/cppbitfield/bitfield_rank.hpp
+    include/cppbitfield/bitfield_simd.hpp
+    include/cppbitfield/bitfield_sort.hpp
+    include/cppbitfield/bitfield_stream.hpp
+    include/cppbitfield/bitfield_view.hpp
+    include/cppbitfield/detail/aggregate_kernels.inl
+    include/cppbitfield/detail/codec_kernels.inl
+    include/cppbitfield/detail/diff_kernels.inl
+    include/cppbitfield/detail/predicate_kernels.inl
+    include/cppbitfield/detail/simd_kernels.inl)
 
 # -- Install!
 install_hdr(${cppbitfield_exp_hdr})
@@ -7,15 +7,50 @@
 #define CPPBITFIELD_BITFIELD_HPP
 
 #include <cstdint>
+#include <cstring>
 #include <type_traits>
 #include <limits>
+#include <tuple>
 
 #include <cassert>
 
+#if defined(CPPBITFIELD_PROFILE)
+#  include <atomic>
+#  include <memory>
+#  include <mutex>
+#  include <typeinfo>
+#  include <vector>
+#endif
+
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#  define CPPBITFIELD_HOST_BIG_ENDIAN 1
+#endif
+
 #if !defined(CPPBITFIELD_ASSERT)
 #  define CPPBITFIELD_ASSERT assert
 #endif
 
+// Check usable inside a constexpr function: a failure is a compile error
+// during constant evaluation and a CPPBITFIELD_ASSERT at run time.
+#define CPPBITFIELD_CONSTEXPR_ASSERT(expr) \
+    (static_cast<bool>(expr) ? static_cast<void>(0) : static_cast<void>(CPPBITFIELD_ASSERT(expr)))
+
+// True while a constexpr function is being constant evaluated, where the
+// profiling counters must not be touched. Without the builtin a profiled
+// get() is not a constant expression.
+#if defined(CPPBITFIELD_PROFILE) && !defined(CPPBITFIELD_IS_CONSTANT_EVALUATED)
+#  if defined(__clang__)
+#    if __has_builtin(__builtin_is_constant_evaluated)
+#      define CPPBITFIELD_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#    endif
+#  elif defined(__GNUC__) && __GNUC__ >= 9
+#    define CPPBITFIELD_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#  endif
+#  if !defined(CPPBITFIELD_IS_CONSTANT_EVALUATED)
+#    define CPPBITFIELD_IS_CONSTANT_EVALUATED() false
+#  endif
+#endif
+
 namespace cppbitfield {
 
     namespace detail {
@@ -40,36 +75,9 @@ namespace cppbitfield {
             };
         };
 
-        template <int Idx, int... Sizes>
-        struct GetImpl;
-
-        template <int Idx>
-        struct GetImpl<Idx>
-        {
-            static const int value = -1;
-        };
-
-        template <int Idx, int S, int... Sizes>
-        struct GetImpl<Idx, S, Sizes...>
-        {
-            static const int value = (Idx == 0) ? S : GetImpl<Idx - 1, Sizes...>::value;
-        };
-
-
-        template <int Idx, int... Sizes>
-        struct SumTillImpl;
-
-        template <int Idx>
-        struct SumTillImpl<Idx>
-        {
-            static const int value = -1;
-        };
-
-        template <int Idx, int S, int... Sizes>
-        struct SumTillImpl<Idx, S, Sizes...>
-        {
-            static const int value = (Idx == 0) ? 0 : (S + SumTillImpl<Idx - 1, Sizes...>::value);
-        };
+        template <class EnumType, class IntType>
+        template <IntType X>
+        const EnumType AsEnumType<EnumType, IntType>::Convert<X>::value;
 
         template <bool GT8, bool GT16, bool GT32>
         struct SelectorImpl;
@@ -102,7 +110,57 @@ namespace cppbitfield {
             static const type max_value = 0xFFFFFFFFFFFFFFFF;
         };
 
-        template <int Size>
+        template <int NumWords>
+        struct WordArray
+        {
+            uint64_t words[NumWords];
+        };
+
+        template <int... Is>
+        struct IndexSeq { };
+
+        template <int N, int... Is>
+        struct MakeIndexSeq : MakeIndexSeq<N - 1, N - 1, Is...> { };
+
+        template <int... Is>
+        struct MakeIndexSeq<0, Is...>
+        {
+            using type = IndexSeq<Is...>;
+        };
+
+        constexpr int sumFirst(const int * sizes, int n)
+        {
+            return n == 0 ? 0 : sizes[n - 1] + sumFirst(sizes, n - 1);
+        }
+
+        constexpr bool allInRange(const int * sizes, int n, int lo, int hi)
+        {
+            return n == 0 || (sizes[n - 1] >= lo && sizes[n - 1] <= hi && allInRange(sizes, n - 1, lo, hi));
+        }
+
+        /**
+         * Lengths and offsets of a field sizes pack, computed once per pack
+         * so that looking up a field is an array index rather than a
+         * recursion over the pack for every field. offsets has one entry
+         * past the last field: the total number of bits.
+         */
+        template <class Fields, int... Sizes>
+        struct SizeTable;
+
+        template <int... Is, int... Sizes>
+        struct SizeTable<IndexSeq<Is...>, Sizes...>
+        {
+            static constexpr int lengths[sizeof...(Sizes)] = { Sizes... };
+            static constexpr int offsets[sizeof...(Sizes) + 1] = { sumFirst(lengths, Is)... };
+        };
+
+        template <int... Is, int... Sizes>
+        constexpr int SizeTable<IndexSeq<Is...>, Sizes...>::lengths[sizeof...(Sizes)];
+
+        template <int... Is, int... Sizes>
+        constexpr int SizeTable<IndexSeq<Is...>, Sizes...>::offsets[sizeof...(Sizes) + 1];
+
+        template <int Size, bool MultiWord = (Size > 64)>
         struct StorageTypeSelector
         {
             static const bool GT_8  = Size >  8;
@@ -113,29 +171,279 @@ namespace cppbitfield {
             static const type max_value = SelectorImpl<GT_8, GT_16, GT_32>::max_value;
         };
 
+        template <int Size>
+        struct StorageTypeSelector<Size, true>
+        {
+            using type = WordArray<(Size + 63) / 64>;
+        };
+
+        template <class T, int Length>
+        struct LowMask
+        {
+            static_assert(Length >= 1 && Length <= std::numeric_limits<T>::digits, "Mask length out of range.");
+            static const T value = static_cast<T>(static_cast<T>(~static_cast<T>(0)) >> (std::numeric_limits<T>::digits - Length));
+        };
+
+        // LowMask for a length only known as a (constexpr) function argument.
+        constexpr uint64_t lowMask64(int length)
+        {
+            return length >= 64 ? ~static_cast<uint64_t>(0) : (static_cast<uint64_t>(1) << length) - 1;
+        }
+
+        // Number of significant bits of x, 0 for 0.
+        constexpr int bitWidth(uint64_t x)
+        {
+#if defined(__GNUC__)
+            return x == 0 ? 0 : 64 - __builtin_clzll(x);
+#else
+            return x == 0 ? 0 : 1 + bitWidth(x >> 1);
+#endif
+        }
+
+        constexpr bool fitsLength(uint64_t val, int length)
+        {
+            return (val & ~lowMask64(length)) == 0;
+        }
+
+#if defined(CPPBITFIELD_HOST_BIG_ENDIAN)
+        static const bool HOST_BIG_ENDIAN = true;
+#else
+        static const bool HOST_BIG_ENDIAN = false;
+#endif
+
+        template <int N>
+        struct UIntOfSize;
+
+        template <> struct UIntOfSize<1> { using type = uint8_t; };
+        template <> struct UIntOfSize<2> { using type = uint16_t; };
+        template <> struct UIntOfSize<4> { using type = uint32_t; };
+        template <> struct UIntOfSize<8> { using type = uint64_t; };
+
+        // A field that is a whole 8, 16, 32 or 64-bit integer at a byte
+        // offset. Writing it is a single narrow store instead of a
+        // read-modify-write of the record, which would make the next read of
+        // any other field wait on the store.
+        template <int Offset, int Length>
+        struct ByteAligned
+        {
+            static const bool value = Offset % 8 == 0 && (Length == 8 || Length == 16 || Length == 32 || Length == 64);
+        };
+
+        // Host order integer of Length bits at any address.
+        template <int Length>
+        inline uint64_t loadNarrow(const unsigned char * p)
+        {
+            typename UIntOfSize<Length / 8>::type v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        template <int Length>
+        inline void storeNarrow(unsigned char * p, uint64_t val)
+        {
+            const typename UIntOfSize<Length / 8>::type v = static_cast<typename UIntOfSize<Length / 8>::type>(val);
+            std::memcpy(p, &v, sizeof(v));
+        }
+
+        // Byte-aligned field stored straight into the bytes of a native T.
+        template <class T, int Offset, int Length>
+        struct NarrowField
+        {
+            static const int Byte = HOST_BIG_ENDIAN ? static_cast<int>(sizeof(T)) - Offset / 8 - Length / 8 : Offset / 8;
+
+            static void set(T & bits, uint64_t val)
+            {
+                storeNarrow<Length>(reinterpret_cast<unsigned char *>(&bits) + Byte, val);
+            }
+        };
+
+        // Field of a multi-word record that lies within a single word.
+        template <int Shift, int Length, bool Straddle = (Shift + Length > 64)>
+        struct WordField
+        {
+            static constexpr uint64_t get(const uint64_t * w)
+            {
+                return (w[0] >> Shift) & LowMask<uint64_t, Length>::value;
+            }
+
+            static void set(uint64_t * w, uint64_t val)
+            {
+                set(w, val, std::integral_constant<bool, ByteAligned<Shift, Length>::value>());
+            }
+
+          private:
+            static void set(uint64_t * w, uint64_t val, std::false_type)
+            {
+                static const uint64_t mask = LowMask<uint64_t, Length>::value;
+                w[0] = (w[0] & ~(mask << Shift)) | (val << Shift);
+            }
+
+            static void set(uint64_t * w, uint64_t val, std::true_type)
+            {
+                NarrowField<uint64_t, Shift, Length>::set(w[0], val);
+            }
+        };
+
+        // Field crossing into the next word: fixed two-word funnel shift.
+        template <int Shift, int Length>
+        struct WordField<Shift, Length, true>
+        {
+            static constexpr uint64_t get(const uint64_t * w)
+            {
+                return ((w[0] >> Shift) | (w[1] << (64 - Shift))) & LowMask<uint64_t, Length>::value;
+            }
+
+            static void set(uint64_t * w, uint64_t val)
+            {
+                static const uint64_t mask = LowMask<uint64_t, Length>::value;
+                w[0] = (w[0] & ~(mask << Shift)) | (val << Shift);
+                w[1] = (w[1] & ~(mask >> (64 - Shift))) | (val >> (64 - Shift));
+            }
+        };
+
+        // Field access on a single integer word.
+        template <class T>
+        struct BitsAccess
+        {
+            using ValueType = T;
+
+            template <int Offset, int Length>
+            static constexpr T get(T bits)
+            {
+                return static_cast<T>((bits >> Offset) & LowMask<T, Length>::value);
+            }
+
+            template <int Offset, int Length>
+            static void set(T & bits, T val)
+            {
+                set<Offset, Length>(bits, val, std::integral_constant<bool, ByteAligned<Offset, Length>::value>());
+            }
+
+            template <int NumBits>
+            static constexpr bool fits(T bits)
+            {
+                return (bits & ~LowMask<T, NumBits>::value) == 0;
+            }
+
+            // Copy of `bits` with [offset, offset + length) replaced by `val`.
+            static constexpr T put(T bits, int offset, int length, uint64_t val)
+            {
+                return static_cast<T>((static_cast<uint64_t>(bits) & ~(lowMask64(length) << offset)) |
+                                      ((val & lowMask64(length)) << offset));
+            }
+
+          private:
+            template <int Offset, int Length>
+            static void set(T & bits, T val, std::false_type)
+            {
+                static const T mask = LowMask<T, Length>::value;
+                bits = static_cast<T>((bits & ~(mask << Offset)) | (val << Offset));
+            }
+
+            template <int Offset, int Length>
+            static void set(T & bits, T val, std::true_type)
+            {
+                NarrowField<T, Offset, Length>::set(bits, val);
+            }
+        };
+
+        // Field access on an array of words; the word and the single-word or
+        // funnel path are both chosen at compile time.
+        template <int NumWords>
+        struct BitsAccess<WordArray<NumWords> >
+        {
+            using ValueType = uint64_t;
+
+            template <int Offset, int Length>
+            static constexpr uint64_t get(const WordArray<NumWords> & bits)
+            {
+                return WordField<Offset % 64, Length>::get(bits.words + Offset / 64);
+            }
+
+            template <int Offset, int Length>
+            static void set(WordArray<NumWords> & bits, uint64_t val)
+            {
+                WordField<Offset % 64, Length>::set(bits.words + Offset / 64, val);
+            }
+
+            template <int NumBits>
+            static constexpr bool fits(const WordArray<NumWords> & bits)
+            {
+                return BitsAccess<uint64_t>::template fits<NumBits - 64 * (NumWords - 1)>(bits.words[NumWords - 1]);
+            }
+
+            static constexpr WordArray<NumWords> put(const WordArray<NumWords> & bits, int offset, int length, uint64_t val)
+            {
+                return put(bits, offset, length, val & lowMask64(length), typename MakeIndexSeq<NumWords>::type());
+            }
+
+          private:
+            // an aggregate cannot be modified in a C++11 constant expression,
+            // so every word is rebuilt
+            template <int... Is>
+            static constexpr WordArray<NumWords> put(const WordArray<NumWords> & bits, int offset, int length,
+                                                     uint64_t val, IndexSeq<Is...>)
+            {
+                return WordArray<NumWords>{ { putWord(bits.words[Is], 64 * Is, offset, length, val)... } };
+            }
+
+            // word holding bits [base, base + 64) with the overlapping part of the field replaced
+            static constexpr uint64_t putWord(uint64_t word, int base, int offset, int length, uint64_t val)
+            {
+                return offset >= base + 64 || offset + length <= base ? word :
+                       offset >= base ? (word & ~(lowMask64(length) << (offset - base))) | (val << (offset - base)) :
+                                        (word & ~(lowMask64(length) >> (base - offset))) | (val >> (base - offset));
+            }
+        };
+
     } // namespace detail
 
     template <int... Sizes>
     struct BitFieldSizes;
 
+    /**
+     * Bit order policies for a layout. LsbFirst places the first field at
+     * bit 0; MsbFirst places it at the most significant bits, numbering
+     * fields the way wire formats such as IPv4/TCP headers draw them.
+     */
+    struct LsbFirst { };
+    struct MsbFirst { };
+
     template <>
     struct BitFieldSizes<>
     {
+        using BitOrder = LsbFirst;
+
         static const int NumFields = 0;
+
+        static const int NumBits = 0;
+
+        static constexpr int length(int) { return 0; }
+
+        static constexpr int offset(int) { return 0; }
     };
 
     template <int S, int... Sizes>
     struct BitFieldSizes<S, Sizes...>
     {
-        static_assert(S >= 1 && S <= 64, "Bit field size must be in the range [1, 64].");
+      private:
+        using Table = detail::SizeTable<typename detail::MakeIndexSeq<2 + sizeof...(Sizes)>::type, S, Sizes...>;
+
+      public:
+        static_assert(detail::allInRange(Table::lengths, 1 + sizeof...(Sizes), 1, 64),
+                      "Bit field size must be in the range [1, 64].");
+        using BitOrder = LsbFirst;
+
         static const int NumFields = 1 + sizeof...(Sizes);
 
+        static const int NumBits = Table::offsets[NumFields];
+
         template <int Idx>
         struct Get
         {
             static_assert(Idx >= 0, "Index out of bounds.");
             static_assert(Idx < (sizeof...(Sizes) + 1), "Index out of bounds.");
-            static const int value = detail::GetImpl<Idx, S, Sizes...>::value;
+            static const int value = Table::lengths[Idx];
         };
 
         template <int Idx>
@@ -143,8 +451,50 @@ namespace cppbitfield {
         {
             static_assert(Idx >= 0, "Index out of bounds.");
             static_assert(Idx < (sizeof...(Sizes) + 1), "Index out of bounds.");
-            static const int value = detail::SumTillImpl<Idx, S, Sizes...>::value;
-        };     
+            static const int value = Table::offsets[Idx];
+        };
+
+        // Run time index counterparts of Get/SumTill, usable in constant expressions.
+        static constexpr int length(int idx)
+        {
+            return Table::lengths[idx];
+        }
+
+        static constexpr int offset(int idx)
+        {
+            return Table::offsets[idx];
+        }
+    };
+
+    /**
+     * Field sizes with an explicit bit order, e.g.
+     * `BitFieldLayout<MsbFirst, BitFieldSizes<4, 4, 6, 2, 16> >` for the
+     * first word of an IPv4 header. Offsets are still counted from the least
+     * significant bit of the storage, so every accessor keeps its fixed
+     * shift and mask; only the offsets themselves are mirrored.
+     */
+    template <class Order, class Sizes>
+    struct BitFieldLayout;
+
+    template <class Sizes>
+    struct BitFieldLayout<LsbFirst, Sizes> : Sizes { };
+
+    template <class Sizes>
+    struct BitFieldLayout<MsbFirst, Sizes> : Sizes
+    {
+        using BitOrder = MsbFirst;
+
+        template <int Idx>
+        struct SumTill
+        {
+            static const int value = Sizes::NumBits - Sizes::template SumTill<Idx>::value -
+                                     Sizes::template Get<Idx>::value;
+        };
+
+        static constexpr int offset(int idx)
+        {
+            return Sizes::NumBits - Sizes::offset(idx) - Sizes::length(idx);
+        }
     };
 
     template <class EnumType>
@@ -164,11 +514,222 @@ namespace cppbitfield {
         static const IntType NumFields = AsInt<EnumType::__NUM_FIELDS>::value;
     };
 
+    namespace detail {
+
+        template <class Record, typename Record::IntType Idx>
+        struct FieldPos
+        {
+            static const int offset = Record::template FieldOffset<Idx>::value;
+            static const int length = Record::template FieldLength<Idx>::value;
+        };
+
+        // Combined in-place mask of the fields Xs of a single-word record.
+        template <class Record, typename Record::FieldEnum... Xs>
+        struct FieldsMask;
+
+        template <class Record>
+        struct FieldsMask<Record>
+        {
+            static const typename Record::StorageType value = 0;
+        };
+
+        template <class Record, typename Record::FieldEnum X, typename Record::FieldEnum... Xs>
+        struct FieldsMask<Record, X, Xs...>
+        {
+            using StorageType = typename Record::StorageType;
+            using Pos = FieldPos<Record, Record::template AsInt<X>::value>;
+
+            static const StorageType value = static_cast<StorageType>(
+                static_cast<StorageType>(LowMask<StorageType, Pos::length>::value << Pos::offset) |
+                FieldsMask<Record, Xs...>::value);
+        };
+
+        // Places each value at its field offset; the result only has bits set
+        // inside FieldsMask<Record, Xs...>.
+        template <class Record>
+        inline typename Record::StorageType packFields()
+        {
+            return 0;
+        }
+
+        template <class Record, typename Record::FieldEnum X, typename Record::FieldEnum... Xs, class Y, class... Ys>
+        inline typename Record::StorageType packFields(Y val, Ys... vals)
+        {
+            using StorageType = typename Record::StorageType;
+            using Pos = FieldPos<Record, Record::template AsInt<X>::value>;
+            static const StorageType mask = LowMask<StorageType, Pos::length>::value;
+            const StorageType valtrunc = static_cast<StorageType>(static_cast<StorageType>(val) & mask);
+            CPPBITFIELD_ASSERT("Value too large for bitfield length." &&
+                               (static_cast<StorageType>(val) == valtrunc));
+            return static_cast<StorageType>(static_cast<StorageType>(valtrunc << Pos::offset) |
+                                            packFields<Record, Xs...>(vals...));
+        }
+
+#if defined(CPPBITFIELD_PROFILE)
+        struct ProfileCounts;
+
+        /**
+         * Access counts of one record type, summed over threads: the counts
+         * of live threads plus those retired by threads that have exited,
+         * less the baseline of the last reset. Never destroyed, so counts
+         * can be read from atexit handlers and late thread exits.
+         */
+        struct ProfileType
+        {
+            const char * name;
+            int numBits;
+            std::vector<int> offsets;
+            std::vector<int> lengths;
+            std::vector<ProfileCounts *> live;
+            std::vector<uint64_t> retired;
+            std::vector<uint64_t> base;
+            std::mutex lock;
+
+            ProfileType(const char * n, int bits, std::vector<int> offs, std::vector<int> lens)
+                : name(n), numBits(bits), offsets(offs), lengths(lens),
+                  retired(2 * offs.size(), 0), base(2 * offs.size(), 0) { }
+
+            // reads of field i at i, writes at NumFields + i
+            std::vector<uint64_t> totals();
+
+            void reset()
+            {
+                const std::vector<uint64_t> now = totals();
+                std::lock_guard<std::mutex> guard(lock);
+                for (std::size_t i = 0; i < now.size(); ++i) {
+                    base[i] += now[i];
+                }
+            }
+        };
+
+        // Registry of every record type accessed so far.
+        inline std::mutex & profileLock()
+        {
+            static std::mutex & m = *new std::mutex;
+            return m;
+        }
+
+        inline std::vector<ProfileType *> & profileTypes()
+        {
+            static std::vector<ProfileType *> & types = *new std::vector<ProfileType *>;
+            return types;
+        }
+
+        /**
+         * One thread's counts of one record type. Only the owning thread
+         * writes them, so a count is a relaxed load and store rather than a
+         * locked increment; readers see each count whole.
+         */
+        struct ProfileCounts
+        {
+            ProfileType & type;
+            std::unique_ptr<std::atomic<uint64_t>[]> counts;
+
+            explicit ProfileCounts(ProfileType & t)
+                : type(t), counts(new std::atomic<uint64_t>[t.retired.size()])
+            {
+                for (std::size_t i = 0; i < t.retired.size(); ++i) {
+                    counts[i].store(0, std::memory_order_relaxed);
+                }
+                std::lock_guard<std::mutex> guard(type.lock);
+                type.live.push_back(this);
+            }
+
+            ~ProfileCounts()
+            {
+                std::lock_guard<std::mutex> guard(type.lock);
+                for (std::size_t i = 0; i < type.retired.size(); ++i) {
+                    type.retired[i] += counts[i].load(std::memory_order_relaxed);
+                }
+                for (std::size_t i = 0; i < type.live.size(); ++i) {
+                    if (type.live[i] == this) {
+                        type.live.erase(type.live.begin() + i);
+                        break;
+                    }
+                }
+            }
+
+            void bump(int idx)
+            {
+                counts[idx].store(counts[idx].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+        };
+
+        inline std::vector<uint64_t> ProfileType::totals()
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            std::vector<uint64_t> sum(retired);
+            for (std::size_t t = 0; t < live.size(); ++t) {
+                for (std::size_t i = 0; i < sum.size(); ++i) {
+                    sum[i] += live[t]->counts[i].load(std::memory_order_relaxed);
+                }
+            }
+            for (std::size_t i = 0; i < sum.size(); ++i) {
+                sum[i] -= base[i];
+            }
+            return sum;
+        }
+
+        template <class EnumType, class Sizes>
+        struct FieldCounters
+        {
+            static ProfileType & type()
+            {
+                static ProfileType & t = registered();
+                return t;
+            }
+
+            static constexpr bool read(int idx)
+            {
+                return CPPBITFIELD_IS_CONSTANT_EVALUATED() || (local().bump(idx), true);
+            }
+
+            static void write(int idx)
+            {
+                local().bump(Sizes::NumFields + idx);
+            }
+
+          private:
+            static ProfileType & registered()
+            {
+                std::vector<int> offsets(Sizes::NumFields);
+                std::vector<int> lengths(Sizes::NumFields);
+                for (int i = 0; i < Sizes::NumFields; ++i) {
+                    offsets[i] = Sizes::offset(i);
+                    lengths[i] = Sizes::length(i);
+                }
+                ProfileType * t = new ProfileType(typeid(EnumType).name(), Sizes::NumBits, offsets, lengths);
+                std::lock_guard<std::mutex> guard(profileLock());
+                profileTypes().push_back(t);
+                return *t;
+            }
+
+            static ProfileCounts & local()
+            {
+                static thread_local ProfileCounts counts(type());
+                return counts;
+            }
+        };
+#else
+        // Profiling disabled: the hooks in get/set compile to nothing.
+        template <class EnumType, class Sizes>
+        struct FieldCounters
+        {
+            static constexpr bool read(int) { return true; }
+
+            static void write(int) { }
+        };
+#endif
+
+    } // namespace detail
+
     template <class EnumType, class Sizes>
     struct BitFields
     {
         using Traits = BitFieldDescriptor<EnumType>;
-        
+
+        using FieldEnum = EnumType;
+
         static const int NumFields = Traits::NumFields;
 
         using IntType = typename Traits::IntType;
@@ -177,11 +738,10 @@ namespace cppbitfield {
         using AsInt = typename Traits::template AsInt<X>;
 
         template <IntType X>
-        struct AsEnum
+        struct AsEnum : Traits::template AsEnum<X>
         {
             static_assert(X >= 0, "Integer value must be a valid enum value.");
             static_assert(X < NumFields, "Integer value must be a valid enum value.");
-            static const EnumType value = Traits::template AsEnum<X>::value;
         };
 
         template <int X>
@@ -190,30 +750,64 @@ namespace cppbitfield {
         template <int X>
         using FieldOffset = typename Sizes::template SumTill<X>;
 
-        static const int NumBits = FieldOffset<NumFields - 1>::value + FieldLength<NumFields - 1>::value;
+        static const int NumBits = Sizes::NumBits;
 
         static_assert(Sizes::NumFields == NumFields, "Number of fields must match total number of fields.");
-        static_assert(NumBits <= 64, "Total number of bits must be <= 64.");
 
+        // a single integer up to 64 bits, an array of uint64_t words beyond
         using StorageType = typename detail::StorageTypeSelector<NumBits>::type;
 
+        // type of a single field value: StorageType, or uint64_t for multi-word storage
+        using ValueType = typename detail::BitsAccess<StorageType>::ValueType;
+
       private:
+        using Access = detail::BitsAccess<StorageType>;
+
+        // per-field access counters, see bitfield_profile.hpp
+        using Profile = detail::FieldCounters<EnumType, Sizes>;
+
+        struct RawBits { };
+
+        // Position of field X; instantiating it rejects out of range enum values.
+        template <EnumType X>
+        struct Field : detail::FieldPos<BitFields, AsInt<X>::value>
+        {
+            static_assert(sizeof(AsEnum<AsInt<X>::value>) != 0, "Invalid field.");
+        };
+
         StorageType m_bits;
 
-        static const StorageType ALL_ONES = detail::StorageTypeSelector<NumBits>::max_value;
-        static const StorageType ONE = static_cast<StorageType>(1);
-        static const StorageType ZERO = static_cast<StorageType>(0);
+        static const ValueType ONE = static_cast<ValueType>(1);
+        static const ValueType ZERO = static_cast<ValueType>(0);
+
+        constexpr BitFields(StorageType bits, RawBits) : m_bits(bits) { }
+
       public:
-        BitFields() : m_bits(ZERO) { }
+        constexpr BitFields() : m_bits() { }
 
-        ~BitFields() { }
+        constexpr StorageType bits() const
+        {
+            return m_bits;
+        }
 
-        BitFields(const BitFields & rhs) : m_bits(rhs.m_bits) { }
+        static constexpr BitFields fromBits(StorageType bits)
+        {
+            return CPPBITFIELD_CONSTEXPR_ASSERT("Bits set outside of the declared fields." &&
+                                                Access::template fits<NumBits>(bits)),
+                   BitFields(bits, RawBits());
+        }
 
-        BitFields & operator=(const BitFields & rhs)
+        /**
+         * Builds a record from (field, value) pairs, e.g.
+         * `Foo::make(FooEnum::A, 1, FooEnum::B, 2)`. Fields not named are zero
+         * and a field named twice keeps the later value. Usable in constant
+         * expressions, so tables of records can be constexpr.
+         */
+        template <class... Args>
+        static constexpr BitFields make(Args... args)
         {
-            m_bits = rhs.m_bits;
-            return *this;
+            static_assert(sizeof...(Args) % 2 == 0, "Expected (field, value) pairs.");
+            return BitFields().withFields(args...);
         }
 
 #if defined(__clang__)
@@ -221,31 +815,22 @@ namespace cppbitfield {
 #  pragma clang diagnostic ignored "-Wconstant-conversion"
 #endif
 
-        template <EnumType X, class Y = StorageType>
-        Y get() const
+        template <EnumType X, class Y = ValueType>
+        constexpr Y get() const
         {
-            static const IntType asInt = AsInt<X>::value;
-            // validate enum value
-            static_cast<void>(AsEnum<asInt>::value); 
-            static const int offset = FieldOffset<asInt>::value;
-            static const int length = FieldLength<asInt>::value;
-            static const StorageType mask = ~((ALL_ONES) << length);
-            return static_cast<Y>((m_bits >> offset) & mask);
+            return static_cast<void>(Profile::read(AsInt<X>::value)),
+                   static_cast<Y>(Access::template get<Field<X>::offset, Field<X>::length>(m_bits));
         }
 
         template <EnumType X, class Y>
         void set(Y val)
         {
-            static const IntType asInt = AsInt<X>::value;
-            // validate enum value
-            static_cast<void>(AsEnum<asInt>::value);
-            static const int offset = FieldOffset<asInt>::value;
-            static const int length = FieldLength<asInt>::value;
-            static const StorageType mask = ~((ALL_ONES) << length);
-            auto valtrunc = static_cast<StorageType>(val) & mask;
+            const ValueType mask = detail::LowMask<ValueType, Field<X>::length>::value;
+            auto valtrunc = static_cast<ValueType>(static_cast<ValueType>(val) & mask);
             CPPBITFIELD_ASSERT("Value too large for bitfield length." &&
-                               (static_cast<StorageType>(val) == valtrunc));
-            m_bits = (m_bits & ~(mask << offset)) | (valtrunc << offset);
+                               (static_cast<ValueType>(val) == valtrunc));
+            Profile::write(AsInt<X>::value);
+            Access::template set<Field<X>::offset, Field<X>::length>(m_bits, valtrunc);
         }
 
 #if defined(__clang__)
@@ -257,6 +842,98 @@ namespace cppbitfield {
         {
             set<X>(val ? ONE : ZERO);
         }
+
+        /**
+         * Value returning counterpart of set: a copy of this record with field
+         * X replaced, usable in constant expressions.
+         */
+        template <EnumType X, class Y>
+        constexpr BitFields with(Y val) const
+        {
+            return CPPBITFIELD_CONSTEXPR_ASSERT("Value too large for bitfield length." &&
+                                                detail::fitsLength(static_cast<uint64_t>(val), Field<X>::length)),
+                   BitFields(Access::put(m_bits, Field<X>::offset, Field<X>::length, static_cast<uint64_t>(val)), RawBits());
+        }
+
+        template <EnumType X>
+        constexpr BitFields with(bool val) const
+        {
+            return with<X>(val ? ONE : ZERO);
+        }
+
+      private:
+        template <EnumType X>
+        struct FieldValue
+        {
+            using type = ValueType;
+        };
+
+      public:
+        /**
+         * Reads several fields from one snapshot of the storage.
+         */
+        template <EnumType X0, EnumType X1, EnumType... Xs>
+        std::tuple<ValueType, ValueType, typename FieldValue<Xs>::type...> get() const
+        {
+            const StorageType bits = m_bits;
+            return std::make_tuple(fieldOf<X0>(bits), fieldOf<X1>(bits), fieldOf<Xs>(bits)...);
+        }
+
+        /**
+         * Writes several fields at once. For single-word storage the combined
+         * mask is a compile-time constant and the write is one AND-OR-store.
+         */
+        template <EnumType X0, EnumType X1, EnumType... Xs, class... Ys>
+        void set(Ys... vals)
+        {
+            static_assert(sizeof...(Ys) == 2 + sizeof...(Xs), "One value is required per field.");
+            setFields<X0, X1, Xs...>(std::integral_constant<bool, (NumBits > 64)>(), vals...);
+        }
+
+      private:
+        template <EnumType X>
+        static ValueType fieldOf(const StorageType & bits)
+        {
+            Profile::read(AsInt<X>::value);
+            return Access::template get<Field<X>::offset, Field<X>::length>(bits);
+        }
+
+        constexpr BitFields withFields() const
+        {
+            return *this;
+        }
+
+        template <class Y, class... Args>
+        constexpr BitFields withFields(EnumType x, Y val, Args... args) const
+        {
+            return withField(static_cast<IntType>(x), static_cast<uint64_t>(val)).withFields(args...);
+        }
+
+        constexpr BitFields withField(IntType idx, uint64_t val) const
+        {
+            return CPPBITFIELD_CONSTEXPR_ASSERT("Integer value must be a valid enum value." &&
+                                                idx >= 0 && idx < NumFields),
+                   CPPBITFIELD_CONSTEXPR_ASSERT("Value too large for bitfield length." &&
+                                                detail::fitsLength(val, Sizes::length(idx))),
+                   BitFields(Access::put(m_bits, Sizes::offset(idx), Sizes::length(idx), val), RawBits());
+        }
+
+        template <EnumType... Xs, class... Ys>
+        void setFields(std::false_type, Ys... vals)
+        {
+            static const StorageType mask = detail::FieldsMask<BitFields, Xs...>::value;
+            const int counted[] = { (Profile::write(AsInt<Xs>::value), 0)... };
+            static_cast<void>(counted);
+            m_bits = static_cast<StorageType>((m_bits & ~mask) | detail::packFields<BitFields, Xs...>(vals...));
+        }
+
+        template <EnumType... Xs, class... Ys>
+        void setFields(std::true_type, Ys... vals)
+        {
+            // every field of a multi-word record is already a fixed word access
+            const int expand[] = { (set<Xs>(vals), 0)... };
+            static_cast<void>(expand);
+        }
     };
 
 } // namespace cppbitfield
@@ -275,6 +952,9 @@ namespace cppbitfield {
 #define DEFINE_BITFIELD_SIZES(X, ...) \
     using X = cppbitfield::BitFieldSizes<__VA_ARGS__>
 
+#define DEFINE_BITFIELD_LAYOUT(X, O, ...) \
+    using X = cppbitfield::BitFieldLayout<cppbitfield::O, cppbitfield::BitFieldSizes<__VA_ARGS__> >
+
 #define DEFINE_BITFIELDS(N, X, Y) \
     using N = cppbitfield::BitFields<X, Y>
 
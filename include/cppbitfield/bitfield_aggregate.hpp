@@ -0,0 +1,349 @@
+/**
+ * \file bitfield_aggregate.hpp
+ * \date Oct 16, 2026
+ */
+
+#ifndef CPPBITFIELD_BITFIELD_AGGREGATE_HPP
+#define CPPBITFIELD_BITFIELD_AGGREGATE_HPP
+
+#include <cppbitfield/bitfield_parallel.hpp>
+#include <cppbitfield/bitfield_simd.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace cppbitfield {
+
+    namespace detail {
+
+        // Records per kernel call: small enough that 32-bit lane counters
+        // cannot wrap, large enough that folding them costs nothing.
+        static const std::size_t AGGREGATE_BLOCK = static_cast<std::size_t>(1) << 20;
+
+        // Fields up to this length are summed in 32-bit lanes for a whole
+        // block: AGGREGATE_BLOCK / 4 values below 2^12 stay below 2^32.
+        static const int AGGREGATE_NARROW_SUM = 12;
+
+#if defined(CPPBITFIELD_HAS_SIMD)
+
+        namespace sse2 {
+
+#  define CPPBITFIELD_SIMD_FN inline CPPBITFIELD_TARGET("sse2")
+#  include <cppbitfield/detail/aggregate_kernels.inl>
+#  undef CPPBITFIELD_SIMD_FN
+
+        } // namespace sse2
+
+        namespace avx2 {
+
+#  define CPPBITFIELD_SIMD_FN inline CPPBITFIELD_TARGET("avx2")
+#  include <cppbitfield/detail/aggregate_kernels.inl>
+#  undef CPPBITFIELD_SIMD_FN
+
+        } // namespace avx2
+
+#  if defined(__GNUC__) && !defined(__clang__)
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#    pragma GCC diagnostic ignored "-Wuninitialized"
+#  endif
+
+        namespace avx512 {
+
+#  define CPPBITFIELD_SIMD_FN inline CPPBITFIELD_TARGET("avx512f")
+#  include <cppbitfield/detail/aggregate_kernels.inl>
+#  undef CPPBITFIELD_SIMD_FN
+
+        } // namespace avx512
+
+#  if defined(__GNUC__) && !defined(__clang__)
+#    pragma GCC diagnostic pop
+#  endif
+
+#endif/*defined(CPPBITFIELD_HAS_SIMD)*/
+
+        // Kernel dispatch for one field; fields wider than 32 bits (64-bit
+        // storage only) have no vector kernels and report nothing done.
+        template <int Offset, int Length, bool Vector = (Length <= 32)>
+        struct AggregateKernels
+        {
+            template <class T>
+            static std::size_t sum(const T * in, std::size_t n, uint64_t & total, SimdLevel level)
+            {
+                switch (level) {
+#if defined(CPPBITFIELD_HAS_SIMD)
+                  case SimdLevel::Avx512:
+                    return avx512::sumField<Offset, Length>(in, n, total);
+                  case SimdLevel::Avx2:
+                    return avx2::sumField<Offset, Length>(in, n, total);
+                  case SimdLevel::Sse2:
+                    return sse2::sumField<Offset, Length>(in, n, total);
+#endif
+                  default:
+                    return 0;
+                }
+            }
+
+            template <class T>
+            static std::size_t minmax(const T * in, std::size_t n, uint64_t & lo, uint64_t & hi, SimdLevel level)
+            {
+                uint32_t lo32 = static_cast<uint32_t>(lo), hi32 = static_cast<uint32_t>(hi);
+                std::size_t done = 0;
+                switch (level) {
+#if defined(CPPBITFIELD_HAS_SIMD)
+                  case SimdLevel::Avx512:
+                    done = avx512::minmaxField<Offset, Length>(in, n, lo32, hi32);
+                    break;
+                  case SimdLevel::Avx2:
+                    done = avx2::minmaxField<Offset, Length>(in, n, lo32, hi32);
+                    break;
+                  case SimdLevel::Sse2:
+                    done = sse2::minmaxField<Offset, Length>(in, n, lo32, hi32);
+                    break;
+#endif
+                  default:
+                    break;
+                }
+                lo = lo32;
+                hi = hi32;
+                return done;
+            }
+
+            template <class T>
+            static std::size_t count(const T * in, std::size_t n, uint64_t value, uint64_t & total, SimdLevel level)
+            {
+                switch (level) {
+#if defined(CPPBITFIELD_HAS_SIMD)
+                  case SimdLevel::Avx512:
+                    return avx512::countField<Offset, Length>(in, n, static_cast<uint32_t>(value), total);
+                  case SimdLevel::Avx2:
+                    return avx2::countField<Offset, Length>(in, n, static_cast<uint32_t>(value), total);
+                  case SimdLevel::Sse2:
+                    return sse2::countField<Offset, Length>(in, n, static_cast<uint32_t>(value), total);
+#endif
+                  default:
+                    static_cast<void>(value);
+                    return 0;
+                }
+            }
+
+            // `sub` holds (1 << Length) * 16 zeroed counters for Length <= 8
+            template <class T>
+            static std::size_t histogram(const T * in, std::size_t n, uint32_t * sub, uint64_t * counts, SimdLevel level)
+            {
+                const bool lanes = Length <= 8;
+                switch (level) {
+#if defined(CPPBITFIELD_HAS_SIMD)
+                  case SimdLevel::Avx512:
+                    return lanes ? avx512::histogramLanes<Offset, Length>(in, n, sub, counts) :
+                                   avx512::histogramField<Offset, Length>(in, n, counts);
+                  case SimdLevel::Avx2:
+                    return lanes ? avx2::histogramLanes<Offset, Length>(in, n, sub, counts) :
+                                   avx2::histogramField<Offset, Length>(in, n, counts);
+                  case SimdLevel::Sse2:
+                    return lanes ? sse2::histogramLanes<Offset, Length>(in, n, sub, counts) :
+                                   sse2::histogramField<Offset, Length>(in, n, counts);
+#endif
+                  default:
+                    static_cast<void>(lanes);
+                    return 0;
+                }
+            }
+        };
+
+        template <int Offset, int Length>
+        struct AggregateKernels<Offset, Length, false>
+        {
+            template <class T>
+            static std::size_t sum(const T *, std::size_t, uint64_t &, SimdLevel) { return 0; }
+
+            template <class T>
+            static std::size_t minmax(const T *, std::size_t, uint64_t &, uint64_t &, SimdLevel) { return 0; }
+
+            template <class T>
+            static std::size_t count(const T *, std::size_t, uint64_t, uint64_t &, SimdLevel) { return 0; }
+        };
+
+        template <class Record, typename Record::FieldEnum X>
+        struct FieldAggregate
+        {
+            using StorageType = typename Record::StorageType;
+            using F = FieldPos<Record, Record::template AsInt<X>::value>;
+            using Kernels = AggregateKernels<F::offset, F::length>;
+
+            static_assert(Record::NumBits <= 64, "Aggregation requires single word storage.");
+            static_assert(sizeof(Record) == sizeof(StorageType), "Records must be tightly packed.");
+
+            static uint64_t value(StorageType bits)
+            {
+                return static_cast<uint64_t>(bits >> F::offset) & LowMask<uint64_t, F::length>::value;
+            }
+
+            static uint64_t sum(const StorageType * in, std::size_t n, SimdLevel level)
+            {
+                uint64_t total = 0;
+                for (std::size_t base = 0; base < n; base += AGGREGATE_BLOCK) {
+                    const std::size_t len = std::min(n - base, AGGREGATE_BLOCK);
+                    for (std::size_t i = Kernels::sum(in + base, len, total, level); i < len; ++i) {
+                        total += value(in[base + i]);
+                    }
+                }
+                return total;
+            }
+
+            static void minmax(const StorageType * in, std::size_t n, uint64_t & lo, uint64_t & hi, SimdLevel level)
+            {
+                for (std::size_t base = 0; base < n; base += AGGREGATE_BLOCK) {
+                    const std::size_t len = std::min(n - base, AGGREGATE_BLOCK);
+                    for (std::size_t i = Kernels::minmax(in + base, len, lo, hi, level); i < len; ++i) {
+                        const uint64_t v = value(in[base + i]);
+                        lo = std::min(lo, v);
+                        hi = std::max(hi, v);
+                    }
+                }
+            }
+
+            static uint64_t count(const StorageType * in, std::size_t n, uint64_t val, SimdLevel level)
+            {
+                uint64_t total = 0;
+                for (std::size_t base = 0; base < n; base += AGGREGATE_BLOCK) {
+                    const std::size_t len = std::min(n - base, AGGREGATE_BLOCK);
+                    for (std::size_t i = Kernels::count(in + base, len, val, total, level); i < len; ++i) {
+                        total += value(in[base + i]) == val ? 1 : 0;
+                    }
+                }
+                return total;
+            }
+
+            // adds to counts[0 .. 1 << length)
+            static void histogram(const StorageType * in, std::size_t n, uint64_t * counts, SimdLevel level)
+            {
+                static const std::size_t NumValues = static_cast<std::size_t>(1) << F::length;
+                std::vector<uint32_t> sub(F::length <= 8 ? NumValues * 16 : 0);
+                for (std::size_t base = 0; base < n; base += AGGREGATE_BLOCK) {
+                    const std::size_t len = std::min(n - base, AGGREGATE_BLOCK);
+                    std::fill(sub.begin(), sub.end(), 0);
+                    std::size_t i = Kernels::histogram(in + base, len, sub.data(), counts, level);
+                    if (i == 0 && F::length <= 8) {
+                        // four scalar sub-histograms for the same reason as the lanes
+                        for (; i + 4 <= len; i += 4) {
+                            for (std::size_t j = 0; j < 4; ++j) {
+                                ++sub[value(in[base + i + j]) * 4 + j];
+                            }
+                        }
+                        for (std::size_t v = 0; v < NumValues; ++v) {
+                            counts[v] += sub[4 * v] + sub[4 * v + 1] + sub[4 * v + 2] + sub[4 * v + 3];
+                        }
+                    }
+                    for (; i < len; ++i) {
+                        ++counts[value(in[base + i])];
+                    }
+                }
+            }
+        };
+
+    } // namespace detail
+
+    /**
+     * Sum of field X over recs[0 .. n), modulo 2^64. Fields of up to 32
+     * bits are summed with the widest SIMD level allowed, in 32-bit lanes
+     * while they cannot overflow. `threads` splits large inputs (0: one per
+     * hardware thread) and adds the partial sums.
+     */
+    template <class Record, typename Record::FieldEnum X>
+    uint64_t sum(const Record * recs, std::size_t n, SimdLevel level = simdLevel(), unsigned threads = 1)
+    {
+        using Agg = detail::FieldAggregate<Record, X>;
+        const typename Agg::StorageType * in = reinterpret_cast<const typename Agg::StorageType *>(recs);
+        level = detail::clampSimdLevel(level);
+        const std::vector<uint64_t> parts = detail::forEachSlice(n, threads, uint64_t(0),
+            [in, level](std::size_t begin, std::size_t end, uint64_t & part) {
+                part = Agg::sum(in + begin, end - begin, level);
+            });
+        uint64_t total = 0;
+        for (std::size_t t = 0; t < parts.size(); ++t) {
+            total += parts[t];
+        }
+        return total;
+    }
+
+    /**
+     * Smallest and largest value of field X over recs[0 .. n), n > 0.
+     */
+    template <class Record, typename Record::FieldEnum X>
+    std::pair<typename Record::ValueType, typename Record::ValueType>
+    minmax(const Record * recs, std::size_t n, SimdLevel level = simdLevel(), unsigned threads = 1)
+    {
+        using Agg = detail::FieldAggregate<Record, X>;
+        using ValueType = typename Record::ValueType;
+        CPPBITFIELD_ASSERT("No records to take the minimum of." && (n > 0));
+        const typename Agg::StorageType * in = reinterpret_cast<const typename Agg::StorageType *>(recs);
+        level = detail::clampSimdLevel(level);
+        const std::pair<uint64_t, uint64_t> init(detail::LowMask<uint64_t, Agg::F::length>::value, 0);
+        const std::vector<std::pair<uint64_t, uint64_t> > parts = detail::forEachSlice(n, threads, init,
+            [in, level](std::size_t begin, std::size_t end, std::pair<uint64_t, uint64_t> & part) {
+                Agg::minmax(in + begin, end - begin, part.first, part.second, level);
+            });
+        std::pair<uint64_t, uint64_t> ret = init;
+        for (std::size_t t = 0; t < parts.size(); ++t) {
+            ret.first = std::min(ret.first, parts[t].first);
+            ret.second = std::max(ret.second, parts[t].second);
+        }
+        return std::make_pair(static_cast<ValueType>(ret.first), static_cast<ValueType>(ret.second));
+    }
+
+    /**
+     * Number of records of recs[0 .. n) whose field X equals `value`.
+     */
+    template <class Record, typename Record::FieldEnum X>
+    std::size_t count(const Record * recs, std::size_t n, uint64_t value, SimdLevel level = simdLevel(), unsigned threads = 1)
+    {
+        using Agg = detail::FieldAggregate<Record, X>;
+        if (value > detail::LowMask<uint64_t, Agg::F::length>::value) {
+            return 0;
+        }
+        const typename Agg::StorageType * in = reinterpret_cast<const typename Agg::StorageType *>(recs);
+        level = detail::clampSimdLevel(level);
+        const std::vector<uint64_t> parts = detail::forEachSlice(n, threads, uint64_t(0),
+            [in, value, level](std::size_t begin, std::size_t end, uint64_t & part) {
+                part = Agg::count(in + begin, end - begin, value, level);
+            });
+        uint64_t total = 0;
+        for (std::size_t t = 0; t < parts.size(); ++t) {
+            total += parts[t];
+        }
+        return static_cast<std::size_t>(total);
+    }
+
+    /**
+     * Value histogram of field X over recs[0 .. n): counts[v] is set to the
+     * number of records whose field equals v, for every v below
+     * 2^FieldLength. Fields of up to 8 bits count into one sub-histogram per
+     * SIMD lane, so equal neighbouring values never contend for a counter;
+     * each thread keeps its own histogram and they are added at the end.
+     */
+    template <class Record, typename Record::FieldEnum X>
+    void histogram(const Record * recs, std::size_t n, uint64_t * counts, SimdLevel level = simdLevel(), unsigned threads = 1)
+    {
+        using Agg = detail::FieldAggregate<Record, X>;
+        static_assert(Agg::F::length <= 16, "Histograms need a field of at most 16 bits.");
+        static const std::size_t NumValues = static_cast<std::size_t>(1) << Agg::F::length;
+        const typename Agg::StorageType * in = reinterpret_cast<const typename Agg::StorageType *>(recs);
+        level = detail::clampSimdLevel(level);
+        const std::vector<std::vector<uint64_t> > parts = detail::forEachSlice(n, threads, std::vector<uint64_t>(NumValues, 0),
+            [in, level](std::size_t begin, std::size_t end, std::vector<uint64_t> & part) {
+                Agg::histogram(in + begin, end - begin, part.data(), level);
+            });
+        std::fill(counts, counts + NumValues, 0);
+        for (std::size_t t = 0; t < parts.size(); ++t) {
+            for (std::size_t v = 0; v < NumValues; ++v) {
+                counts[v] += parts[t][v];
+            }
+        }
+    }
+
+} // namespace cppbitfield
+
+#endif/*CPPBITFIELD_BITFIELD_AGGREGATE_HPP*/
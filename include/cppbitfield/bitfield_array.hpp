@@ -0,0 +1,355 @@
+/**
+ * \file bitfield_array.hpp
+ * \date Oct 16, 2026
+ */
+
+#ifndef CPPBITFIELD_BITFIELD_ARRAY_HPP
+#define CPPBITFIELD_BITFIELD_ARRAY_HPP
+
+#include <cppbitfield/bitfield.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace cppbitfield {
+
+    namespace detail {
+
+        inline uint64_t wordsForBits(uint64_t numBits)
+        {
+            return (numBits + 63) >> 6;
+        }
+
+        // Reads `Length` bits starting at absolute bit `pos`. The second word is
+        // the same as the first unless the value straddles a word boundary, so
+        // the funnel shift below never needs a branch and never reads past the
+        // last word holding live bits.
+        template <int Length>
+        inline uint64_t loadBits(const uint64_t * words, uint64_t pos)
+        {
+            const uint64_t * lo = words + (pos >> 6);
+            const unsigned shift = static_cast<unsigned>(pos & 63);
+            const uint64_t * hi = lo + ((shift + Length - 1) >> 6);
+            const uint64_t val = (*lo >> shift) | ((*hi << 1) << (63 - shift));
+            return val & LowMask<uint64_t, Length>::value;
+        }
+
+        template <int Length>
+        inline void storeBits(uint64_t * words, uint64_t pos, uint64_t val)
+        {
+            static const uint64_t mask = LowMask<uint64_t, Length>::value;
+            uint64_t * lo = words + (pos >> 6);
+            const unsigned shift = static_cast<unsigned>(pos & 63);
+            uint64_t * hi = lo + ((shift + Length - 1) >> 6);
+            *lo = (*lo & ~(mask << shift)) | (val << shift);
+            // both masks below are zero unless the value straddles the boundary
+            *hi = (*hi & ~((mask >> 1) >> (63 - shift))) | ((val >> 1) >> (63 - shift));
+        }
+
+        /**
+         * `Length` bits at bit `pos`, where the field starts on a byte
+         * boundary of every record (ByteAligned, with a whole number of bytes
+         * per record). On little-endian hosts the words are plain bytes in
+         * bit order, so such a field is a narrow load or store at byte
+         * pos / 8; big-endian hosts keep the funnel.
+         */
+        template <int Length, bool Narrow = !HOST_BIG_ENDIAN>
+        struct PackedBits
+        {
+            static uint64_t load(const uint64_t * words, uint64_t pos)
+            {
+                return loadNarrow<Length>(reinterpret_cast<const unsigned char *>(words) + (pos >> 3));
+            }
+
+            static void store(uint64_t * words, uint64_t pos, uint64_t val)
+            {
+                storeNarrow<Length>(reinterpret_cast<unsigned char *>(words) + (pos >> 3), val);
+            }
+        };
+
+        template <int Length>
+        struct PackedBits<Length, false>
+        {
+            static uint64_t load(const uint64_t * words, uint64_t pos)
+            {
+                return loadBits<Length>(words, pos);
+            }
+
+            static void store(uint64_t * words, uint64_t pos, uint64_t val)
+            {
+                storeBits<Length>(words, pos, val);
+            }
+        };
+
+        // Field `Length` bits at `Offset` of records `NumBits` apart.
+        template <int NumBits, int Offset, int Length>
+        struct ArrayField : PackedBits<Length, NumBits % 8 == 0 && ByteAligned<Offset, Length>::value && !HOST_BIG_ENDIAN> { };
+
+        // Whole record transfer: a single funnel for integer storage (a
+        // narrow access for 8, 16, 32 and 64-bit records), one per word for
+        // multi-word storage.
+        template <class StorageType, int NumBits>
+        struct RecordBits
+        {
+            static StorageType load(const uint64_t * words, uint64_t pos)
+            {
+                return static_cast<StorageType>(ArrayField<NumBits, 0, NumBits>::load(words, pos));
+            }
+
+            static void store(uint64_t * words, uint64_t pos, StorageType bits)
+            {
+                ArrayField<NumBits, 0, NumBits>::store(words, pos, static_cast<uint64_t>(bits));
+            }
+        };
+
+        template <int NumWords, int NumBits>
+        struct RecordBits<WordArray<NumWords>, NumBits>
+        {
+            static const int TailBits = NumBits - 64 * (NumWords - 1);
+
+            static WordArray<NumWords> load(const uint64_t * words, uint64_t pos)
+            {
+                WordArray<NumWords> ret;
+                for (int w = 0; w < NumWords - 1; ++w) {
+                    ret.words[w] = loadBits<64>(words, pos + 64 * w);
+                }
+                ret.words[NumWords - 1] = loadBits<TailBits>(words, pos + 64 * (NumWords - 1));
+                return ret;
+            }
+
+            static void store(uint64_t * words, uint64_t pos, const WordArray<NumWords> & bits)
+            {
+                for (int w = 0; w < NumWords - 1; ++w) {
+                    storeBits<64>(words, pos + 64 * w, bits.words[w]);
+                }
+                storeBits<TailBits>(words, pos + 64 * (NumWords - 1), bits.words[NumWords - 1]);
+            }
+        };
+
+    } // namespace detail
+
+    template <class EnumType, class Sizes>
+    class BitFieldArray
+    {
+      public:
+        using value_type = BitFields<EnumType, Sizes>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using StorageType = typename value_type::StorageType;
+        using ValueType = typename value_type::ValueType;
+
+        static const int NumBits = value_type::NumBits;
+
+        template <EnumType X>
+        using Field = detail::FieldPos<value_type, value_type::template AsInt<X>::value>;
+
+        class reference
+        {
+          public:
+            template <EnumType X, class Y = ValueType>
+            Y get() const
+            {
+                return m_array->template get<X, Y>(m_index);
+            }
+
+            template <EnumType X, class Y>
+            void set(Y val)
+            {
+                m_array->template set<X>(m_index, val);
+            }
+
+            template <EnumType X>
+            void set(bool val)
+            {
+                m_array->template set<X>(m_index, val);
+            }
+
+            operator value_type() const
+            {
+                return m_array->get(m_index);
+            }
+
+            reference & operator=(const value_type & val)
+            {
+                m_array->set(m_index, val);
+                return *this;
+            }
+
+            reference & operator=(const reference & rhs)
+            {
+                m_array->set(m_index, rhs.m_array->get(rhs.m_index));
+                return *this;
+            }
+
+          private:
+            friend class BitFieldArray;
+
+            reference(BitFieldArray * array, size_type index) : m_array(array), m_index(index) { }
+
+            BitFieldArray * m_array;
+            size_type m_index;
+        };
+
+        template <class ArrayType, class Ref>
+        class IteratorBase
+        {
+          public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = typename BitFieldArray::value_type;
+            using difference_type = std::ptrdiff_t;
+            using reference = Ref;
+            using pointer = void;
+
+            IteratorBase() : m_array(nullptr), m_index(0) { }
+
+            IteratorBase(ArrayType * array, size_type index) : m_array(array), m_index(index) { }
+
+            Ref operator*() const { return (*m_array)[m_index]; }
+
+            Ref operator[](difference_type n) const { return (*m_array)[m_index + n]; }
+
+            IteratorBase & operator++() { ++m_index; return *this; }
+            IteratorBase & operator--() { --m_index; return *this; }
+            IteratorBase operator++(int) { IteratorBase tmp(*this); ++m_index; return tmp; }
+            IteratorBase operator--(int) { IteratorBase tmp(*this); --m_index; return tmp; }
+
+            IteratorBase & operator+=(difference_type n) { m_index += n; return *this; }
+            IteratorBase & operator-=(difference_type n) { m_index -= n; return *this; }
+
+            IteratorBase operator+(difference_type n) const { return IteratorBase(m_array, m_index + n); }
+            IteratorBase operator-(difference_type n) const { return IteratorBase(m_array, m_index - n); }
+
+            difference_type operator-(const IteratorBase & rhs) const
+            {
+                return static_cast<difference_type>(m_index) - static_cast<difference_type>(rhs.m_index);
+            }
+
+            bool operator==(const IteratorBase & rhs) const { return m_index == rhs.m_index; }
+            bool operator!=(const IteratorBase & rhs) const { return m_index != rhs.m_index; }
+            bool operator<(const IteratorBase & rhs) const { return m_index < rhs.m_index; }
+            bool operator>(const IteratorBase & rhs) const { return m_index > rhs.m_index; }
+            bool operator<=(const IteratorBase & rhs) const { return m_index <= rhs.m_index; }
+            bool operator>=(const IteratorBase & rhs) const { return m_index >= rhs.m_index; }
+
+            size_type index() const { return m_index; }
+
+          private:
+            ArrayType * m_array;
+            size_type m_index;
+        };
+
+        using iterator = IteratorBase<BitFieldArray, reference>;
+        using const_iterator = IteratorBase<const BitFieldArray, value_type>;
+
+        BitFieldArray() : m_size(0) { }
+
+        explicit BitFieldArray(size_type count)
+          : m_words(detail::wordsForBits(bitPos(count)), 0), m_size(count)
+        { }
+
+        size_type size() const { return m_size; }
+
+        bool empty() const { return m_size == 0; }
+
+        void clear()
+        {
+            m_words.clear();
+            m_size = 0;
+        }
+
+        void resize(size_type count)
+        {
+            m_words.resize(detail::wordsForBits(bitPos(count)), 0);
+            const unsigned tail = static_cast<unsigned>(bitPos(count) & 63);
+            if (count < m_size && tail != 0) {
+                // zero the dropped bits so a later grow hands out default records
+                m_words.back() &= (static_cast<uint64_t>(1) << tail) - 1;
+            }
+            m_size = count;
+        }
+
+        void reserve(size_type count)
+        {
+            m_words.reserve(detail::wordsForBits(bitPos(count)));
+        }
+
+        void push_back(const value_type & val)
+        {
+            resize(m_size + 1);
+            set(m_size - 1, val);
+        }
+
+        template <EnumType X, class Y = ValueType>
+        Y get(size_type i) const
+        {
+            CPPBITFIELD_ASSERT("Index out of bounds." && (i < m_size));
+            return static_cast<Y>(FieldBits<X>::load(m_words.data(), bitPos(i) + Field<X>::offset));
+        }
+
+        template <EnumType X, class Y>
+        void set(size_type i, Y val)
+        {
+            CPPBITFIELD_ASSERT("Index out of bounds." && (i < m_size));
+            auto valtrunc = static_cast<uint64_t>(val) & detail::LowMask<uint64_t, Field<X>::length>::value;
+            CPPBITFIELD_ASSERT("Value too large for bitfield length." &&
+                               (static_cast<uint64_t>(val) == valtrunc));
+            FieldBits<X>::store(m_words.data(), bitPos(i) + Field<X>::offset, valtrunc);
+        }
+
+        template <EnumType X>
+        void set(size_type i, bool val)
+        {
+            set<X>(i, static_cast<uint64_t>(val ? 1 : 0));
+        }
+
+        value_type get(size_type i) const
+        {
+            CPPBITFIELD_ASSERT("Index out of bounds." && (i < m_size));
+            return value_type::fromBits(detail::RecordBits<StorageType, NumBits>::load(m_words.data(), bitPos(i)));
+        }
+
+        void set(size_type i, const value_type & val)
+        {
+            CPPBITFIELD_ASSERT("Index out of bounds." && (i < m_size));
+            detail::RecordBits<StorageType, NumBits>::store(m_words.data(), bitPos(i), val.bits());
+        }
+
+        reference operator[](size_type i) { return reference(this, i); }
+
+        value_type operator[](size_type i) const { return get(i); }
+
+        iterator begin() { return iterator(this, 0); }
+        iterator end() { return iterator(this, m_size); }
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, m_size); }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+
+        const uint64_t * words() const { return m_words.data(); }
+
+        uint64_t * words() { return m_words.data(); }
+
+        size_type numWords() const { return m_words.size(); }
+
+        size_type sizeInBytes() const { return m_words.size() * sizeof(uint64_t); }
+
+      private:
+        template <EnumType X>
+        using FieldBits = detail::ArrayField<NumBits, Field<X>::offset, Field<X>::length>;
+
+        static uint64_t bitPos(size_type i)
+        {
+            return static_cast<uint64_t>(i) * NumBits;
+        }
+
+        std::vector<uint64_t> m_words;
+        size_type m_size;
+    };
+
+} // namespace cppbitfield
+
+#define DEFINE_BITFIELD_ARRAY(N, X, Y) \
+    using N = cppbitfield::BitFieldArray<X, Y>
+
+#endif/*CPPBITFIELD_BITFIELD_ARRAY_HPP*/
@@ -0,0 +1,207 @@
+/**
+ * \file bitfield_atomic.hpp
+ * \date Oct 16, 2026
+ */
+
+#ifndef CPPBITFIELD_BITFIELD_ATOMIC_HPP
+#define CPPBITFIELD_BITFIELD_ATOMIC_HPP
+
+#include <cppbitfield/bitfield.hpp>
+
+#include <atomic>
+
+namespace cppbitfield {
+
+    namespace detail {
+
+        // Strongest order allowed for the failure path of a compare-exchange.
+        inline std::memory_order failureOrder(std::memory_order order)
+        {
+            return order == std::memory_order_acq_rel ? std::memory_order_acquire :
+                   order == std::memory_order_release ? std::memory_order_relaxed :
+                   order;
+        }
+
+    } // namespace detail
+
+    /**
+     * BitFields record shared between threads. Every operation is a single
+     * atomic load/store or a compare-exchange loop on the whole word, so
+     * concurrent updates to different fields never lose each other.
+     */
+    template <class EnumType, class Sizes>
+    class AtomicBitFields
+    {
+      public:
+        using value_type = BitFields<EnumType, Sizes>;
+        using StorageType = typename value_type::StorageType;
+        using ValueType = typename value_type::ValueType;
+
+        static_assert(value_type::NumBits <= 64, "Atomic access requires single word storage.");
+
+        template <EnumType X>
+        using Field = detail::FieldPos<value_type, value_type::template AsInt<X>::value>;
+
+        AtomicBitFields() : m_bits(0) { }
+
+        explicit AtomicBitFields(const value_type & val) : m_bits(val.bits()) { }
+
+        AtomicBitFields(const AtomicBitFields &) = delete;
+        AtomicBitFields & operator=(const AtomicBitFields &) = delete;
+
+        bool is_lock_free() const
+        {
+            return m_bits.is_lock_free();
+        }
+
+        value_type load(std::memory_order order = std::memory_order_seq_cst) const
+        {
+            return value_type::fromBits(m_bits.load(order));
+        }
+
+        void store(const value_type & val, std::memory_order order = std::memory_order_seq_cst)
+        {
+            m_bits.store(val.bits(), order);
+        }
+
+        template <EnumType X, class Y = ValueType>
+        Y load(std::memory_order order = std::memory_order_seq_cst) const
+        {
+            return static_cast<Y>(Access::template get<Field<X>::offset, Field<X>::length>(m_bits.load(order)));
+        }
+
+        template <EnumType X, class Y>
+        void store(Y val, std::memory_order order = std::memory_order_seq_cst)
+        {
+            update_explicit<X>(order, val);
+        }
+
+        template <EnumType X>
+        void store(bool val, std::memory_order order = std::memory_order_seq_cst)
+        {
+            update_explicit<X>(order, static_cast<ValueType>(val ? 1 : 0));
+        }
+
+        /**
+         * Replaces field X with `desired` if it currently holds `expected`.
+         * On failure `expected` receives the current field value. Changes to
+         * other fields in the meantime do not cause a spurious failure.
+         */
+        template <EnumType X>
+        bool compare_exchange(ValueType & expected, ValueType desired,
+                              std::memory_order order = std::memory_order_seq_cst)
+        {
+            const StorageType insert = detail::packFields<value_type, X>(desired);
+            StorageType old = m_bits.load(detail::failureOrder(order));
+            for (;;) {
+                const ValueType cur = Access::template get<Field<X>::offset, Field<X>::length>(old);
+                if (cur != expected) {
+                    expected = cur;
+                    return false;
+                }
+                const StorageType next = static_cast<StorageType>((old & ~Mask<X>::value) | insert);
+                if (m_bits.compare_exchange_weak(old, next, order, detail::failureOrder(order))) {
+                    return true;
+                }
+            }
+        }
+
+        /**
+         * Adds `delta` to field X unless the sum would not fit in the field.
+         * `previous` always receives the value the decision was based on;
+         * returns false, leaving the record untouched, on overflow.
+         */
+        template <EnumType X>
+        bool fetch_add(ValueType delta, ValueType & previous,
+                       std::memory_order order = std::memory_order_seq_cst)
+        {
+            static const ValueType max = detail::LowMask<ValueType, Field<X>::length>::value;
+            StorageType old = m_bits.load(detail::failureOrder(order));
+            for (;;) {
+                previous = Access::template get<Field<X>::offset, Field<X>::length>(old);
+                if (delta > static_cast<ValueType>(max - previous)) {
+                    return false;
+                }
+                // cannot carry out of the field, so a plain add is exact
+                const StorageType next = static_cast<StorageType>(old + (static_cast<StorageType>(delta) << Field<X>::offset));
+                if (m_bits.compare_exchange_weak(old, next, order, detail::failureOrder(order))) {
+                    return true;
+                }
+            }
+        }
+
+        /**
+         * Subtracts `delta` from field X unless that would go below zero.
+         * Same contract as fetch_add.
+         */
+        template <EnumType X>
+        bool fetch_sub(ValueType delta, ValueType & previous,
+                       std::memory_order order = std::memory_order_seq_cst)
+        {
+            StorageType old = m_bits.load(detail::failureOrder(order));
+            for (;;) {
+                previous = Access::template get<Field<X>::offset, Field<X>::length>(old);
+                if (delta > previous) {
+                    return false;
+                }
+                const StorageType next = static_cast<StorageType>(old - (static_cast<StorageType>(delta) << Field<X>::offset));
+                if (m_bits.compare_exchange_weak(old, next, order, detail::failureOrder(order))) {
+                    return true;
+                }
+            }
+        }
+
+        /**
+         * Writes the fields Xs... in one compare-exchange loop, so other
+         * threads observe either none or all of the new values.
+         */
+        template <EnumType... Xs, class... Ys>
+        void update(Ys... vals)
+        {
+            update_explicit<Xs...>(std::memory_order_seq_cst, vals...);
+        }
+
+        template <EnumType... Xs, class... Ys>
+        void update_explicit(std::memory_order order, Ys... vals)
+        {
+            static_assert(sizeof...(Xs) == sizeof...(Ys), "One value is required per field.");
+            const StorageType insert = detail::packFields<value_type, Xs...>(vals...);
+            StorageType old = m_bits.load(detail::failureOrder(order));
+            while (!m_bits.compare_exchange_weak(old, static_cast<StorageType>((old & ~Mask<Xs...>::value) | insert),
+                                                 order, detail::failureOrder(order))) {
+            }
+        }
+
+        /**
+         * Applies `f(value_type &)` to a snapshot and publishes the result,
+         * retrying until no other thread raced with the update. Returns the
+         * value that was stored. `f` may run more than once.
+         */
+        template <class F>
+        value_type modify(F f, std::memory_order order = std::memory_order_seq_cst)
+        {
+            StorageType old = m_bits.load(detail::failureOrder(order));
+            for (;;) {
+                value_type next = value_type::fromBits(old);
+                f(next);
+                if (m_bits.compare_exchange_weak(old, next.bits(), order, detail::failureOrder(order))) {
+                    return next;
+                }
+            }
+        }
+
+      private:
+        using Access = detail::BitsAccess<StorageType>;
+
+        template <EnumType... Xs>
+        using Mask = detail::FieldsMask<value_type, Xs...>;
+
+        std::atomic<StorageType> m_bits;
+    };
+
+} // namespace cppbitfield
+
+#define DEFINE_ATOMIC_BITFIELDS(N, X, Y) \
+    using N = cppbitfield::AtomicBitFields<X, Y>
+
+#endif/*CPPBITFIELD_BITFIELD_ATOMIC_HPP*/
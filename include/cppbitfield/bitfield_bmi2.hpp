@@ -0,0 +1,364 @@
+/**
+ * \file bitfield_bmi2.hpp
+ * \date Oct 16, 2026
+ */
+
+#ifndef CPPBITFIELD_BITFIELD_BMI2_HPP
+#define CPPBITFIELD_BITFIELD_BMI2_HPP
+
+#include <cppbitfield/bitfield_array.hpp>
+#include <cppbitfield/bitfield_simd.hpp>
+
+#include <cstddef>
+#include <cstring>
+
+#if defined(CPPBITFIELD_HAS_SIMD) && !defined(CPPBITFIELD_NO_BMI2) && (defined(__x86_64__) || defined(_M_X64))
+#  define CPPBITFIELD_HAS_BMI2 1
+#  if !defined(_MSC_VER)
+#    include <cpuid.h>
+#  endif
+// Built for a BMI2 target: PEXT/PDEP inline into the caller with no dispatch.
+// Zen1/Zen2 (and Excavator) builds keep runtime selection because their
+// PEXT/PDEP are microcoded.
+#  if defined(__BMI2__) && !defined(__znver1__) && !defined(__znver2__) && !defined(__bdver4__)
+#    define CPPBITFIELD_BMI2_NATIVE 1
+#  endif
+#endif
+
+namespace cppbitfield {
+
+    enum class Bmi2Level
+    {
+        None       = 0,
+        Microcoded = 1,
+        Fast       = 2
+    };
+
+    namespace detail {
+
+#if defined(CPPBITFIELD_HAS_BMI2)
+
+        inline void cpuid(unsigned leaf, unsigned sub, unsigned regs[4])
+        {
+#  if defined(_MSC_VER)
+            int info[4];
+            __cpuidex(info, static_cast<int>(leaf), static_cast<int>(sub));
+            for (int i = 0; i < 4; ++i) {
+                regs[i] = static_cast<unsigned>(info[i]);
+            }
+#  else
+            __cpuid_count(leaf, sub, regs[0], regs[1], regs[2], regs[3]);
+#  endif
+        }
+
+        inline Bmi2Level detectBmi2Level()
+        {
+            unsigned regs[4];
+            cpuid(0, 0, regs);
+            if (regs[0] < 7) {
+                return Bmi2Level::None;
+            }
+            char vendor[12];
+            std::memcpy(vendor + 0, &regs[1], 4);
+            std::memcpy(vendor + 4, &regs[3], 4);
+            std::memcpy(vendor + 8, &regs[2], 4);
+            const bool amd = std::memcmp(vendor, "AuthenticAMD", 12) == 0 ||
+                             std::memcmp(vendor, "HygonGenuine", 12) == 0;
+
+            cpuid(7, 0, regs);
+            if ((regs[1] & (1u << 8)) == 0) {
+                return Bmi2Level::None;
+            }
+
+            cpuid(1, 0, regs);
+            unsigned family = (regs[0] >> 8) & 0xF;
+            if (family == 0xF) {
+                family += (regs[0] >> 20) & 0xFF;
+            }
+            // AMD before Zen3 (family 19h) runs PEXT/PDEP in microcode with a
+            // latency that grows with the number of set mask bits.
+            return amd && family < 0x19 ? Bmi2Level::Microcoded : Bmi2Level::Fast;
+        }
+
+#else
+
+        inline Bmi2Level detectBmi2Level()
+        {
+            return Bmi2Level::None;
+        }
+
+#endif/*defined(CPPBITFIELD_HAS_BMI2)*/
+
+    } // namespace detail
+
+    /**
+     * BMI2 support of this CPU, detected once on first use.
+     */
+    inline Bmi2Level bmi2Level()
+    {
+#if defined(CPPBITFIELD_BMI2_NATIVE)
+        return Bmi2Level::Fast;
+#else
+        static const Bmi2Level level = detail::detectBmi2Level();
+        return level;
+#endif
+    }
+
+    /**
+     * Whether the PEXT/PDEP path is the default: only when the instructions
+     * are implemented in hardware.
+     */
+    inline bool preferPext()
+    {
+        return bmi2Level() == Bmi2Level::Fast;
+    }
+
+    namespace detail {
+
+        constexpr int popCount64(uint64_t x)
+        {
+            return x == 0 ? 0 : 1 + popCount64(x & (x - 1));
+        }
+
+        // Shift/mask equivalent of PEXT/PDEP with a constant mask: each field
+        // moves between its record offset and its rank inside `Mask`.
+        template <class Record, uint64_t Mask, typename Record::FieldEnum... Xs>
+        struct PortablePack;
+
+        template <class Record, uint64_t Mask>
+        struct PortablePack<Record, Mask>
+        {
+            static uint64_t gather(uint64_t) { return 0; }
+
+            static uint64_t scatter(uint64_t) { return 0; }
+        };
+
+        template <class Record, uint64_t Mask, typename Record::FieldEnum X, typename Record::FieldEnum... Xs>
+        struct PortablePack<Record, Mask, X, Xs...>
+        {
+            using Pos = FieldPos<Record, Record::template AsInt<X>::value>;
+            using Next = PortablePack<Record, Mask, Xs...>;
+
+            static const int dest = popCount64(Mask & ((static_cast<uint64_t>(1) << Pos::offset) - 1));
+            static const uint64_t mask = LowMask<uint64_t, Pos::length>::value;
+
+            static uint64_t gather(uint64_t bits)
+            {
+                return (((bits >> Pos::offset) & mask) << dest) | Next::gather(bits);
+            }
+
+            static uint64_t scatter(uint64_t packed)
+            {
+                return (((packed >> dest) & mask) << Pos::offset) | Next::scatter(packed);
+            }
+        };
+
+#if defined(CPPBITFIELD_HAS_BMI2)
+
+        namespace bmi2 {
+
+#  define CPPBITFIELD_BMI2_FN inline CPPBITFIELD_TARGET("bmi2")
+
+            CPPBITFIELD_BMI2_FN uint64_t pext(uint64_t bits, uint64_t mask)
+            {
+                return _pext_u64(bits, mask);
+            }
+
+            CPPBITFIELD_BMI2_FN uint64_t pdep(uint64_t packed, uint64_t mask)
+            {
+                return _pdep_u64(packed, mask);
+            }
+
+            template <class StorageType>
+            CPPBITFIELD_BMI2_FN void gather(const StorageType * in, std::size_t n, uint64_t mask, uint64_t * out)
+            {
+                for (std::size_t i = 0; i < n; ++i) {
+                    out[i] = _pext_u64(static_cast<uint64_t>(in[i]), mask);
+                }
+            }
+
+            template <class StorageType>
+            CPPBITFIELD_BMI2_FN void scatter(StorageType * io, std::size_t n, uint64_t mask, const uint64_t * in)
+            {
+                for (std::size_t i = 0; i < n; ++i) {
+                    const uint64_t bits = (static_cast<uint64_t>(io[i]) & ~mask) | _pdep_u64(in[i], mask);
+                    io[i] = static_cast<StorageType>(bits);
+                }
+            }
+
+            template <int NumBits>
+            CPPBITFIELD_BMI2_FN void gatherArray(const uint64_t * words, std::size_t n, uint64_t mask, uint64_t * out)
+            {
+                for (std::size_t i = 0; i < n; ++i) {
+                    out[i] = _pext_u64(loadBits<NumBits>(words, static_cast<uint64_t>(i) * NumBits), mask);
+                }
+            }
+
+            template <int NumBits>
+            CPPBITFIELD_BMI2_FN void scatterArray(uint64_t * words, std::size_t n, uint64_t mask, const uint64_t * in)
+            {
+                for (std::size_t i = 0; i < n; ++i) {
+                    const uint64_t pos = static_cast<uint64_t>(i) * NumBits;
+                    const uint64_t bits = (loadBits<NumBits>(words, pos) & ~mask) | _pdep_u64(in[i], mask);
+                    storeBits<NumBits>(words, pos, bits);
+                }
+            }
+
+#  undef CPPBITFIELD_BMI2_FN
+
+        } // namespace bmi2
+
+#endif/*defined(CPPBITFIELD_HAS_BMI2)*/
+
+    } // namespace detail
+
+    /**
+     * Gathers several fields of a record into one contiguous value, or
+     * scatters such a value back into the fields. The packed value holds the
+     * fields in record order, the lowest offset in the lowest bits, whatever
+     * the order of Xs... - exactly what PEXT/PDEP produce with the combined
+     * field mask.
+     *
+     * Every call takes `usePext`: true selects PEXT/PDEP (ignored on CPUs
+     * without BMI2), false the portable shift/mask path. The default follows
+     * preferPext(), so microcoded implementations stay on shifts unless the
+     * caller asks otherwise. Single record calls dispatch per call; the bulk
+     * overloads dispatch once per run.
+     */
+    template <class Record>
+    struct BitFieldPack
+    {
+        using StorageType = typename Record::StorageType;
+        using EnumType = typename Record::FieldEnum;
+
+        static_assert(Record::NumBits <= 64, "Packing requires single word storage.");
+
+        template <EnumType... Xs>
+        using Mask = std::integral_constant<uint64_t, static_cast<uint64_t>(detail::FieldsMask<Record, Xs...>::value)>;
+
+        // Number of bits in the packed value of Xs...
+        template <EnumType... Xs>
+        using PackedBits = std::integral_constant<int, detail::popCount64(Mask<Xs...>::value)>;
+
+        template <EnumType... Xs>
+        static uint64_t gather(const Record & rec, bool usePext = preferPext())
+        {
+            const uint64_t bits = static_cast<uint64_t>(rec.bits());
+#if defined(CPPBITFIELD_HAS_BMI2)
+            if (usePext && hasBmi2()) {
+                return detail::bmi2::pext(bits, Mask<Xs...>::value);
+            }
+#endif
+            static_cast<void>(usePext);
+            return Portable<Xs...>::gather(bits);
+        }
+
+        template <EnumType... Xs>
+        static void scatter(Record & rec, uint64_t packed, bool usePext = preferPext())
+        {
+            CPPBITFIELD_ASSERT("Packed value too large for fields." && fitsPacked<Xs...>(packed));
+            const uint64_t bits = static_cast<uint64_t>(rec.bits()) & ~Mask<Xs...>::value;
+#if defined(CPPBITFIELD_HAS_BMI2)
+            if (usePext && hasBmi2()) {
+                rec = Record::fromBits(static_cast<StorageType>(bits | detail::bmi2::pdep(packed, Mask<Xs...>::value)));
+                return;
+            }
+#endif
+            static_cast<void>(usePext);
+            rec = Record::fromBits(static_cast<StorageType>(bits | Portable<Xs...>::scatter(packed)));
+        }
+
+        template <EnumType... Xs>
+        static void gather(const Record * recs, std::size_t n, uint64_t * out, bool usePext = preferPext())
+        {
+            static_assert(sizeof(Record) == sizeof(StorageType), "Records must be tightly packed.");
+#if defined(CPPBITFIELD_HAS_BMI2)
+            if (usePext && hasBmi2()) {
+                detail::bmi2::gather(reinterpret_cast<const StorageType *>(recs), n, Mask<Xs...>::value, out);
+                return;
+            }
+#endif
+            static_cast<void>(usePext);
+            for (std::size_t i = 0; i < n; ++i) {
+                out[i] = Portable<Xs...>::gather(static_cast<uint64_t>(recs[i].bits()));
+            }
+        }
+
+        template <EnumType... Xs>
+        static void scatter(Record * recs, std::size_t n, const uint64_t * in, bool usePext = preferPext())
+        {
+            static_assert(sizeof(Record) == sizeof(StorageType), "Records must be tightly packed.");
+            for (std::size_t i = 0; i < n; ++i) {
+                CPPBITFIELD_ASSERT("Packed value too large for fields." && fitsPacked<Xs...>(in[i]));
+            }
+#if defined(CPPBITFIELD_HAS_BMI2)
+            if (usePext && hasBmi2()) {
+                detail::bmi2::scatter(reinterpret_cast<StorageType *>(recs), n, Mask<Xs...>::value, in);
+                return;
+            }
+#endif
+            static_cast<void>(usePext);
+            for (std::size_t i = 0; i < n; ++i) {
+                const uint64_t bits = static_cast<uint64_t>(recs[i].bits()) & ~Mask<Xs...>::value;
+                recs[i] = Record::fromBits(static_cast<StorageType>(bits | Portable<Xs...>::scatter(in[i])));
+            }
+        }
+
+        template <EnumType... Xs, class Sizes>
+        static void gather(const BitFieldArray<EnumType, Sizes> & arr, uint64_t * out, bool usePext = preferPext())
+        {
+            static const int NumBits = BitFieldArray<EnumType, Sizes>::NumBits;
+            const uint64_t * words = arr.words();
+#if defined(CPPBITFIELD_HAS_BMI2)
+            if (usePext && hasBmi2()) {
+                detail::bmi2::gatherArray<NumBits>(words, arr.size(), Mask<Xs...>::value, out);
+                return;
+            }
+#endif
+            static_cast<void>(usePext);
+            for (std::size_t i = 0; i < arr.size(); ++i) {
+                out[i] = Portable<Xs...>::gather(detail::loadBits<NumBits>(words, static_cast<uint64_t>(i) * NumBits));
+            }
+        }
+
+        template <EnumType... Xs, class Sizes>
+        static void scatter(BitFieldArray<EnumType, Sizes> & arr, const uint64_t * in, bool usePext = preferPext())
+        {
+            static const int NumBits = BitFieldArray<EnumType, Sizes>::NumBits;
+            uint64_t * words = arr.words();
+            for (std::size_t i = 0; i < arr.size(); ++i) {
+                CPPBITFIELD_ASSERT("Packed value too large for fields." && fitsPacked<Xs...>(in[i]));
+            }
+#if defined(CPPBITFIELD_HAS_BMI2)
+            if (usePext && hasBmi2()) {
+                detail::bmi2::scatterArray<NumBits>(words, arr.size(), Mask<Xs...>::value, in);
+                return;
+            }
+#endif
+            static_cast<void>(usePext);
+            for (std::size_t i = 0; i < arr.size(); ++i) {
+                const uint64_t pos = static_cast<uint64_t>(i) * NumBits;
+                const uint64_t bits = detail::loadBits<NumBits>(words, pos) & ~Mask<Xs...>::value;
+                detail::storeBits<NumBits>(words, pos, bits | Portable<Xs...>::scatter(in[i]));
+            }
+        }
+
+      private:
+        template <EnumType... Xs>
+        using Portable = detail::PortablePack<Record, Mask<Xs...>::value, Xs...>;
+
+        static bool hasBmi2()
+        {
+            return bmi2Level() != Bmi2Level::None;
+        }
+
+        template <EnumType... Xs>
+        static bool fitsPacked(uint64_t packed)
+        {
+            return PackedBits<Xs...>::value == 64 || (packed >> PackedBits<Xs...>::value) == 0;
+        }
+    };
+
+} // namespace cppbitfield
+
+#endif/*CPPBITFIELD_BITFIELD_BMI2_HPP*/
@@ -0,0 +1,432 @@
+/**
+ * \file bitfield_codec.hpp
+ * \date Oct 16, 2026
+ */
+
+#ifndef CPPBITFIELD_BITFIELD_CODEC_HPP
+#define CPPBITFIELD_BITFIELD_CODEC_HPP
+
+#include <cppbitfield/bitfield_columns.hpp>
+#include <cppbitfield/bitfield_simd.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+namespace cppbitfield {
+
+    /**
+     * Per-block encodings of a CompressedColumn, chosen by the encoder from
+     * one statistics pass as whichever yields the fewest words.
+     */
+    enum class ColumnEncoding
+    {
+        BitPack          = 0, // values at the width of the largest one
+        FrameOfReference = 1, // values minus the block minimum
+        Delta            = 2, // non-decreasing lanes: difference from the value 16 places earlier
+        RunLength        = 3  // (value, run length) pairs
+    };
+
+    namespace detail {
+
+        // A block is CODEC_ROWS rows of CODEC_LANES values.
+        const std::size_t CODEC_LANES = 16;
+        const int CODEC_ROWS = 32;
+        const std::size_t CODEC_BLOCK = CODEC_LANES * CODEC_ROWS;
+
+        typedef void (*UnpackFn)(const uint32_t *, uint32_t *, uint32_t);
+
+        // Vertical layout: lane j keeps values j, j + 16, j + 32, ... packed
+        // LSB first in its own 32-bit words, and word r of lane j is stored at
+        // r * 16 + j. `vals` holds CODEC_BLOCK values of at most `w` bits;
+        // `out` receives 16 * w words.
+        inline void packVertical(const uint32_t * vals, int w, uint32_t * out)
+        {
+            std::memset(out, 0, CODEC_LANES * w * sizeof(uint32_t));
+            for (std::size_t j = 0; j < CODEC_LANES; ++j) {
+                for (int k = 0; k < CODEC_ROWS; ++k) {
+                    const uint32_t v = vals[k * CODEC_LANES + j];
+                    const int bit = k * w;
+                    const int r = bit / 32;
+                    const int s = bit % 32;
+                    out[r * CODEC_LANES + j] |= v << s;
+                    if (s + w > 32) {
+                        out[(r + 1) * CODEC_LANES + j] |= v >> (32 - s);
+                    }
+                }
+            }
+        }
+
+        inline void unpackVertical(const uint32_t * in, int w, uint32_t * out, uint32_t base, bool delta)
+        {
+            const uint32_t mask = w == 0 ? 0 : static_cast<uint32_t>(lowMask64(w));
+            for (std::size_t j = 0; j < CODEC_LANES; ++j) {
+                uint32_t acc = base;
+                for (int k = 0; k < CODEC_ROWS; ++k) {
+                    uint32_t v = 0;
+                    if (w != 0) {
+                        const int bit = k * w;
+                        const int r = bit / 32;
+                        const int s = bit % 32;
+                        v = in[r * CODEC_LANES + j] >> s;
+                        if (s + w > 32) {
+                            v |= in[(r + 1) * CODEC_LANES + j] << (32 - s);
+                        }
+                        v &= mask;
+                    }
+                    acc = delta ? acc + v : base + v;
+                    out[k * CODEC_LANES + j] = acc;
+                }
+            }
+        }
+
+        // Horizontal bit arrays for run-length pairs.
+        inline void putBits32(uint32_t * words, std::size_t pos, int w, uint32_t v)
+        {
+            if (w == 0) {
+                return;
+            }
+            const std::size_t r = pos / 32;
+            const int s = static_cast<int>(pos % 32);
+            words[r] |= v << s;
+            if (s + w > 32) {
+                words[r + 1] |= v >> (32 - s);
+            }
+        }
+
+        inline uint32_t getBits32(const uint32_t * words, std::size_t pos, int w)
+        {
+            if (w == 0) {
+                return 0;
+            }
+            const std::size_t r = pos / 32;
+            const int s = static_cast<int>(pos % 32);
+            uint32_t v = words[r] >> s;
+            if (s + w > 32) {
+                v |= words[r + 1] << (32 - s);
+            }
+            return v & static_cast<uint32_t>(lowMask64(w));
+        }
+
+        inline std::size_t wordsFor32(std::size_t bits)
+        {
+            return (bits + 31) / 32;
+        }
+
+#if defined(CPPBITFIELD_HAS_SIMD)
+
+        namespace sse2 {
+
+#  define CPPBITFIELD_SIMD_FN inline CPPBITFIELD_TARGET("sse2")
+#  include <cppbitfield/detail/codec_kernels.inl>
+#  undef CPPBITFIELD_SIMD_FN
+
+        } // namespace sse2
+
+        namespace avx2 {
+
+#  define CPPBITFIELD_SIMD_FN inline CPPBITFIELD_TARGET("avx2")
+#  include <cppbitfield/detail/codec_kernels.inl>
+#  undef CPPBITFIELD_SIMD_FN
+
+        } // namespace avx2
+
+#  if defined(__GNUC__) && !defined(__clang__)
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#    pragma GCC diagnostic ignored "-Wuninitialized"
+#  endif
+
+        namespace avx512 {
+
+#  define CPPBITFIELD_SIMD_FN inline CPPBITFIELD_TARGET("avx512f")
+#  include <cppbitfield/detail/codec_kernels.inl>
+#  undef CPPBITFIELD_SIMD_FN
+
+        } // namespace avx512
+
+#  if defined(__GNUC__) && !defined(__clang__)
+#    pragma GCC diagnostic pop
+#  endif
+
+#endif/*defined(CPPBITFIELD_HAS_SIMD)*/
+
+        inline UnpackFn unpackKernel(SimdLevel level, bool delta, int w)
+        {
+            using Widths = MakeIndexSeq<33>::type;
+            switch (level) {
+#if defined(CPPBITFIELD_HAS_SIMD)
+              case SimdLevel::Avx512:
+                return delta ? avx512::unpackDeltaFn(w, Widths()) : avx512::unpackForFn(w, Widths());
+              case SimdLevel::Avx2:
+                return delta ? avx2::unpackDeltaFn(w, Widths()) : avx2::unpackForFn(w, Widths());
+              case SimdLevel::Sse2:
+                return delta ? sse2::unpackDeltaFn(w, Widths()) : sse2::unpackForFn(w, Widths());
+#endif
+              default:
+                return nullptr;
+            }
+        }
+
+    } // namespace detail
+
+    /**
+     * A column of up to 32-bit values (typically one field of a run of
+     * records) compressed in independent blocks of 512 values. Each block
+     * header word holds its encoding, the bit widths and the value count;
+     * bit-packed, frame-of-reference and delta blocks unpack with the SIMD
+     * kernels, run-length blocks expand runs with a fill.
+     */
+    class CompressedColumn
+    {
+      public:
+        using size_type = std::size_t;
+
+        static const size_type BLOCK = detail::CODEC_BLOCK;
+
+        CompressedColumn() : m_size(0) { }
+
+        static CompressedColumn encode(const uint32_t * vals, size_type n)
+        {
+            CompressedColumn ret;
+            ret.m_size = n;
+            uint32_t block[detail::CODEC_BLOCK];
+            for (size_type b = 0; b < n; b += BLOCK) {
+                const size_type count = n - b < BLOCK ? n - b : BLOCK;
+                std::copy(vals + b, vals + b + count, block);
+                // repeating the last value leaves every statistic unchanged
+                std::fill(block + count, block + BLOCK, block[count - 1]);
+                ret.m_offsets.push_back(ret.m_data.size());
+                ret.encodeBlock(block, count);
+            }
+            return ret;
+        }
+
+        size_type size() const { return m_size; }
+
+        bool empty() const { return m_size == 0; }
+
+        size_type numBlocks() const { return m_offsets.size(); }
+
+        ColumnEncoding blockEncoding(size_type b) const
+        {
+            return static_cast<ColumnEncoding>(m_data[m_offsets[b]] & 3);
+        }
+
+        size_type sizeInBytes() const
+        {
+            return m_data.size() * sizeof(uint32_t) + m_offsets.size() * sizeof(size_type);
+        }
+
+        /**
+         * Decodes block `b` into `out`, which must have room for BLOCK
+         * values even when the block holds fewer; returns the block's count.
+         */
+        size_type decodeBlock(size_type b, uint32_t * out, SimdLevel level = simdLevel()) const
+        {
+            CPPBITFIELD_ASSERT("Block out of bounds." && (b < m_offsets.size()));
+            const uint32_t * p = m_data.data() + m_offsets[b];
+            const uint32_t hdr = p[0];
+            const ColumnEncoding enc = static_cast<ColumnEncoding>(hdr & 3);
+            const int w = static_cast<int>((hdr >> 2) & 63);
+            const size_type count = ((hdr >> 14) & 1023) + 1;
+
+            if (enc == ColumnEncoding::RunLength) {
+                const int wLen = static_cast<int>((hdr >> 8) & 63);
+                const uint32_t base = p[1];
+                const size_type runs = p[2];
+                const uint32_t * vals = p + 3;
+                const uint32_t * lens = vals + detail::wordsFor32(runs * w);
+                uint32_t * o = out;
+                for (size_type r = 0; r < runs; ++r) {
+                    const uint32_t len = detail::getBits32(lens, r * wLen, wLen) + 1;
+                    std::fill(o, o + len, base + detail::getBits32(vals, r * w, w));
+                    o += len;
+                }
+                return count;
+            }
+
+            const bool delta = enc == ColumnEncoding::Delta;
+            const uint32_t base = enc == ColumnEncoding::BitPack ? 0 : p[1];
+            const uint32_t * payload = p + (enc == ColumnEncoding::BitPack ? 1 : 2);
+            const detail::UnpackFn fn = detail::unpackKernel(detail::clampSimdLevel(level), delta, w);
+            if (fn) {
+                fn(payload, out, base);
+            }
+            else {
+                detail::unpackVertical(payload, w, out, base, delta);
+            }
+            return count;
+        }
+
+        // Decodes every value into out[0 .. size()).
+        void decode(uint32_t * out, SimdLevel level = simdLevel()) const
+        {
+            for (size_type b = 0; b < m_offsets.size(); ++b) {
+                if ((b + 1) * BLOCK <= m_size) {
+                    decodeBlock(b, out + b * BLOCK, level);
+                }
+                else {
+                    uint32_t tail[detail::CODEC_BLOCK];
+                    const size_type count = decodeBlock(b, tail, level);
+                    std::copy(tail, tail + count, out + b * BLOCK);
+                }
+            }
+        }
+
+      private:
+        void encodeBlock(const uint32_t * v, size_type count)
+        {
+            const size_type L = detail::CODEC_LANES;
+            uint32_t lo = v[0], hi = v[0], rowMin = v[0];
+            size_type runs = 1, run = 1, maxRun = 1;
+            bool monotone = true;
+            uint32_t maxDelta = 0;
+            for (size_type i = 1; i < BLOCK; ++i) {
+                lo = std::min(lo, v[i]);
+                hi = std::max(hi, v[i]);
+                if (v[i] == v[i - 1]) {
+                    maxRun = std::max(maxRun, ++run);
+                }
+                else {
+                    ++runs;
+                    run = 1;
+                }
+                if (i < L) {
+                    rowMin = std::min(rowMin, v[i]);
+                }
+                else if (v[i] < v[i - L]) {
+                    monotone = false;
+                }
+                else {
+                    maxDelta = std::max(maxDelta, v[i] - v[i - L]);
+                }
+            }
+            for (size_type j = 0; j < L; ++j) {
+                maxDelta = std::max(maxDelta, v[j] - rowMin);
+            }
+
+            const int wPack = detail::bitWidth(hi);
+            const int wFor = detail::bitWidth(hi - lo);
+            const int wDelta = detail::bitWidth(maxDelta);
+            const int wLen = detail::bitWidth(static_cast<uint32_t>(maxRun - 1));
+
+            // cost in words of each candidate, ties going to the faster decode
+            ColumnEncoding enc = ColumnEncoding::BitPack;
+            size_type best = 1 + L * wPack;
+            if (2 + L * wFor < best) {
+                enc = ColumnEncoding::FrameOfReference;
+                best = 2 + L * wFor;
+            }
+            if (monotone && 2 + L * wDelta < best) {
+                enc = ColumnEncoding::Delta;
+                best = 2 + L * wDelta;
+            }
+            const size_type rleWords = 3 + detail::wordsFor32(runs * wFor) + detail::wordsFor32(runs * wLen);
+            if (rleWords < best) {
+                enc = ColumnEncoding::RunLength;
+            }
+
+            const int w = enc == ColumnEncoding::BitPack ? wPack :
+                          enc == ColumnEncoding::Delta ? wDelta : wFor;
+            m_data.push_back(static_cast<uint32_t>(enc) | (static_cast<uint32_t>(w) << 2) |
+                             (static_cast<uint32_t>(enc == ColumnEncoding::RunLength ? wLen : 0) << 8) |
+                             (static_cast<uint32_t>(count - 1) << 14));
+
+            uint32_t tmp[detail::CODEC_BLOCK];
+            switch (enc) {
+              case ColumnEncoding::BitPack:
+                appendVertical(v, w);
+                break;
+              case ColumnEncoding::FrameOfReference:
+                m_data.push_back(lo);
+                for (size_type i = 0; i < BLOCK; ++i) {
+                    tmp[i] = v[i] - lo;
+                }
+                appendVertical(tmp, w);
+                break;
+              case ColumnEncoding::Delta:
+                m_data.push_back(rowMin);
+                for (size_type i = 0; i < BLOCK; ++i) {
+                    tmp[i] = v[i] - (i < L ? rowMin : v[i - L]);
+                }
+                appendVertical(tmp, w);
+                break;
+              default: {
+                // runs of the counted values only, so decoding writes `count` values
+                m_data.push_back(lo);
+                const size_type at = m_data.size();
+                m_data.push_back(0);
+                size_type numRuns = 0;
+                std::vector<uint32_t> vals(detail::wordsFor32(runs * w) + 1, 0);
+                std::vector<uint32_t> lens(detail::wordsFor32(runs * wLen) + 1, 0);
+                for (size_type i = 0; i < count;) {
+                    size_type j = i + 1;
+                    while (j < count && v[j] == v[i]) {
+                        ++j;
+                    }
+                    detail::putBits32(vals.data(), numRuns * w, w, v[i] - lo);
+                    detail::putBits32(lens.data(), numRuns * wLen, wLen, static_cast<uint32_t>(j - i - 1));
+                    ++numRuns;
+                    i = j;
+                }
+                m_data[at] = static_cast<uint32_t>(numRuns);
+                m_data.insert(m_data.end(), vals.begin(), vals.begin() + detail::wordsFor32(numRuns * w));
+                m_data.insert(m_data.end(), lens.begin(), lens.begin() + detail::wordsFor32(numRuns * wLen));
+                break;
+              }
+            }
+        }
+
+        void appendVertical(const uint32_t * vals, int w)
+        {
+            const size_type at = m_data.size();
+            m_data.resize(at + detail::CODEC_LANES * w);
+            if (w != 0) {
+                detail::packVertical(vals, w, m_data.data() + at);
+            }
+        }
+
+        std::vector<uint32_t> m_data;
+        std::vector<size_type> m_offsets;
+        size_type m_size;
+    };
+
+    /**
+     * Compresses field X of `n` records, extracted with BitFieldBatch.
+     */
+    template <class Record, typename Record::FieldEnum X>
+    CompressedColumn compressField(const Record * recs, std::size_t n, SimdLevel level = simdLevel())
+    {
+        std::vector<uint32_t> vals(n);
+        BitFieldBatch<Record>::template extract<X>(recs, n, vals.data(), level);
+        return CompressedColumn::encode(vals.data(), n);
+    }
+
+    /**
+     * Decodes `col` into field X of recs[0 .. col.size()), leaving the other
+     * fields untouched.
+     */
+    template <class Record, typename Record::FieldEnum X>
+    void decompressField(const CompressedColumn & col, Record * recs, SimdLevel level = simdLevel())
+    {
+        std::vector<uint32_t> vals(col.size());
+        col.decode(vals.data(), level);
+        BitFieldBatch<Record>::template insert<X>(recs, col.size(), vals.data(), level);
+    }
+
+    template <int Length>
+    CompressedColumn compressColumn(const BitFieldColumn<Length> & col)
+    {
+        static_assert(Length <= 32, "Column values must fit in uint32_t.");
+        std::vector<uint32_t> vals(col.size());
+        for (std::size_t i = 0; i < col.size(); ++i) {
+            vals[i] = static_cast<uint32_t>(col.get(i));
+        }
+        return CompressedColumn::encode(vals.data(), vals.size());
+    }
+
+} // namespace cppbitfield
+
+#endif/*CPPBITFIELD_BITFIELD_CODEC_HPP*/
@@ -0,0 +1,271 @@
+/**
+ * \file bitfield_columns.hpp
+ * \date Oct 16, 2026
+ */
+
+#ifndef CPPBITFIELD_BITFIELD_COLUMNS_HPP
+#define CPPBITFIELD_BITFIELD_COLUMNS_HPP
+
+#include <cppbitfield/bitfield_array.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace cppbitfield {
+
+    // Read only view of a single packed column, `Length` bits per entry.
+    template <int Length>
+    class BitFieldColumn
+    {
+      public:
+        using size_type = std::size_t;
+
+        static const int NumBits = Length;
+
+        BitFieldColumn(const uint64_t * words, size_type size) : m_words(words), m_size(size) { }
+
+        size_type size() const { return m_size; }
+
+        uint64_t get(size_type i) const
+        {
+            CPPBITFIELD_ASSERT("Index out of bounds." && (i < m_size));
+            return detail::ArrayField<Length, 0, Length>::load(m_words, static_cast<uint64_t>(i) * Length);
+        }
+
+        uint64_t operator[](size_type i) const { return get(i); }
+
+        const uint64_t * words() const { return m_words; }
+
+        size_type numWords() const { return static_cast<size_type>(detail::wordsForBits(static_cast<uint64_t>(m_size) * Length)); }
+
+      private:
+        const uint64_t * m_words;
+        size_type m_size;
+    };
+
+    namespace detail {
+
+        template <class Record, int Idx, int N>
+        struct ColumnsRecordImpl
+        {
+            static const int offset = Record::template FieldOffset<Idx>::value;
+            static const int length = Record::template FieldLength<Idx>::value;
+
+            using StorageType = typename Record::StorageType;
+            using ValueType = typename Record::ValueType;
+            using Access = BitsAccess<StorageType>;
+            using Next = ColumnsRecordImpl<Record, Idx + 1, N>;
+
+            static void load(const std::vector<uint64_t> * cols, uint64_t i, StorageType & bits)
+            {
+                const uint64_t val = ArrayField<length, 0, length>::load(cols[Idx].data(), i * length);
+                Access::template set<offset, length>(bits, static_cast<ValueType>(val));
+                Next::load(cols, i, bits);
+            }
+
+            static void store(std::vector<uint64_t> * cols, uint64_t i, const StorageType & bits)
+            {
+                const uint64_t val = static_cast<uint64_t>(Access::template get<offset, length>(bits));
+                ArrayField<length, 0, length>::store(cols[Idx].data(), i * length, val);
+                Next::store(cols, i, bits);
+            }
+
+            static void resize(std::vector<uint64_t> * cols, uint64_t count)
+            {
+                cols[Idx].resize(wordsForBits(count * length), 0);
+                const unsigned tail = static_cast<unsigned>((count * length) & 63);
+                if (tail != 0) {
+                    cols[Idx].back() &= (static_cast<uint64_t>(1) << tail) - 1;
+                }
+                Next::resize(cols, count);
+            }
+        };
+
+        template <class Record, int N>
+        struct ColumnsRecordImpl<Record, N, N>
+        {
+            using StorageType = typename Record::StorageType;
+
+            static void load(const std::vector<uint64_t> *, uint64_t, StorageType &) { }
+
+            static void store(std::vector<uint64_t> *, uint64_t, const StorageType &) { }
+
+            static void resize(std::vector<uint64_t> *, uint64_t) { }
+        };
+
+    } // namespace detail
+
+    // Structure of arrays companion to BitFields: every field lives in its own
+    // column packed at exactly FieldLength bits, so a scan over one field only
+    // pulls that column through the cache.
+    template <class EnumType, class Sizes>
+    class BitFieldColumns
+    {
+      public:
+        using value_type = BitFields<EnumType, Sizes>;
+        using size_type = std::size_t;
+        using StorageType = typename value_type::StorageType;
+        using ValueType = typename value_type::ValueType;
+
+        static const int NumFields = value_type::NumFields;
+
+        template <EnumType X>
+        using Field = detail::FieldPos<value_type, value_type::template AsInt<X>::value>;
+
+        template <EnumType X>
+        using Column = BitFieldColumn<Field<X>::length>;
+
+        class reference
+        {
+          public:
+            template <EnumType X, class Y = ValueType>
+            Y get() const
+            {
+                return m_columns->template get<X, Y>(m_index);
+            }
+
+            template <EnumType X, class Y>
+            void set(Y val)
+            {
+                m_columns->template set<X>(m_index, val);
+            }
+
+            template <EnumType X>
+            void set(bool val)
+            {
+                m_columns->template set<X>(m_index, val);
+            }
+
+            operator value_type() const
+            {
+                return m_columns->get(m_index);
+            }
+
+            reference & operator=(const value_type & val)
+            {
+                m_columns->set(m_index, val);
+                return *this;
+            }
+
+            reference & operator=(const reference & rhs)
+            {
+                m_columns->set(m_index, rhs.m_columns->get(rhs.m_index));
+                return *this;
+            }
+
+          private:
+            friend class BitFieldColumns;
+
+            reference(BitFieldColumns * columns, size_type index) : m_columns(columns), m_index(index) { }
+
+            BitFieldColumns * m_columns;
+            size_type m_index;
+        };
+
+        BitFieldColumns() : m_size(0) { }
+
+        explicit BitFieldColumns(size_type count) : m_size(0)
+        {
+            resize(count);
+        }
+
+        size_type size() const { return m_size; }
+
+        bool empty() const { return m_size == 0; }
+
+        void clear()
+        {
+            for (int i = 0; i < NumFields; ++i) {
+                m_columns[i].clear();
+            }
+            m_size = 0;
+        }
+
+        void resize(size_type count)
+        {
+            Impl::resize(m_columns, count);
+            m_size = count;
+        }
+
+        void push_back(const value_type & val)
+        {
+            resize(m_size + 1);
+            set(m_size - 1, val);
+        }
+
+        template <EnumType X, class Y = ValueType>
+        Y get(size_type i) const
+        {
+            CPPBITFIELD_ASSERT("Index out of bounds." && (i < m_size));
+            return static_cast<Y>(detail::ArrayField<Field<X>::length, 0, Field<X>::length>::load(columnWords<X>(), static_cast<uint64_t>(i) * Field<X>::length));
+        }
+
+        template <EnumType X, class Y>
+        void set(size_type i, Y val)
+        {
+            CPPBITFIELD_ASSERT("Index out of bounds." && (i < m_size));
+            auto valtrunc = static_cast<uint64_t>(val) & detail::LowMask<uint64_t, Field<X>::length>::value;
+            CPPBITFIELD_ASSERT("Value too large for bitfield length." &&
+                               (static_cast<uint64_t>(val) == valtrunc));
+            detail::ArrayField<Field<X>::length, 0, Field<X>::length>::store(m_columns[value_type::template AsInt<X>::value].data(),
+                                                                             static_cast<uint64_t>(i) * Field<X>::length, valtrunc);
+        }
+
+        template <EnumType X>
+        void set(size_type i, bool val)
+        {
+            set<X>(i, static_cast<uint64_t>(val ? 1 : 0));
+        }
+
+        value_type get(size_type i) const
+        {
+            CPPBITFIELD_ASSERT("Index out of bounds." && (i < m_size));
+            StorageType bits = StorageType();
+            Impl::load(m_columns, i, bits);
+            return value_type::fromBits(bits);
+        }
+
+        void set(size_type i, const value_type & val)
+        {
+            CPPBITFIELD_ASSERT("Index out of bounds." && (i < m_size));
+            Impl::store(m_columns, i, val.bits());
+        }
+
+        reference operator[](size_type i) { return reference(this, i); }
+
+        value_type operator[](size_type i) const { return get(i); }
+
+        template <EnumType X>
+        Column<X> column() const
+        {
+            return Column<X>(columnWords<X>(), m_size);
+        }
+
+        size_type sizeInBytes() const
+        {
+            size_type ret = 0;
+            for (int i = 0; i < NumFields; ++i) {
+                ret += m_columns[i].size() * sizeof(uint64_t);
+            }
+            return ret;
+        }
+
+      private:
+        using Impl = detail::ColumnsRecordImpl<value_type, 0, NumFields>;
+
+        template <EnumType X>
+        const uint64_t * columnWords() const
+        {
+            return m_columns[value_type::template AsInt<X>::value].data();
+        }
+
+        std::vector<uint64_t> m_columns[NumFields];
+        size_type m_size;
+    };
+
+} // namespace cppbitfield
+
+#define DEFINE_BITFIELD_COLUMNS(N, X, Y) \
+    using N = cppbitfield::BitFieldColumns<X, Y>
+
+#endif/*CPPBITFIELD_BITFIELD_COLUMNS_HPP*/
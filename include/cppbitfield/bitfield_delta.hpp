@@ -0,0 +1,451 @@
+/**
+ * \file bitfield_delta.hpp
+ * \date Oct 16, 2026
+ */
+
+#ifndef CPPBITFIELD_BITFIELD_DELTA_HPP
+#define CPPBITFIELD_BITFIELD_DELTA_HPP
+
+#include <cppbitfield/bitfield_diff.hpp>
+#include <cppbitfield/bitfield_file.hpp>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace cppbitfield {
+
+    enum class DeltaStatus
+    {
+        Ok,
+        BadHeader,      // too short for a header, or the payload size disagrees with it
+        LayoutMismatch, // encoded for a different enum or BitFieldSizes
+        SizeMismatch,   // applied to a table of another size than it was encoded from
+        Corrupt         // an entry runs past the payload or names a record or field that does not exist
+    };
+
+    namespace detail {
+
+        // Header words of a delta stream: layout fingerprint, table size,
+        // number of entries and payload bits.
+        static const std::size_t DELTA_HEADER_WORDS = 4;
+
+        // Records diffed per pass when encoding from plain record arrays.
+        static const std::size_t DELTA_CHUNK = 1 << 16;
+
+        // Entries decoded ahead of the one being applied.
+        static const std::size_t DELTA_LOOKAHEAD = 16;
+
+        // Bits holding the width of an index gap.
+        static const int DELTA_GAP_WIDTH_BITS = 6;
+
+        inline void prefetchWrite(const void * p)
+        {
+#if defined(__GNUC__)
+            __builtin_prefetch(p, 1);
+#else
+            (void)p;
+#endif
+        }
+
+        template <class T>
+        inline uint64_t fieldValue(const T & bits, int offset, int length)
+        {
+            return (static_cast<uint64_t>(bits) >> offset) & lowMask64(length);
+        }
+
+        template <int NumWords>
+        inline uint64_t fieldValue(const WordArray<NumWords> & bits, int offset, int length)
+        {
+            const int w = offset >> 6;
+            const int s = offset & 63;
+            uint64_t v = bits.words[w] >> s;
+            if (s + length > 64) {
+                v |= bits.words[w + 1] << (64 - s);
+            }
+            return v & lowMask64(length);
+        }
+
+        // Appends values LSB first to a word vector, a word at a time.
+        class DeltaWriter
+        {
+          public:
+            explicit DeltaWriter(std::vector<uint64_t> & words) : m_words(words), m_acc(0), m_fill(0), m_bits(0) { }
+
+            // `v` must fit in `w` bits, 0 <= w <= 64.
+            void put(uint64_t v, int w)
+            {
+                if (w == 0) {
+                    return;
+                }
+                m_acc |= v << m_fill;
+                m_bits += w;
+                if (m_fill + w >= 64) {
+                    m_words.push_back(m_acc);
+                    m_acc = m_fill == 0 ? 0 : v >> (64 - m_fill);
+                    m_fill += w - 64;
+                } else {
+                    m_fill += w;
+                }
+            }
+
+            // Pushes the partial last word; returns the bits written.
+            uint64_t flush()
+            {
+                if (m_fill != 0) {
+                    m_words.push_back(m_acc);
+                    m_acc = 0;
+                    m_fill = 0;
+                }
+                return m_bits;
+            }
+
+          private:
+            std::vector<uint64_t> & m_words;
+            uint64_t m_acc;
+            int m_fill;
+            uint64_t m_bits;
+        };
+
+        // Reads what DeltaWriter wrote, refusing to read past `bits`.
+        class DeltaReader
+        {
+          public:
+            DeltaReader(const uint64_t * words, uint64_t bits) : m_words(words), m_pos(0), m_end(bits) { }
+
+            bool get(int w, uint64_t & v)
+            {
+                if (static_cast<uint64_t>(w) > m_end - m_pos) {
+                    return false;
+                }
+                v = 0;
+                if (w != 0) {
+                    const uint64_t * p = m_words + (m_pos >> 6);
+                    const int s = static_cast<int>(m_pos & 63);
+                    v = p[0] >> s;
+                    if (s + w > 64) {
+                        v |= p[1] << (64 - s);
+                    }
+                    v &= lowMask64(w);
+                    m_pos += w;
+                }
+                return true;
+            }
+
+            bool atEnd() const { return m_pos == m_end; }
+
+          private:
+            const uint64_t * m_words;
+            uint64_t m_pos;
+            uint64_t m_end;
+        };
+
+    } // namespace detail
+
+    /**
+     * The changes between two versions of a table of records, for shipping
+     * to a replica that holds the old version. Each changed record is one
+     * entry packed LSB first:
+     *   - the gap to the previous changed record (the index itself for the
+     *     first): its width in 6 bits, then the bits below the leading one;
+     *   - a flag bit, then the index of the one changed field in
+     *     ceil(log2(NumFields)) bits if set, otherwise the change mask in
+     *     NumFields bits;
+     *   - the new value of every changed field at exactly its declared
+     *     length, in field order.
+     * Unchanged records cost nothing and a one-field update to a 3-bit field
+     * takes a few bytes. The stream starts with DELTA_HEADER_WORDS header
+     * words carrying the LayoutFingerprint, so a replica with another layout
+     * rejects it; like the record files, words are in host byte order.
+     */
+    template <class EnumType, class Sizes>
+    class DeltaStream
+    {
+      public:
+        using value_type = BitFields<EnumType, Sizes>;
+        using size_type = std::size_t;
+        using StorageType = typename value_type::StorageType;
+
+        static const int NumFields = value_type::NumFields;
+
+        static_assert(NumFields <= 64, "Change masks hold at most 64 fields.");
+
+        DeltaStream() : m_words(detail::DELTA_HEADER_WORDS, 0), m_bits(0), m_records(0), m_changes(0)
+        {
+            m_words[0] = LayoutFingerprint<EnumType, Sizes>::value;
+        }
+
+        /**
+         * Delta turning prev[0 .. n) into next[0 .. n), found with the bulk
+         * diff at the given SIMD level.
+         */
+        static DeltaStream encode(const value_type * prev, const value_type * next, size_type n,
+                                  SimdLevel level = simdLevel())
+        {
+            DeltaStream ret;
+            detail::DeltaWriter out(ret.m_words);
+            std::vector<FieldChange> changes(n < detail::DELTA_CHUNK ? n : detail::DELTA_CHUNK);
+            size_type last = 0;
+            for (size_type base = 0; base < n; base += detail::DELTA_CHUNK) {
+                const size_type len = n - base < detail::DELTA_CHUNK ? n - base : detail::DELTA_CHUNK;
+                const size_type count = diff(prev + base, next + base, len, changes.data(), level);
+                for (size_type k = 0; k < count; ++k) {
+                    const size_type i = base + changes[k].index;
+                    ret.append(out, i - last, changes[k].fields, next[i].bits());
+                    last = i + 1;
+                }
+            }
+            ret.finish(out, n);
+            return ret;
+        }
+
+        /**
+         * Delta between two arrays of the same size, comparing their packed
+         * words with the SIMD block compare and diffing only the records
+         * overlapping a word that differs.
+         */
+        static DeltaStream encode(const BitFieldArray<EnumType, Sizes> & prev, const BitFieldArray<EnumType, Sizes> & next,
+                                  SimdLevel level = simdLevel())
+        {
+            CPPBITFIELD_ASSERT("Arrays must have the same size." && (prev.size() == next.size()));
+            const detail::DiffPlan<value_type> & plan = detail::DiffPlan<value_type>::get();
+            const int NumBits = value_type::NumBits;
+            const size_type n = prev.size();
+            const size_type numWords = prev.numWords();
+            level = detail::clampSimdLevel(level);
+
+            DeltaStream ret;
+            detail::DeltaWriter out(ret.m_words);
+            uint64_t bitmap[detail::DIFF_BLOCK_WORDS];
+            size_type last = 0;
+            size_type cursor = 0;
+            for (size_type base = 0; base < numWords; base += detail::DIFF_BLOCK) {
+                const size_type len = numWords - base < detail::DIFF_BLOCK ? numWords - base : detail::DIFF_BLOCK;
+                detail::differBlock(prev.words() + base, next.words() + base, len, bitmap, level);
+                for (size_type b = 0; b < (len + 63) / 64; ++b) {
+                    for (uint64_t bits = bitmap[b]; bits != 0; bits &= bits - 1) {
+                        const uint64_t word = base + 64 * b + detail::countTrailingZeros(bits);
+                        const size_type first = static_cast<size_type>(64 * word / NumBits);
+                        size_type end = static_cast<size_type>((64 * word + 63) / NumBits) + 1;
+                        end = end < n ? end : n;
+                        // a record spanning several differing words is diffed once
+                        for (size_type i = first > cursor ? first : cursor; i < end; ++i) {
+                            const StorageType now = next.get(i).bits();
+                            const uint64_t fields = plan.changed(prev.get(i).bits(), now);
+                            if (fields != 0) {
+                                ret.append(out, i - last, fields, now);
+                                last = i + 1;
+                            }
+                        }
+                        cursor = end > cursor ? end : cursor;
+                    }
+                }
+            }
+            ret.finish(out, n);
+            return ret;
+        }
+
+        /**
+         * Adopts a stream received as `count` words, e.g. from words() on
+         * the sender. The header and every entry are checked before `out`
+         * is replaced, so a stream that applies never fails half way.
+         */
+        static DeltaStatus fromWords(const uint64_t * words, size_type count, DeltaStream & out)
+        {
+            if (count < detail::DELTA_HEADER_WORDS) {
+                return DeltaStatus::BadHeader;
+            }
+            if (words[0] != LayoutFingerprint<EnumType, Sizes>::value) {
+                return DeltaStatus::LayoutMismatch;
+            }
+            const uint64_t bits = words[3];
+            if (detail::wordsForBits(bits) != count - detail::DELTA_HEADER_WORDS || words[2] > words[1]) {
+                return DeltaStatus::BadHeader;
+            }
+            DeltaStream ret;
+            ret.m_words.assign(words, words + count);
+            ret.m_records = static_cast<size_type>(words[1]);
+            ret.m_changes = static_cast<size_type>(words[2]);
+            ret.m_bits = bits;
+            const DeltaStatus status = ret.walk([](size_type, uint64_t, const uint64_t *) { });
+            if (status == DeltaStatus::Ok) {
+                out = std::move(ret);
+            }
+            return status;
+        }
+
+        /**
+         * Applies the stream in place to recs[0 .. n), which must hold the
+         * version it was encoded against; only the changed fields of the
+         * changed records are written.
+         */
+        DeltaStatus apply(value_type * recs, size_type n) const
+        {
+            if (n != m_records) {
+                return DeltaStatus::SizeMismatch;
+            }
+            return applyAhead(
+                [recs](size_type i) { return static_cast<const void *>(recs + i); },
+                [recs](size_type i, uint64_t fields, const uint64_t * vals) {
+                    StorageType bits = recs[i].bits();
+                    patch(bits, fields, vals);
+                    recs[i] = value_type::fromBits(bits);
+                });
+        }
+
+        DeltaStatus apply(BitFieldArray<EnumType, Sizes> & arr) const
+        {
+            if (arr.size() != m_records) {
+                return DeltaStatus::SizeMismatch;
+            }
+            BitFieldArray<EnumType, Sizes> * dst = &arr;
+            return applyAhead(
+                [dst](size_type i) {
+                    return static_cast<const void *>(dst->words() + ((static_cast<uint64_t>(i) * value_type::NumBits) >> 6));
+                },
+                [dst](size_type i, uint64_t fields, const uint64_t * vals) {
+                    StorageType bits = dst->get(i).bits();
+                    patch(bits, fields, vals);
+                    dst->set(i, value_type::fromBits(bits));
+                });
+        }
+
+        // Size of the table the stream was encoded from.
+        size_type numRecords() const { return m_records; }
+
+        // Number of changed records.
+        size_type numChanges() const { return m_changes; }
+
+        bool empty() const { return m_changes == 0; }
+
+        // The whole stream, header included, for shipping.
+        const uint64_t * words() const { return m_words.data(); }
+
+        size_type numWords() const { return m_words.size(); }
+
+        size_type sizeInBytes() const { return m_words.size() * sizeof(uint64_t); }
+
+      private:
+        static const int INDEX_BITS = detail::bitWidth(NumFields - 1);
+
+        void append(detail::DeltaWriter & out, uint64_t gap, uint64_t fields, const StorageType & bits)
+        {
+            const int w = detail::bitWidth(gap);
+            out.put(static_cast<uint64_t>(w), detail::DELTA_GAP_WIDTH_BITS);
+            if (w > 1) {
+                out.put(gap & detail::lowMask64(w - 1), w - 1);
+            }
+            if ((fields & (fields - 1)) == 0) {
+                out.put(1, 1);
+                out.put(static_cast<uint64_t>(detail::countTrailingZeros(fields)), INDEX_BITS);
+            } else {
+                out.put(0, 1);
+                out.put(fields, NumFields);
+            }
+            for (uint64_t f = fields; f != 0; f &= f - 1) {
+                const int idx = detail::countTrailingZeros(f);
+                out.put(detail::fieldValue(bits, Sizes::offset(idx), Sizes::length(idx)), Sizes::length(idx));
+            }
+            ++m_changes;
+        }
+
+        void finish(detail::DeltaWriter & out, size_type n)
+        {
+            m_bits = out.flush();
+            m_records = n;
+            m_words[1] = n;
+            m_words[2] = m_changes;
+            m_words[3] = m_bits;
+        }
+
+        static void patch(StorageType & bits, uint64_t fields, const uint64_t * vals)
+        {
+            for (; fields != 0; fields &= fields - 1) {
+                const int idx = detail::countTrailingZeros(fields);
+                bits = detail::BitsAccess<StorageType>::put(bits, Sizes::offset(idx), Sizes::length(idx), vals[idx]);
+            }
+        }
+
+        struct Pending
+        {
+            size_type index;
+            uint64_t fields;
+            uint64_t vals[NumFields];
+        };
+
+        // Writes each entry DELTA_LOOKAHEAD entries after decoding it and
+        // prefetching the record it changes at `locate(index)`: sparse
+        // changes to a large table miss the cache on nearly every record.
+        template <class Locate, class Write>
+        DeltaStatus applyAhead(Locate locate, Write write) const
+        {
+            Pending ring[detail::DELTA_LOOKAHEAD];
+            size_type count = 0;
+            const DeltaStatus status = walk([&](size_type i, uint64_t fields, const uint64_t * vals) {
+                Pending & p = ring[count % detail::DELTA_LOOKAHEAD];
+                if (count >= detail::DELTA_LOOKAHEAD) {
+                    write(p.index, p.fields, p.vals);
+                }
+                detail::prefetchWrite(locate(i));
+                p.index = i;
+                p.fields = fields;
+                for (uint64_t f = fields; f != 0; f &= f - 1) {
+                    const int idx = detail::countTrailingZeros(f);
+                    p.vals[idx] = vals[idx];
+                }
+                ++count;
+            });
+            for (size_type k = count > detail::DELTA_LOOKAHEAD ? count - detail::DELTA_LOOKAHEAD : 0; k < count; ++k) {
+                const Pending & p = ring[k % detail::DELTA_LOOKAHEAD];
+                write(p.index, p.fields, p.vals);
+            }
+            return status;
+        }
+
+        // Decodes every entry, calling visit(index, fields, values) with the
+        // new values indexed by field.
+        template <class Visit>
+        DeltaStatus walk(Visit visit) const
+        {
+            detail::DeltaReader in(m_words.data() + detail::DELTA_HEADER_WORDS, m_bits);
+            uint64_t vals[NumFields];
+            uint64_t next = 0;
+            for (size_type k = 0; k < m_changes; ++k) {
+                uint64_t w, gap, flag, fields;
+                if (!in.get(detail::DELTA_GAP_WIDTH_BITS, w) || !in.get(w > 1 ? static_cast<int>(w) - 1 : 0, gap) ||
+                    !in.get(1, flag)) {
+                    return DeltaStatus::Corrupt;
+                }
+                gap = w > 1 ? gap | (static_cast<uint64_t>(1) << (w - 1)) : w;
+                if (gap >= m_records - next) {
+                    return DeltaStatus::Corrupt;
+                }
+                if (flag != 0) {
+                    if (!in.get(INDEX_BITS, fields) || fields >= static_cast<uint64_t>(NumFields)) {
+                        return DeltaStatus::Corrupt;
+                    }
+                    fields = static_cast<uint64_t>(1) << fields;
+                } else if (!in.get(NumFields, fields) || fields == 0) {
+                    return DeltaStatus::Corrupt;
+                }
+                for (uint64_t f = fields; f != 0; f &= f - 1) {
+                    const int idx = detail::countTrailingZeros(f);
+                    if (!in.get(Sizes::length(idx), vals[idx])) {
+                        return DeltaStatus::Corrupt;
+                    }
+                }
+                visit(static_cast<size_type>(next + gap), fields, vals);
+                next += gap + 1;
+            }
+            return in.atEnd() ? DeltaStatus::Ok : DeltaStatus::Corrupt;
+        }
+
+        std::vector<uint64_t> m_words;
+        uint64_t m_bits;
+        size_type m_records;
+        size_type m_changes;
+    };
+
+} // namespace cppbitfield
+
+#endif/*CPPBITFIELD_BITFIELD_DELTA_HPP*/
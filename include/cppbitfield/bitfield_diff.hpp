@@ -0,0 +1,328 @@
+/**
+ * \file bitfield_diff.hpp
+ * \date Oct 16, 2026
+ */
+
+#ifndef CPPBITFIELD_BITFIELD_DIFF_HPP
+#define CPPBITFIELD_BITFIELD_DIFF_HPP
+
+#include <cppbitfield/bitfield_predicate.hpp>
+#include <cppbitfield/bitfield_simd.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace cppbitfield {
+
+    namespace detail {
+
+        // Records compared per pass of the bulk diff; a multiple of 64 so
+        // every block starts on a bitmap word.
+        static const std::size_t DIFF_BLOCK = 1024;
+        static const std::size_t DIFF_BLOCK_WORDS = DIFF_BLOCK / 64;
+
+        template <class T>
+        inline uint64_t storageWord(const T & bits, int)
+        {
+            return static_cast<uint64_t>(bits);
+        }
+
+        template <int NumWords>
+        inline uint64_t storageWord(const WordArray<NumWords> & bits, int w)
+        {
+            return bits.words[w];
+        }
+
+        constexpr uint64_t orAll()
+        {
+            return 0;
+        }
+
+        template <class... Ts>
+        constexpr uint64_t orAll(uint64_t x, Ts... rest)
+        {
+            return x | orAll(rest...);
+        }
+
+        // Part of field [offset, offset + length) in storage word w, as a
+        // mask of that word; a field crossing a word boundary has a part in
+        // each word.
+        constexpr uint64_t laneBits(int offset, int length, int w)
+        {
+            return offset + length <= 64 * w || offset >= 64 * (w + 1) ? 0 :
+                   lowMask64((offset + length < 64 * (w + 1) ? offset + length : 64 * (w + 1)) -
+                             (offset > 64 * w ? offset : 64 * w)) << (offset > 64 * w ? offset - 64 * w : 0);
+        }
+
+        // Top bit of that part.
+        constexpr uint64_t laneTop(int offset, int length, int w)
+        {
+            return offset + length <= 64 * w || offset >= 64 * (w + 1) ? 0 :
+                   static_cast<uint64_t>(1) << (offset + length < 64 * (w + 1) ? offset + length - 1 - 64 * w : 63);
+        }
+
+        template <class Record, class Fields = typename MakeIndexSeq<Record::NumFields>::type>
+        struct DiffLanes;
+
+        template <class Record, int... Is>
+        struct DiffLanes<Record, IndexSeq<Is...> >
+        {
+            static constexpr uint64_t top(int w)
+            {
+                return orAll(laneTop(Record::template FieldOffset<Is>::value, Record::template FieldLength<Is>::value, w)...);
+            }
+
+            static constexpr uint64_t low(int w)
+            {
+                return orAll(laneBits(Record::template FieldOffset<Is>::value, Record::template FieldLength<Is>::value, w)...) & ~top(w);
+            }
+
+            // laneTop in word w of every field, by field index
+            static void fieldTops(int w, uint64_t * out)
+            {
+                const uint64_t tops[] = {
+                    laneTop(Record::template FieldOffset<Is>::value, Record::template FieldLength<Is>::value, w)...
+                };
+                std::memcpy(out, tops, sizeof(tops));
+            }
+        };
+
+        /**
+         * Field boundaries of Record as SWAR lanes, one set per storage word:
+         * TOP holds the top bit of every lane and LOW the others, where a
+         * lane is a field or its part in the word. Adding LOW to the XOR of
+         * two records restricted to LOW carries into the top bit of every
+         * lane with a difference below it, so
+         *   (((x & LOW) + LOW) | x) & TOP
+         * has one bit per changed lane, from compile-time masks. A table
+         * built once per record type turns each byte of that into the
+         * indices of the fields owning the lanes, so the change mask costs
+         * one lookup per storage byte whatever the field count or order,
+         * and nothing for an unchanged word.
+         */
+        template <class Record, class Words = typename MakeIndexSeq<(Record::NumBits + 63) / 64>::type>
+        struct DiffPlan;
+
+        template <class Record, int... Ws>
+        struct DiffPlan<Record, IndexSeq<Ws...> >
+        {
+            using StorageType = typename Record::StorageType;
+            using Lanes = DiffLanes<Record>;
+
+            static const int NumWords = sizeof...(Ws);
+            static const int WordBytes = sizeof(StorageType) < 8 ? static_cast<int>(sizeof(StorageType)) : 8;
+
+            static constexpr uint64_t LOW[sizeof...(Ws)] = { Lanes::low(Ws)... };
+            static constexpr uint64_t TOP[sizeof...(Ws)] = { Lanes::top(Ws)... };
+
+            uint64_t fields[NumWords][WordBytes][256];
+
+            DiffPlan()
+            {
+                uint64_t tops[Record::NumFields];
+                std::memset(fields, 0, sizeof(fields));
+                for (int w = 0; w < NumWords; ++w) {
+                    Lanes::fieldTops(w, tops);
+                    for (int f = 0; f < Record::NumFields; ++f) {
+                        for (int p = 0; p < WordBytes; ++p) {
+                            const int bit = static_cast<int>((tops[f] >> (8 * p)) & 0xFF);
+                            for (int v = 0; bit != 0 && v < 256; ++v) {
+                                if ((v & bit) != 0) {
+                                    fields[w][p][v] |= static_cast<uint64_t>(1) << f;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            static uint64_t changedLanes(const StorageType & a, const StorageType & b, int w)
+            {
+                const uint64_t x = storageWord(a, w) ^ storageWord(b, w);
+                return (((x & LOW[w]) + LOW[w]) | x) & TOP[w];
+            }
+
+            uint64_t changed(const StorageType & a, const StorageType & b) const
+            {
+                uint64_t mask = 0;
+                for (int w = 0; w < NumWords; ++w) {
+                    const uint64_t t = changedLanes(a, b, w);
+                    if (t != 0) {
+                        for (int p = 0; p < WordBytes; ++p) {
+                            mask |= fields[w][p][(t >> (8 * p)) & 0xFF];
+                        }
+                    }
+                }
+                return mask;
+            }
+
+            static const DiffPlan & get()
+            {
+                static const DiffPlan plan;
+                return plan;
+            }
+        };
+
+        template <class Record, int... Ws>
+        constexpr uint64_t DiffPlan<Record, IndexSeq<Ws...> >::LOW[sizeof...(Ws)];
+
+        template <class Record, int... Ws>
+        constexpr uint64_t DiffPlan<Record, IndexSeq<Ws...> >::TOP[sizeof...(Ws)];
+
+#if defined(CPPBITFIELD_HAS_SIMD)
+
+        namespace sse2 {
+
+#  define CPPBITFIELD_SIMD_FN inline CPPBITFIELD_TARGET("sse2")
+#  include <cppbitfield/detail/diff_kernels.inl>
+#  undef CPPBITFIELD_SIMD_FN
+
+        } // namespace sse2
+
+        namespace avx2 {
+
+#  define CPPBITFIELD_SIMD_FN inline CPPBITFIELD_TARGET("avx2")
+#  include <cppbitfield/detail/diff_kernels.inl>
+#  undef CPPBITFIELD_SIMD_FN
+
+        } // namespace avx2
+
+#  if defined(__GNUC__) && !defined(__clang__)
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#    pragma GCC diagnostic ignored "-Wuninitialized"
+#  endif
+
+        namespace avx512 {
+
+#  define CPPBITFIELD_SIMD_FN inline CPPBITFIELD_TARGET("avx512f")
+#  include <cppbitfield/detail/diff_kernels.inl>
+#  undef CPPBITFIELD_SIMD_FN
+
+        } // namespace avx512
+
+#  if defined(__GNUC__) && !defined(__clang__)
+#    pragma GCC diagnostic pop
+#  endif
+
+#endif/*defined(CPPBITFIELD_HAS_SIMD)*/
+
+        // One bit per differing record of a[0 .. n) and b[0 .. n) into
+        // words[0 .. (n + 63) / 64).
+        template <class T>
+        inline void differBlock(const T * a, const T * b, std::size_t n, uint64_t * words, SimdLevel level)
+        {
+            std::memset(words, 0, ((n + 63) / 64) * sizeof(uint64_t));
+            std::size_t done = 0;
+            switch (level) {
+#if defined(CPPBITFIELD_HAS_SIMD)
+              case SimdLevel::Avx512:
+                done = avx512::differ(a, b, n, words);
+                break;
+              case SimdLevel::Avx2:
+                done = avx2::differ(a, b, n, words);
+                break;
+              case SimdLevel::Sse2:
+                done = sse2::differ(a, b, n, words);
+                break;
+#endif
+              default:
+                break;
+            }
+            for (std::size_t i = done; i < n; ++i) {
+                words[i >> 6] |= static_cast<uint64_t>(a[i] != b[i]) << (i & 63);
+            }
+        }
+
+    } // namespace detail
+
+    /**
+     * A record that differs between two runs: its index and the mask of
+     * changed fields (bit i for field i).
+     */
+    struct FieldChange
+    {
+        uint32_t index;
+        uint64_t fields;
+    };
+
+    /**
+     * Mask of the fields that differ between `a` and `b`, bit i for field i:
+     * one XOR per storage word, a SWAR carry for every field at once and a
+     * table lookup per storage byte, with no loop over the fields.
+     */
+    template <class Record>
+    uint64_t diff(const Record & a, const Record & b)
+    {
+        static_assert(Record::NumFields <= 64, "Change masks hold at most 64 fields.");
+        return detail::DiffPlan<Record>::get().changed(a.bits(), b.bits());
+    }
+
+    namespace detail {
+
+        template <class Record>
+        std::size_t diffRecords(const Record * a, const Record * b, std::size_t n, FieldChange * out,
+                                SimdLevel level, std::false_type)
+        {
+            using StorageType = typename Record::StorageType;
+            const DiffPlan<Record> & plan = DiffPlan<Record>::get();
+            const StorageType * lhs = reinterpret_cast<const StorageType *>(a);
+            const StorageType * rhs = reinterpret_cast<const StorageType *>(b);
+            level = clampSimdLevel(level);
+
+            uint64_t words[DIFF_BLOCK_WORDS];
+            std::size_t count = 0;
+            for (std::size_t base = 0; base < n; base += DIFF_BLOCK) {
+                const std::size_t len = n - base < DIFF_BLOCK ? n - base : DIFF_BLOCK;
+                differBlock(lhs + base, rhs + base, len, words, level);
+                for (std::size_t w = 0; w < (len + 63) / 64; ++w) {
+                    for (uint64_t bits = words[w]; bits != 0; bits &= bits - 1) {
+                        const std::size_t i = base + 64 * w + countTrailingZeros(bits);
+                        const FieldChange c = { static_cast<uint32_t>(i), plan.changed(lhs[i], rhs[i]) };
+                        out[count++] = c;
+                    }
+                }
+            }
+            return count;
+        }
+
+        // multi-word records: no vector compare, the word loop of the plan
+        // already stops at the first unchanged record
+        template <class Record>
+        std::size_t diffRecords(const Record * a, const Record * b, std::size_t n, FieldChange * out,
+                                SimdLevel, std::true_type)
+        {
+            const DiffPlan<Record> & plan = DiffPlan<Record>::get();
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                const uint64_t fields = plan.changed(a[i].bits(), b[i].bits());
+                if (fields != 0) {
+                    const FieldChange c = { static_cast<uint32_t>(i), fields };
+                    out[count++] = c;
+                }
+            }
+            return count;
+        }
+
+    } // namespace detail
+
+    /**
+     * Compares a[0 .. n) with b[0 .. n) and writes a FieldChange for every
+     * record that differs, in index order, to `out`, which must have room
+     * for n entries; returns how many were written. Single-word records are
+     * compared with the widest SIMD level allowed and only differing records
+     * get a change mask.
+     */
+    template <class Record>
+    std::size_t diff(const Record * a, const Record * b, std::size_t n, FieldChange * out, SimdLevel level = simdLevel())
+    {
+        static_assert(Record::NumFields <= 64, "Change masks hold at most 64 fields.");
+        static_assert(sizeof(Record) == sizeof(typename Record::StorageType), "Records must be tightly packed.");
+        CPPBITFIELD_ASSERT("Too many records for 32-bit indices." && (n <= 0xFFFFFFFFu));
+        return detail::diffRecords(a, b, n, out, level, std::integral_constant<bool, (Record::NumBits > 64)>());
+    }
+
+} // namespace cppbitfield
+
+#endif/*CPPBITFIELD_BITFIELD_DIFF_HPP*/
@@ -0,0 +1,150 @@
+/**
+ * \file bitfield_endian.hpp
+ * \date Oct 16, 2026
+ */
+
+#ifndef CPPBITFIELD_BITFIELD_ENDIAN_HPP
+#define CPPBITFIELD_BITFIELD_ENDIAN_HPP
+
+#include <cppbitfield/bitfield.hpp>
+
+#include <cstring>
+
+#if defined(_MSC_VER)
+#  include <stdlib.h>
+#endif
+
+namespace cppbitfield {
+
+    namespace detail {
+
+        inline uint16_t byteSwap(uint16_t x)
+        {
+#if defined(__GNUC__)
+            return __builtin_bswap16(x);
+#elif defined(_MSC_VER)
+            return _byteswap_ushort(x);
+#else
+            return static_cast<uint16_t>((x >> 8) | (x << 8));
+#endif
+        }
+
+        inline uint32_t byteSwap(uint32_t x)
+        {
+#if defined(__GNUC__)
+            return __builtin_bswap32(x);
+#elif defined(_MSC_VER)
+            return _byteswap_ulong(x);
+#else
+            return (x >> 24) | ((x >> 8) & 0xFF00u) | ((x << 8) & 0xFF0000u) | (x << 24);
+#endif
+        }
+
+        inline uint64_t byteSwap(uint64_t x)
+        {
+#if defined(__GNUC__)
+            return __builtin_bswap64(x);
+#elif defined(_MSC_VER)
+            return _byteswap_uint64(x);
+#else
+            return (static_cast<uint64_t>(byteSwap(static_cast<uint32_t>(x))) << 32) |
+                   byteSwap(static_cast<uint32_t>(x >> 32));
+#endif
+        }
+
+        inline uint8_t byteSwap(uint8_t x)
+        {
+            return x;
+        }
+
+        // N-byte unaligned integer access. Power of two sizes are a single
+        // memcpy the compiler turns into one load/store (plus bswap when the
+        // byte order differs from the host); other sizes go byte by byte.
+        template <int N, bool BigEndian, bool Pow2 = (N == 1 || N == 2 || N == 4 || N == 8)>
+        struct UnalignedIO
+        {
+            static uint64_t load(const unsigned char * p)
+            {
+                uint64_t v = 0;
+                for (int i = 0; i < N; ++i) {
+                    v |= static_cast<uint64_t>(p[BigEndian ? N - 1 - i : i]) << (8 * i);
+                }
+                return v;
+            }
+
+            static void store(unsigned char * p, uint64_t v)
+            {
+                for (int i = 0; i < N; ++i) {
+                    p[BigEndian ? N - 1 - i : i] = static_cast<unsigned char>(v >> (8 * i));
+                }
+            }
+        };
+
+        template <int N, bool BigEndian>
+        struct UnalignedIO<N, BigEndian, true>
+        {
+            using T = typename UIntOfSize<N>::type;
+
+#if defined(CPPBITFIELD_HOST_BIG_ENDIAN)
+            static const bool Swap = !BigEndian;
+#else
+            static const bool Swap = BigEndian;
+#endif
+
+            static uint64_t load(const unsigned char * p)
+            {
+                T v;
+                std::memcpy(&v, p, N);
+                return Swap ? byteSwap(v) : v;
+            }
+
+            static void store(unsigned char * p, uint64_t v)
+            {
+                const T t = Swap ? byteSwap(static_cast<T>(v)) : static_cast<T>(v);
+                std::memcpy(p, &t, N);
+            }
+        };
+
+    } // namespace detail
+
+    /**
+     * Byte order policies for records stored in external byte buffers. A
+     * record of `size` bytes is one integer in that byte order; bit 0 is its
+     * least significant bit. position() maps `n` bytes starting at logical
+     * (least significant first) byte `first` to their physical address.
+     */
+    struct LittleEndian
+    {
+        static const bool IsBig = false;
+
+        template <int N>
+        static uint64_t load(const unsigned char * p) { return detail::UnalignedIO<N, false>::load(p); }
+
+        template <int N>
+        static void store(unsigned char * p, uint64_t v) { detail::UnalignedIO<N, false>::store(p, v); }
+
+        static constexpr int position(int, int first, int) { return first; }
+    };
+
+    struct BigEndian
+    {
+        static const bool IsBig = true;
+
+        template <int N>
+        static uint64_t load(const unsigned char * p) { return detail::UnalignedIO<N, true>::load(p); }
+
+        template <int N>
+        static void store(unsigned char * p, uint64_t v) { detail::UnalignedIO<N, true>::store(p, v); }
+
+        static constexpr int position(int size, int first, int n) { return size - first - n; }
+    };
+
+#if defined(CPPBITFIELD_HOST_BIG_ENDIAN)
+    using HostEndian = BigEndian;
+#else
+    using HostEndian = LittleEndian;
+#endif
+
+} // namespace cppbitfield
+
+#endif/*CPPBITFIELD_BITFIELD_ENDIAN_HPP*/
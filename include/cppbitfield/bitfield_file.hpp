@@ -0,0 +1,358 @@
+/**
+ * \file bitfield_file.hpp
+ * \date Oct 16, 2026
+ */
+
+#ifndef CPPBITFIELD_BITFIELD_FILE_HPP
+#define CPPBITFIELD_BITFIELD_FILE_HPP
+
+#include <cppbitfield/bitfield_array.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+// open, fstat, pread and 64-bit stdio offsets (fseeko/ftello)
+#  define CPPBITFIELD_HAS_POSIX_IO 1
+#  define CPPBITFIELD_HAS_MMAP 1
+#endif
+
+namespace cppbitfield {
+
+    enum class BitFieldFileStatus
+    {
+        Ok,
+        IoError,         // open, read, write or mmap failed
+        Unsupported,     // no mmap or POSIX file I/O on this platform
+        BadHeader,       // not a record file, other format version or byte order
+        LayoutMismatch,  // written with a different enum or BitFieldSizes
+        Truncated,       // shorter than the header claims
+        ChecksumMismatch // a streamed block does not match its checksum
+    };
+
+    enum class MapMode
+    {
+        ReadOnly,
+        CopyOnWrite // writable pages private to this mapping; the file is never modified
+    };
+
+    namespace detail {
+
+        constexpr uint64_t fingerprintMix(uint64_t h, uint64_t v)
+        {
+            return (h ^ v) * 0x100000001B3ULL;
+        }
+
+        template <class Sizes>
+        constexpr uint64_t fingerprintFields(uint64_t h, int idx)
+        {
+            return idx == Sizes::NumFields ? h :
+                   fingerprintFields<Sizes>(fingerprintMix(fingerprintMix(h, static_cast<uint64_t>(Sizes::offset(idx))),
+                                                           static_cast<uint64_t>(Sizes::length(idx))),
+                                            idx + 1);
+        }
+
+        const uint32_t BITFIELD_FILE_VERSION = 1;
+
+        // written in host order: reads back differently on a host of the
+        // other byte order, whose words would be misread
+        const uint32_t BITFIELD_FILE_BYTE_ORDER = 0x01020304;
+
+    } // namespace detail
+
+    /**
+     * Compile-time fingerprint of a record layout: the number of fields,
+     * the enum's underlying type, and the offset and length of every field
+     * (so bit order counts too). Enums that differ only in their names
+     * describe the same bits and share a fingerprint.
+     */
+    template <class EnumType, class Sizes>
+    struct LayoutFingerprint
+    {
+        using Record = BitFields<EnumType, Sizes>;
+
+        static constexpr uint64_t value =
+            detail::fingerprintFields<Sizes>(
+                detail::fingerprintMix(detail::fingerprintMix(detail::fingerprintMix(0xCBF29CE484222325ULL,
+                                                                                     Record::NumFields),
+                                                              sizeof(typename Record::IntType)),
+                                       Record::NumBits),
+                0);
+    };
+
+    template <class EnumType, class Sizes>
+    constexpr uint64_t LayoutFingerprint<EnumType, Sizes>::value;
+
+    /**
+     * On-disk header, followed at `headerSize` bytes by `numWords` host-order
+     * uint64_t words: the storage of a BitFieldArray, byte for byte.
+     */
+    struct BitFieldFileHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t headerSize;
+        uint64_t fingerprint;
+        uint32_t recordBits;
+        uint32_t byteOrder;
+        uint64_t numRecords;
+        uint64_t numWords;
+        uint64_t reserved[2];
+    };
+
+    static_assert(sizeof(BitFieldFileHeader) == 64, "Header keeps the payload 64-byte aligned.");
+
+    namespace detail {
+
+        const char BITFIELD_FILE_MAGIC[8] = { 'C', 'P', 'P', 'B', 'F', 'A', 'R', 'R' };
+
+        inline BitFieldFileStatus checkHeader(const BitFieldFileHeader & hdr, uint64_t fingerprint, int recordBits,
+                                              uint64_t fileSize)
+        {
+            if (std::memcmp(hdr.magic, BITFIELD_FILE_MAGIC, sizeof(hdr.magic)) != 0 ||
+                hdr.version != BITFIELD_FILE_VERSION || hdr.byteOrder != BITFIELD_FILE_BYTE_ORDER ||
+                hdr.headerSize < sizeof(BitFieldFileHeader) || hdr.headerSize % sizeof(uint64_t) != 0) {
+                return BitFieldFileStatus::BadHeader;
+            }
+            if (hdr.fingerprint != fingerprint || hdr.recordBits != static_cast<uint32_t>(recordBits)) {
+                return BitFieldFileStatus::LayoutMismatch;
+            }
+            if (hdr.numRecords > ~static_cast<uint64_t>(0) / static_cast<uint64_t>(recordBits) ||
+                hdr.numWords != wordsForBits(hdr.numRecords * recordBits)) {
+                return BitFieldFileStatus::BadHeader;
+            }
+            if (fileSize < hdr.headerSize || (fileSize - hdr.headerSize) / sizeof(uint64_t) < hdr.numWords) {
+                return BitFieldFileStatus::Truncated;
+            }
+            return BitFieldFileStatus::Ok;
+        }
+
+    } // namespace detail
+
+    /**
+     * Writes `arr` to `path`: a BitFieldFileHeader, then the packed words
+     * unchanged. Load it with MappedBitFieldArray.
+     */
+    template <class EnumType, class Sizes>
+    BitFieldFileStatus writeBitFieldArray(const char * path, const BitFieldArray<EnumType, Sizes> & arr)
+    {
+        BitFieldFileHeader hdr;
+        std::memset(&hdr, 0, sizeof(hdr));
+        std::memcpy(hdr.magic, detail::BITFIELD_FILE_MAGIC, sizeof(hdr.magic));
+        hdr.version = detail::BITFIELD_FILE_VERSION;
+        hdr.headerSize = sizeof(hdr);
+        hdr.fingerprint = LayoutFingerprint<EnumType, Sizes>::value;
+        hdr.recordBits = BitFieldArray<EnumType, Sizes>::NumBits;
+        hdr.byteOrder = detail::BITFIELD_FILE_BYTE_ORDER;
+        hdr.numRecords = arr.size();
+        hdr.numWords = arr.numWords();
+
+        std::FILE * f = std::fopen(path, "wb");
+        if (!f) {
+            return BitFieldFileStatus::IoError;
+        }
+        bool ok = std::fwrite(&hdr, sizeof(hdr), 1, f) == 1;
+        ok = ok && (arr.numWords() == 0 || std::fwrite(arr.words(), sizeof(uint64_t), arr.numWords(), f) == arr.numWords());
+        ok = (std::fclose(f) == 0) && ok;
+        return ok ? BitFieldFileStatus::Ok : BitFieldFileStatus::IoError;
+    }
+
+    /**
+     * Read-only or copy-on-write memory mapping of a file written by
+     * writeBitFieldArray, used in place: open() validates the 64-byte
+     * header and the records are then read straight from the page cache,
+     * with the same accessors as BitFieldArray. Opening a file written for
+     * another layout fails with LayoutMismatch before any record is read.
+     */
+    template <class EnumType, class Sizes>
+    class MappedBitFieldArray
+    {
+      public:
+        using value_type = BitFields<EnumType, Sizes>;
+        using size_type = std::size_t;
+        using StorageType = typename value_type::StorageType;
+        using ValueType = typename value_type::ValueType;
+
+        static const int NumBits = value_type::NumBits;
+
+        template <EnumType X>
+        using Field = detail::FieldPos<value_type, value_type::template AsInt<X>::value>;
+
+        MappedBitFieldArray() : m_base(nullptr), m_mapSize(0), m_words(nullptr), m_numWords(0), m_size(0), m_mode(MapMode::ReadOnly) { }
+
+        MappedBitFieldArray(const MappedBitFieldArray &) = delete;
+        MappedBitFieldArray & operator=(const MappedBitFieldArray &) = delete;
+
+        MappedBitFieldArray(MappedBitFieldArray && rhs) : MappedBitFieldArray()
+        {
+            swap(rhs);
+        }
+
+        MappedBitFieldArray & operator=(MappedBitFieldArray && rhs)
+        {
+            MappedBitFieldArray tmp(std::move(rhs));
+            swap(tmp);
+            return *this;
+        }
+
+        ~MappedBitFieldArray()
+        {
+            close();
+        }
+
+        BitFieldFileStatus open(const char * path, MapMode mode = MapMode::ReadOnly)
+        {
+            close();
+#if defined(CPPBITFIELD_HAS_MMAP)
+            const int fd = ::open(path, O_RDONLY);
+            if (fd < 0) {
+                return BitFieldFileStatus::IoError;
+            }
+            struct stat st;
+            if (::fstat(fd, &st) != 0) {
+                ::close(fd);
+                return BitFieldFileStatus::IoError;
+            }
+            const uint64_t fileSize = static_cast<uint64_t>(st.st_size);
+            if (fileSize < sizeof(BitFieldFileHeader)) {
+                ::close(fd);
+                return BitFieldFileStatus::BadHeader;
+            }
+
+            // the header alone decides before mapping anything
+            BitFieldFileHeader hdr;
+            if (::pread(fd, &hdr, sizeof(hdr), 0) != static_cast<ssize_t>(sizeof(hdr))) {
+                ::close(fd);
+                return BitFieldFileStatus::IoError;
+            }
+            const BitFieldFileStatus status =
+                detail::checkHeader(hdr, LayoutFingerprint<EnumType, Sizes>::value, NumBits, fileSize);
+            if (status != BitFieldFileStatus::Ok) {
+                ::close(fd);
+                return status;
+            }
+
+            const size_type mapSize = static_cast<size_type>(hdr.headerSize + hdr.numWords * sizeof(uint64_t));
+            const int prot = mode == MapMode::ReadOnly ? PROT_READ : (PROT_READ | PROT_WRITE);
+            void * base = ::mmap(nullptr, mapSize, prot, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (base == MAP_FAILED) {
+                return BitFieldFileStatus::IoError;
+            }
+            m_base = base;
+            m_mapSize = mapSize;
+            m_words = reinterpret_cast<uint64_t *>(static_cast<char *>(base) + hdr.headerSize);
+            m_numWords = static_cast<size_type>(hdr.numWords);
+            m_size = static_cast<size_type>(hdr.numRecords);
+            m_mode = mode;
+            return BitFieldFileStatus::Ok;
+#else
+            static_cast<void>(path);
+            static_cast<void>(mode);
+            return BitFieldFileStatus::Unsupported;
+#endif
+        }
+
+        void close()
+        {
+#if defined(CPPBITFIELD_HAS_MMAP)
+            if (m_base) {
+                ::munmap(m_base, m_mapSize);
+            }
+#endif
+            m_base = nullptr;
+            m_mapSize = 0;
+            m_words = nullptr;
+            m_numWords = 0;
+            m_size = 0;
+        }
+
+        bool isOpen() const { return m_base != nullptr; }
+
+        MapMode mode() const { return m_mode; }
+
+        size_type size() const { return m_size; }
+
+        bool empty() const { return m_size == 0; }
+
+        template <EnumType X, class Y = ValueType>
+        Y get(size_type i) const
+        {
+            CPPBITFIELD_ASSERT("Index out of bounds." && (i < m_size));
+            return static_cast<Y>(detail::ArrayField<NumBits, Field<X>::offset, Field<X>::length>::load(m_words, bitPos(i) + Field<X>::offset));
+        }
+
+        template <EnumType X, class Y>
+        void set(size_type i, Y val)
+        {
+            CPPBITFIELD_ASSERT("Mapping is read-only." && (m_mode == MapMode::CopyOnWrite));
+            CPPBITFIELD_ASSERT("Index out of bounds." && (i < m_size));
+            auto valtrunc = static_cast<uint64_t>(val) & detail::LowMask<uint64_t, Field<X>::length>::value;
+            CPPBITFIELD_ASSERT("Value too large for bitfield length." &&
+                               (static_cast<uint64_t>(val) == valtrunc));
+            detail::ArrayField<NumBits, Field<X>::offset, Field<X>::length>::store(m_words, bitPos(i) + Field<X>::offset, valtrunc);
+        }
+
+        template <EnumType X>
+        void set(size_type i, bool val)
+        {
+            set<X>(i, static_cast<uint64_t>(val ? 1 : 0));
+        }
+
+        value_type get(size_type i) const
+        {
+            CPPBITFIELD_ASSERT("Index out of bounds." && (i < m_size));
+            return value_type::fromBits(detail::RecordBits<StorageType, NumBits>::load(m_words, bitPos(i)));
+        }
+
+        void set(size_type i, const value_type & val)
+        {
+            CPPBITFIELD_ASSERT("Mapping is read-only." && (m_mode == MapMode::CopyOnWrite));
+            CPPBITFIELD_ASSERT("Index out of bounds." && (i < m_size));
+            detail::RecordBits<StorageType, NumBits>::store(m_words, bitPos(i), val.bits());
+        }
+
+        value_type operator[](size_type i) const { return get(i); }
+
+        const uint64_t * words() const { return m_words; }
+
+        size_type numWords() const { return m_numWords; }
+
+        size_type sizeInBytes() const { return m_numWords * sizeof(uint64_t); }
+
+        void swap(MappedBitFieldArray & rhs)
+        {
+            std::swap(m_base, rhs.m_base);
+            std::swap(m_mapSize, rhs.m_mapSize);
+            std::swap(m_words, rhs.m_words);
+            std::swap(m_numWords, rhs.m_numWords);
+            std::swap(m_size, rhs.m_size);
+            std::swap(m_mode, rhs.m_mode);
+        }
+
+      private:
+        static uint64_t bitPos(size_type i)
+        {
+            return static_cast<uint64_t>(i) * NumBits;
+        }
+
+        void * m_base;
+        size_type m_mapSize;
+        uint64_t * m_words;
+        size_type m_numWords;
+        size_type m_size;
+        MapMode m_mode;
+    };
+
+} // namespace cppbitfield
+
+#define DEFINE_MAPPED_BITFIELD_ARRAY(N, X, Y) \
+    using N = cppbitfield::MappedBitFieldArray<X, Y>
+
+#endif/*CPPBITFIELD_BITFIELD_FILE_HPP*/
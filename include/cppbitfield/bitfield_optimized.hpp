@@ -0,0 +1,500 @@
+/**
+ * \file bitfield_optimized.hpp
+ * \date Oct 16, 2026
+ */
+
+#ifndef CPPBITFIELD_BITFIELD_OPTIMIZED_HPP
+#define CPPBITFIELD_BITFIELD_OPTIMIZED_HPP
+
+#include <cppbitfield/bitfield.hpp>
+
+#include <climits>
+
+namespace cppbitfield {
+
+    /**
+     * Access hints for OptimizedLayout: the fields read or written most
+     * often, hottest first.
+     */
+    template <class EnumType, EnumType... Hot>
+    struct BitFieldHints { };
+
+    namespace detail {
+
+        // Boundary a hot field of `length` bits is placed on: the narrowest
+        // integer holding it, so it is a plain byte/word load and needs no
+        // shift beyond the word offset.
+        constexpr int naturalAlign(int length)
+        {
+            return length <= 8 ? 8 : length <= 16 ? 16 : length <= 32 ? 32 : 64;
+        }
+
+        constexpr int alignUp(int x, int align)
+        {
+            return (x + align - 1) / align * align;
+        }
+
+        // `start` rounded up to `align`, and to the next 64-bit word if the
+        // field would cross one there but must not
+        constexpr int placeFrom(int start, int length, int align, bool unsplit)
+        {
+            return unsplit && alignUp(start, align) / 64 != (alignUp(start, align) + length - 1) / 64 ?
+                   alignUp(start, 64) : alignUp(start, align);
+        }
+
+        // Bits of the StorageType chosen for a record of `numBits` bits.
+        constexpr int storageBits(int numBits)
+        {
+            return numBits <= 8 ? 8 : numBits <= 16 ? 16 : numBits <= 32 ? 32 : (numBits + 63) / 64 * 64;
+        }
+
+        constexpr int lesser(int a, int b)
+        {
+            return a < b ? a : b;
+        }
+
+        constexpr int maxOf(int a)
+        {
+            return a;
+        }
+
+        template <class... Ints>
+        constexpr int maxOf(int a, int b, Ints... rest)
+        {
+            return maxOf(a > b ? a : b, rest...);
+        }
+
+        constexpr int sumOf()
+        {
+            return 0;
+        }
+
+        template <class... Ints>
+        constexpr int sumOf(int a, Ints... rest)
+        {
+            return a + sumOf(rest...);
+        }
+
+        template <int... Hot>
+        struct HotSet
+        {
+            static const int Count = sizeof...(Hot);
+
+            // position of field `idx` in the hints, -1 if it is not hot
+            static constexpr int rank(int idx)
+            {
+                return rank(idx, 0, Hot...);
+            }
+
+            static constexpr bool valid(int numFields)
+            {
+                return valid(numFields, 0, Hot...);
+            }
+
+          private:
+            static constexpr int rank(int, int)
+            {
+                return -1;
+            }
+
+            template <class... Ints>
+            static constexpr int rank(int idx, int pos, int h, Ints... rest)
+            {
+                return h == idx ? pos : rank(idx, pos + 1, rest...);
+            }
+
+            static constexpr bool valid(int, int)
+            {
+                return true;
+            }
+
+            // in range and named once
+            template <class... Ints>
+            static constexpr bool valid(int numFields, int pos, int h, Ints... rest)
+            {
+                return h >= 0 && h < numFields && rank(h) == pos && valid(numFields, pos + 1, rest...);
+            }
+        };
+
+        // Field lengths, hint ranks and whether each field sits within one
+        // 64-bit word in the declared order, as tables, so that ordering the
+        // fields costs no more than a pass over them.
+        template <class Layout, class Hot, class Fields = typename MakeIndexSeq<Layout::NumFields>::type>
+        struct FieldTable;
+
+        template <class Layout, class Hot, int... Is>
+        struct FieldTable<Layout, Hot, IndexSeq<Is...> >
+        {
+            static const int NumFields = sizeof...(Is);
+            static constexpr int length[sizeof...(Is)] = { Layout::length(Is)... };
+            static constexpr int hotRank[sizeof...(Is)] = { Hot::rank(Is)... };
+            static constexpr bool whole[sizeof...(Is)] = {
+                (Layout::offset(Is) / 64 == (Layout::offset(Is) + Layout::length(Is) - 1) / 64)...
+            };
+        };
+
+        template <class Layout, class Hot, int... Is>
+        constexpr int FieldTable<Layout, Hot, IndexSeq<Is...> >::length[sizeof...(Is)];
+
+        template <class Layout, class Hot, int... Is>
+        constexpr int FieldTable<Layout, Hot, IndexSeq<Is...> >::hotRank[sizeof...(Is)];
+
+        template <class Layout, class Hot, int... Is>
+        constexpr bool FieldTable<Layout, Hot, IndexSeq<Is...> >::whole[sizeof...(Is)];
+
+        // cold fields placed before cold field `idx`
+        template <class Table>
+        constexpr int coldRank(int idx, int j = 0)
+        {
+            return j == Table::NumFields ? 0 :
+                   (Table::hotRank[j] < 0 && (Table::length[j] > Table::length[idx] ||
+                                              (Table::length[j] == Table::length[idx] && j < idx))) +
+                   coldRank<Table>(idx, j + 1);
+        }
+
+        /**
+         * Placement order of a layout: the hot fields in hint order, then the
+         * others by decreasing length (declaration order among equal
+         * lengths), so power-of-two sized fields fall on their own
+         * boundaries.
+         */
+        template <class Table, int HotCount, class Fields = typename MakeIndexSeq<Table::NumFields>::type>
+        struct FieldOrder;
+
+        template <class Table, int HotCount, int... Is>
+        struct FieldOrder<Table, HotCount, IndexSeq<Is...> >
+        {
+            static const int NumFields = sizeof...(Is);
+            static constexpr int position[sizeof...(Is)] = {
+                (Table::hotRank[Is] >= 0 ? Table::hotRank[Is] : HotCount + coldRank<Table>(Is))...
+            };
+        };
+
+        template <class Table, int HotCount, int... Is>
+        constexpr int FieldOrder<Table, HotCount, IndexSeq<Is...> >::position[sizeof...(Is)];
+
+        template <class Order>
+        constexpr int fieldAtPosition(int pos, int idx = 0)
+        {
+            return Order::position[idx] == pos ? idx : fieldAtPosition<Order>(pos, idx + 1);
+        }
+
+        // Order of a layout with its first `Aligned` hot fields, and its cold
+        // fields if `ColdAligned`, naturally aligned.
+        template <class Layout, class Hot, int Aligned, bool ColdAligned,
+                  class Fields = typename MakeIndexSeq<Layout::NumFields>::type>
+        struct LayoutPlan;
+
+        template <class Layout, class Hot, int Aligned, bool ColdAligned, int... Is>
+        struct LayoutPlan<Layout, Hot, Aligned, ColdAligned, IndexSeq<Is...> >
+        {
+            using Table = FieldTable<Layout, Hot>;
+            using Order = FieldOrder<Table, Hot::Count>;
+
+            static constexpr int fieldAt[sizeof...(Is)] = { fieldAtPosition<Order>(Is)... };
+
+            static constexpr int position(int idx)
+            {
+                return Order::position[idx];
+            }
+
+            static constexpr int length(int pos)
+            {
+                return Table::length[fieldAt[pos]];
+            }
+
+            static constexpr int align(int pos)
+            {
+                return pos < Aligned || (ColdAligned && pos >= Hot::Count) ? naturalAlign(length(pos)) : 1;
+            }
+
+            // the field must not be moved across a word boundary
+            static constexpr bool unsplit(int pos)
+            {
+                return Table::whole[fieldAt[pos]];
+            }
+        };
+
+        template <class Layout, class Hot, int Aligned, bool ColdAligned, int... Is>
+        constexpr int LayoutPlan<Layout, Hot, Aligned, ColdAligned, IndexSeq<Is...> >::fieldAt[sizeof...(Is)];
+
+        template <class Plan, int Pos>
+        struct Placement;
+
+        // The fields placed before position Q.
+        template <class Plan, int Q>
+        struct Placed
+        {
+            using Last = Placement<Plan, Q - 1>;
+
+            static constexpr bool free(int begin, int end)
+            {
+                return (end <= Last::offset || begin >= Last::end) && Placed<Plan, Q - 1>::free(begin, end);
+            }
+
+            // placeFrom(start) if a field fits there, INT_MAX otherwise
+            static constexpr int fit(int start, int length, int align, bool unsplit)
+            {
+                return free(placeFrom(start, length, align, unsplit), placeFrom(start, length, align, unsplit) + length) ?
+                       placeFrom(start, length, align, unsplit) : INT_MAX;
+            }
+
+            // lowest fit in All at 0 or at the end of one of these fields
+            template <class All>
+            static constexpr int firstFit(int length, int align, bool unsplit)
+            {
+                return lesser(All::fit(Last::end, length, align, unsplit),
+                              Placed<Plan, Q - 1>::template firstFit<All>(length, align, unsplit));
+            }
+        };
+
+        template <class Plan>
+        struct Placed<Plan, 0>
+        {
+            static constexpr bool free(int, int)
+            {
+                return true;
+            }
+
+            static constexpr int fit(int start, int length, int align, bool unsplit)
+            {
+                return placeFrom(start, length, align, unsplit);
+            }
+
+            template <class All>
+            static constexpr int firstFit(int length, int align, bool unsplit)
+            {
+                return All::fit(0, length, align, unsplit);
+            }
+        };
+
+        /**
+         * Field placed `Pos`-th: the lowest offset, on its alignment and not
+         * splitting it across a word it was whole in, that does not overlap
+         * the fields placed before it. That offset is either 0 or the end of
+         * one of those fields rounded up, so only those candidates are tried.
+         */
+        template <class Plan, int Pos>
+        struct Placement
+        {
+            static const int length = Plan::length(Pos);
+            static const int align = Plan::align(Pos);
+            static const int offset =
+                Placed<Plan, Pos>::template firstFit<Placed<Plan, Pos> >(length, align, Plan::unsplit(Pos));
+            static const int end = offset + length;
+        };
+
+        template <class Layout, class Hot, int Aligned, bool ColdAligned,
+                  class Fields = typename MakeIndexSeq<Layout::NumFields>::type>
+        struct PlacedLayout;
+
+        template <class Layout, class Hot, int Aligned, bool ColdAligned, int... Is>
+        struct PlacedLayout<Layout, Hot, Aligned, ColdAligned, IndexSeq<Is...> >
+        {
+            using Plan = LayoutPlan<Layout, Hot, Aligned, ColdAligned>;
+
+            template <int Idx>
+            using Place = Placement<Plan, Plan::position(Idx)>;
+
+            static const int NumBits = maxOf(0, Place<Is>::end...);
+
+            static const int NumAligned = Aligned;
+
+            static constexpr int offset[sizeof...(Is)] = { Place<Is>::offset... };
+        };
+
+        template <class Layout, class Hot, int Aligned, bool ColdAligned, int... Is>
+        constexpr int PlacedLayout<Layout, Hot, Aligned, ColdAligned, IndexSeq<Is...> >::offset[sizeof...(Is)];
+
+        // The declared order, when no reordering fits its StorageType.
+        template <class Layout, class Fields = typename MakeIndexSeq<Layout::NumFields>::type>
+        struct DeclaredLayout;
+
+        template <class Layout, int... Is>
+        struct DeclaredLayout<Layout, IndexSeq<Is...> >
+        {
+            template <int Idx>
+            struct Place
+            {
+                static const int offset = Layout::offset(Idx);
+            };
+
+            static const int NumBits = Layout::NumBits;
+
+            static const int NumAligned = 0;
+
+            static constexpr int offset[sizeof...(Is)] = { Layout::offset(Is)... };
+        };
+
+        template <class Layout, int... Is>
+        constexpr int DeclaredLayout<Layout, IndexSeq<Is...> >::offset[sizeof...(Is)];
+
+        template <class Sizes, class Hot, int Aligned = Hot::Count, bool ColdAligned = true>
+        struct ChosenLayout;
+
+        template <class Sizes, class Hot, int Aligned, bool ColdAligned, bool Fits>
+        struct ChosenLayoutIf
+        {
+            using type = PlacedLayout<Sizes, Hot, Aligned, ColdAligned>;
+        };
+
+        template <class Sizes, class Hot, int Aligned, bool ColdAligned>
+        struct ChosenLayoutIf<Sizes, Hot, Aligned, ColdAligned, false>
+        {
+            using type = typename ChosenLayout<Sizes, Hot, ColdAligned ? Aligned : Aligned - 1, !ColdAligned>::type;
+        };
+
+        // First placement without a wider StorageType than the declared
+        // order: cold fields lose their alignment before any hot field does,
+        // then the coldest hot fields lose theirs one at a time.
+        template <class Sizes, class Hot, int Aligned, bool ColdAligned>
+        struct ChosenLayout
+        {
+            using type = typename ChosenLayoutIf<Sizes, Hot, Aligned, ColdAligned,
+                storageBits(PlacedLayout<Sizes, Hot, Aligned, ColdAligned>::NumBits) == storageBits(Sizes::NumBits)>::type;
+        };
+
+        template <class Sizes, class Hot>
+        struct ChosenLayout<Sizes, Hot, -1, true>
+        {
+            using type = DeclaredLayout<Sizes>;
+        };
+
+        template <class Sizes, class Hints>
+        struct HotSetOf;
+
+        template <class Sizes, class EnumType, EnumType... Hot>
+        struct HotSetOf<Sizes, BitFieldHints<EnumType, Hot...> >
+        {
+            using type = HotSet<static_cast<int>(Hot)...>;
+        };
+
+    } // namespace detail
+
+    /**
+     * Sizes type that keeps the declared fields but chooses where they sit:
+     * hot fields (Hints) go first, each on the boundary of the narrowest
+     * integer that holds it, and the remaining fields fill the gaps this
+     * leaves, longest first and on their own boundaries too. Alignment is
+     * dropped from the cold fields, then from the coldest hot fields, until
+     * the record needs no wider StorageType than the declared order. A field
+     * that lies within one 64-bit word in the declared order is never placed
+     * across one, and if no order passes both tests the declared one is
+     * kept. The field enum and every accessor are unchanged, so the layout
+     * can be swapped in for a BitFieldSizes anywhere. Gaps left between
+     * fields count towards NumBits and are not checked by fromBits.
+     */
+    template <class Sizes, class Hints>
+    struct OptimizedLayout
+    {
+      private:
+        using Hot = typename detail::HotSetOf<Sizes, Hints>::type;
+
+        static_assert(std::is_same<typename Sizes::BitOrder, LsbFirst>::value,
+                      "A layout with a fixed bit order cannot be reordered.");
+        static_assert(Hot::valid(Sizes::NumFields), "Hints must name distinct fields of the layout.");
+
+        using Placed = typename detail::ChosenLayout<Sizes, Hot>::type;
+
+      public:
+        using BitOrder = LsbFirst;
+
+        static const int NumFields = Sizes::NumFields;
+
+        static const int NumBits = Placed::NumBits;
+
+        // total length of the fields: NumBits less the gaps between them
+        static const int PackedBits = Sizes::NumBits;
+
+        // leading hot fields that ended up on their natural boundary
+        static const int NumAligned = Placed::NumAligned;
+
+        template <int Idx>
+        struct Get
+        {
+            static_assert(Idx >= 0 && Idx < NumFields, "Index out of bounds.");
+            static const int value = Sizes::template Get<Idx>::value;
+        };
+
+        template <int Idx>
+        struct SumTill
+        {
+            static_assert(Idx >= 0 && Idx < NumFields, "Index out of bounds.");
+            static const int value = Placed::template Place<Idx>::offset;
+        };
+
+        static constexpr int length(int idx)
+        {
+            return Sizes::length(idx);
+        }
+
+        static constexpr int offset(int idx)
+        {
+            return Placed::offset[idx];
+        }
+    };
+
+    template <class EnumType, class Sizes, class Hints = BitFieldHints<EnumType> >
+    using OptimizedBitFields = BitFields<EnumType, OptimizedLayout<Sizes, Hints> >;
+
+    namespace detail {
+
+        // Lets DEFINE_OPTIMIZED_BITFIELDS take the sizes and any hot fields
+        // as one argument list, without the GNU comma elision.
+        template <class EnumType>
+        struct OptimizedFor
+        {
+            template <class Sizes, EnumType... Hot>
+            using With = OptimizedBitFields<EnumType, Sizes, BitFieldHints<EnumType, Hot...> >;
+        };
+
+    } // namespace detail
+
+    /**
+     * Where the fields of a record ended up, e.g.
+     * `static_assert(FieldLayout<Rec>::Field<RecEnum::Kind>::byteAligned, "")`
+     * to pin down what OptimizedLayout chose.
+     */
+    template <class Record>
+    struct FieldLayout
+    {
+      private:
+        template <class Seq>
+        struct Used;
+
+        template <int... Is>
+        struct Used<detail::IndexSeq<Is...> >
+        {
+            static const int value = detail::sumOf(Record::template FieldLength<Is>::value...);
+        };
+
+      public:
+        static const int NumBits = Record::NumBits;
+
+        // bits of Record::StorageType
+        static const int StorageBits = detail::storageBits(NumBits);
+
+        static const int UsedBits = Used<typename detail::MakeIndexSeq<Record::NumFields>::type>::value;
+
+        // bits between fields and above the last one up to NumBits
+        static const int GapBits = NumBits - UsedBits;
+
+        template <typename Record::FieldEnum X>
+        struct Field
+        {
+            static const int offset = Record::template FieldOffset<Record::template AsInt<X>::value>::value;
+            static const int length = Record::template FieldLength<Record::template AsInt<X>::value>::value;
+            static const bool byteAligned = offset % 8 == 0;
+            // on the boundary of the narrowest integer that holds it
+            static const bool naturallyAligned = offset % detail::naturalAlign(length) == 0;
+            static const bool straddlesWord = offset / 64 != (offset + length - 1) / 64;
+        };
+    };
+
+} // namespace cppbitfield
+
+// DEFINE_OPTIMIZED_BITFIELDS(N, X, Y, hot fields...)
+#define DEFINE_OPTIMIZED_BITFIELDS(N, X, ...) \
+    using N = cppbitfield::detail::OptimizedFor<X>::template With<__VA_ARGS__>
+
+#endif/*CPPBITFIELD_BITFIELD_OPTIMIZED_HPP*/
@@ -0,0 +1,408 @@
+/**
+ * \file bitfield_parallel.hpp
+ * \date Oct 16, 2026
+ */
+
+#ifndef CPPBITFIELD_BITFIELD_PARALLEL_HPP
+#define CPPBITFIELD_BITFIELD_PARALLEL_HPP
+
+#include <cppbitfield/bitfield_array.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cppbitfield {
+
+    namespace detail {
+
+        // Fewest records worth handing to another thread.
+        static const std::size_t PARALLEL_MIN_PER_THREAD = static_cast<std::size_t>(1) << 18;
+
+        // Number of slices [0, n) is cut into for `threads` (0: one per
+        // hardware thread), never giving a thread fewer than
+        // PARALLEL_MIN_PER_THREAD records.
+        inline std::size_t numSlices(std::size_t n, unsigned threads)
+        {
+            if (threads == 0) {
+                threads = std::max(1u, std::thread::hardware_concurrency());
+            }
+            return std::min<std::size_t>(threads, std::max<std::size_t>(1, n / PARALLEL_MIN_PER_THREAD));
+        }
+
+        /**
+         * Runs fn(begin, end, parts[t]) over parts.size() contiguous slices
+         * of [0, n), one thread per slice. Slices start on a multiple of 64
+         * records and the same n and slice count always give the same
+         * slices. The calling thread takes the first slice.
+         */
+        template <class Partial, class Fn>
+        void forEachSlice(std::size_t n, std::vector<Partial> & parts, Fn fn)
+        {
+            const std::size_t count = parts.size();
+            const std::size_t slice = ((n + count - 1) / count + 63) & ~static_cast<std::size_t>(63);
+            std::vector<std::thread> pool;
+            for (std::size_t t = 1; t < count; ++t) {
+                const std::size_t begin = std::min(n, t * slice);
+                const std::size_t end = std::min(n, begin + slice);
+                pool.push_back(std::thread([&fn, &parts, t, begin, end]() { fn(begin, end, parts[t]); }));
+            }
+            fn(0, std::min(n, slice), parts[0]);
+            for (std::size_t t = 0; t < pool.size(); ++t) {
+                pool[t].join();
+            }
+        }
+
+        // As above with numSlices(n, threads) slices starting from `init`;
+        // returns the partials in slice order.
+        template <class Partial, class Fn>
+        std::vector<Partial> forEachSlice(std::size_t n, unsigned threads, const Partial & init, Fn fn)
+        {
+            std::vector<Partial> parts(numSlices(n, threads), init);
+            forEachSlice(n, parts, fn);
+            return parts;
+        }
+
+        // Bits per cache line: chunks handed to different threads never
+        // write the same line, let alone the same word.
+        static const int CACHE_LINE_BITS = 512;
+
+        // Fewest records in a ThreadPool task of the parallel algorithms.
+        static const std::size_t PARALLEL_MIN_PER_TASK = static_cast<std::size_t>(1) << 14;
+
+        // Tasks per thread: enough for stealing to even out uneven records
+        // or threads, few enough that scheduling stays negligible.
+        static const std::size_t PARALLEL_TASKS_PER_THREAD = 4;
+
+        inline std::size_t gcd(std::size_t a, std::size_t b)
+        {
+            while (b != 0) {
+                const std::size_t t = a % b;
+                a = b;
+                b = t;
+            }
+            return a;
+        }
+
+        /**
+         * Chunk boundaries for `n` records of `numBits` bits packed back to
+         * back from `base` (8-byte aligned), about `tasks` chunks of at least
+         * `minRecords`. Every inner boundary starts a cache line when some
+         * record does, and a word otherwise, so two chunks never write the
+         * same word. Returns the tasks + 1 boundaries, first 0 and last n.
+         */
+        inline std::vector<std::size_t> packedChunks(const void * base, int numBits, std::size_t n,
+                                                     std::size_t tasks, std::size_t minRecords)
+        {
+            const std::size_t bits = static_cast<std::size_t>(numBits);
+            // records between consecutive records starting a line
+            const std::size_t period = CACHE_LINE_BITS / gcd(bits, CACHE_LINE_BITS);
+            const std::size_t baseBits = (reinterpret_cast<uintptr_t>(base) % (CACHE_LINE_BITS / 8)) * 8;
+            std::size_t first = 0;
+            while (first < period && (baseBits + first * bits) % CACHE_LINE_BITS != 0) {
+                ++first;
+            }
+            if (first == period) {
+                first = 0; // no record starts a line; the base is word aligned
+            }
+            std::size_t chunk = std::max(minRecords, (n + tasks - 1) / std::max<std::size_t>(tasks, 1));
+            chunk = (chunk + period - 1) / period * period;
+
+            std::vector<std::size_t> bounds(1, 0);
+            for (std::size_t b = first; b < n; b += chunk) {
+                if (b > 0) {
+                    bounds.push_back(b);
+                }
+            }
+            bounds.push_back(n);
+            return bounds;
+        }
+
+        template <class T>
+        inline bool sameBits(const T & a, const T & b)
+        {
+            return std::memcmp(&a, &b, sizeof(T)) == 0;
+        }
+
+    } // namespace detail
+
+    /**
+     * Work-stealing thread pool for the parallel algorithms below. run()
+     * splits its tasks into one contiguous block per thread; each thread
+     * works through its own block front to back and, once it runs dry,
+     * steals from the back of another. The thread calling run() works
+     * alongside the pool's threads until every task has finished, so a
+     * pool of `threads` keeps threads - 1 workers and run() may be called
+     * from inside a task.
+     */
+    class ThreadPool
+    {
+      public:
+        // 0: one thread per hardware thread
+        explicit ThreadPool(unsigned threads = 0)
+          : m_stop(false), m_queued(0)
+        {
+            if (threads == 0) {
+                threads = std::max(1u, std::thread::hardware_concurrency());
+            }
+            for (unsigned t = 0; t < threads; ++t) {
+                m_queues.push_back(std::unique_ptr<Queue>(new Queue()));
+            }
+            for (unsigned t = 1; t < threads; ++t) {
+                m_workers.push_back(std::thread([this, t]() { work(t); }));
+            }
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool & operator=(const ThreadPool &) = delete;
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_sleep);
+                m_stop = true;
+            }
+            m_wake.notify_all();
+            for (std::size_t t = 0; t < m_workers.size(); ++t) {
+                m_workers[t].join();
+            }
+        }
+
+        // threads running tasks, the caller of run() included
+        unsigned concurrency() const
+        {
+            return static_cast<unsigned>(m_queues.size());
+        }
+
+        /**
+         * Calls fn(i) for every i in [0, numTasks) and returns when all
+         * calls have returned.
+         */
+        template <class Fn>
+        void run(std::size_t numTasks, Fn fn)
+        {
+            if (numTasks <= 1 || m_queues.size() == 1) {
+                for (std::size_t i = 0; i < numTasks; ++i) {
+                    fn(i);
+                }
+                return;
+            }
+            Job job(&call<Fn>, &fn, numTasks);
+            const std::size_t q = m_queues.size();
+            for (std::size_t t = 0; t < q; ++t) {
+                std::lock_guard<std::mutex> lock(m_queues[t]->mutex);
+                for (std::size_t i = t * numTasks / q; i < (t + 1) * numTasks / q; ++i) {
+                    m_queues[t]->tasks.push_back(Task(&job, i));
+                }
+            }
+            {
+                std::lock_guard<std::mutex> lock(m_sleep);
+                m_queued.fetch_add(numTasks);
+            }
+            m_wake.notify_all();
+
+            const std::size_t own = self().pool == this ? self().index : 0;
+            while (job.remaining.load(std::memory_order_acquire) != 0) {
+                Task task;
+                if (take(own, task)) {
+                    execute(task);
+                }
+                else {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        // Pool shared by the parallel algorithms when none is given.
+        static ThreadPool & shared()
+        {
+            static ThreadPool pool;
+            return pool;
+        }
+
+      private:
+        struct Job
+        {
+            void (*fn)(void *, std::size_t);
+            void * ctx;
+            std::atomic<std::size_t> remaining;
+
+            Job(void (*f)(void *, std::size_t), void * c, std::size_t n) : fn(f), ctx(c), remaining(n) { }
+        };
+
+        struct Task
+        {
+            Job * job;
+            std::size_t index;
+
+            Task() : job(nullptr), index(0) { }
+            Task(Job * j, std::size_t i) : job(j), index(i) { }
+        };
+
+        struct Queue
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+            // keeps neighbouring queues' locks off this cache line
+            char pad[64];
+        };
+
+        struct Slot
+        {
+            const ThreadPool * pool;
+            std::size_t index;
+        };
+
+        template <class Fn>
+        static void call(void * fn, std::size_t i)
+        {
+            (*static_cast<Fn *>(fn))(i);
+        }
+
+        static Slot & self()
+        {
+            static thread_local Slot slot = { nullptr, 0 };
+            return slot;
+        }
+
+        // front of queue `own`, else the back of the first other queue with work
+        bool take(std::size_t own, Task & task)
+        {
+            const std::size_t q = m_queues.size();
+            for (std::size_t k = 0; k < q; ++k) {
+                Queue & queue = *m_queues[(own + k) % q];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (!queue.tasks.empty()) {
+                    if (k == 0) {
+                        task = queue.tasks.front();
+                        queue.tasks.pop_front();
+                    }
+                    else {
+                        task = queue.tasks.back();
+                        queue.tasks.pop_back();
+                    }
+                    m_queued.fetch_sub(1);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        static void execute(const Task & task)
+        {
+            task.job->fn(task.job->ctx, task.index);
+            task.job->remaining.fetch_sub(1, std::memory_order_release);
+        }
+
+        void work(std::size_t index)
+        {
+            self().pool = this;
+            self().index = index;
+            for (;;) {
+                Task task;
+                if (take(index, task)) {
+                    execute(task);
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(m_sleep);
+                m_wake.wait(lock, [this]() { return m_stop || m_queued.load() != 0; });
+                if (m_stop) {
+                    return;
+                }
+            }
+        }
+
+        std::vector<std::unique_ptr<Queue> > m_queues;
+        std::vector<std::thread> m_workers;
+        std::mutex m_sleep;
+        std::condition_variable m_wake;
+        bool m_stop;
+        std::atomic<std::size_t> m_queued;
+    };
+
+    /**
+     * Calls fn(rec) on a copy of every record of `arr` and writes back the
+     * records fn changed, e.g. clearing a flag where State == 2. Records
+     * are processed in parallel chunks on `pool`; chunk boundaries fall on
+     * cache lines of the packed words, so threads never write to the same
+     * word or line.
+     */
+    template <class EnumType, class Sizes, class Fn>
+    void parallelForEach(BitFieldArray<EnumType, Sizes> & arr, Fn fn, ThreadPool & pool = ThreadPool::shared())
+    {
+        using Array = BitFieldArray<EnumType, Sizes>;
+        const std::vector<std::size_t> bounds =
+            detail::packedChunks(arr.words(), Array::NumBits, arr.size(),
+                                 pool.concurrency() * detail::PARALLEL_TASKS_PER_THREAD, detail::PARALLEL_MIN_PER_TASK);
+        pool.run(bounds.size() - 1, [&arr, &bounds, &fn](std::size_t c) {
+            for (std::size_t i = bounds[c]; i < bounds[c + 1]; ++i) {
+                typename Array::value_type rec = arr.get(i);
+                const typename Array::StorageType before = rec.bits();
+                fn(rec);
+                if (!detail::sameBits(before, rec.bits())) {
+                    arr.set(i, rec);
+                }
+            }
+        });
+    }
+
+    // fn(recs[i]) in place for unpacked records.
+    template <class Record, class Fn>
+    void parallelForEach(Record * recs, std::size_t n, Fn fn, ThreadPool & pool = ThreadPool::shared())
+    {
+        const std::vector<std::size_t> bounds =
+            detail::packedChunks(recs, 8 * static_cast<int>(sizeof(Record)), n,
+                                 pool.concurrency() * detail::PARALLEL_TASKS_PER_THREAD, detail::PARALLEL_MIN_PER_TASK);
+        pool.run(bounds.size() - 1, [recs, &bounds, &fn](std::size_t c) {
+            for (std::size_t i = bounds[c]; i < bounds[c + 1]; ++i) {
+                fn(recs[i]);
+            }
+        });
+    }
+
+    /**
+     * out[i] = fn(in[i]) for every record of `in`; `out` is resized to
+     * match and may hold a different record type. Chunks are aligned on
+     * the words of `out`, the only array written.
+     */
+    template <class EnumType, class Sizes, class OutEnum, class OutSizes, class Fn>
+    void parallelTransform(const BitFieldArray<EnumType, Sizes> & in, BitFieldArray<OutEnum, OutSizes> & out, Fn fn,
+                           ThreadPool & pool = ThreadPool::shared())
+    {
+        using Out = BitFieldArray<OutEnum, OutSizes>;
+        out.resize(in.size());
+        const std::vector<std::size_t> bounds =
+            detail::packedChunks(out.words(), Out::NumBits, in.size(),
+                                 pool.concurrency() * detail::PARALLEL_TASKS_PER_THREAD, detail::PARALLEL_MIN_PER_TASK);
+        pool.run(bounds.size() - 1, [&in, &out, &bounds, &fn](std::size_t c) {
+            for (std::size_t i = bounds[c]; i < bounds[c + 1]; ++i) {
+                out.set(i, static_cast<typename Out::value_type>(fn(in.get(i))));
+            }
+        });
+    }
+
+    // out[i] = fn(in[i]) for unpacked records; `out` holds n records.
+    template <class Record, class OutRecord, class Fn>
+    void parallelTransform(const Record * in, std::size_t n, OutRecord * out, Fn fn,
+                           ThreadPool & pool = ThreadPool::shared())
+    {
+        const std::vector<std::size_t> bounds =
+            detail::packedChunks(out, 8 * static_cast<int>(sizeof(OutRecord)), n,
+                                 pool.concurrency() * detail::PARALLEL_TASKS_PER_THREAD, detail::PARALLEL_MIN_PER_TASK);
+        pool.run(bounds.size() - 1, [in, out, &bounds, &fn](std::size_t c) {
+            for (std::size_t i = bounds[c]; i < bounds[c + 1]; ++i) {
+                out[i] = fn(in[i]);
+            }
+        });
+    }
+
+} // namespace cppbitfield
+
+#endif/*CPPBITFIELD_BITFIELD_PARALLEL_HPP*/
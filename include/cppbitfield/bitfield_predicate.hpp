@@ -0,0 +1,520 @@
+/**
+ * \file bitfield_predicate.hpp
+ * \date Oct 16, 2026
+ */
+
+#ifndef CPPBITFIELD_BITFIELD_PREDICATE_HPP
+#define CPPBITFIELD_BITFIELD_PREDICATE_HPP
+
+#include <cppbitfield/bitfield_simd.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#if defined(_MSC_VER)
+#  include <intrin.h>
+#endif
+
+namespace cppbitfield {
+
+    namespace detail {
+
+        struct PredicateBase { };
+
+        template <class T>
+        struct IsPredicate : std::is_base_of<PredicateBase, T> { };
+
+        // Records evaluated per pass of a predicate tree; a multiple of 64 so
+        // every block starts on a bitmap word.
+        static const std::size_t PREDICATE_BLOCK = 1024;
+        static const std::size_t PREDICATE_BLOCK_WORDS = PREDICATE_BLOCK / 64;
+
+        /**
+         * A conjunction of field tests folded into a fixed shape:
+         *   (bits & eqMask) == eqValue            equality and single bit terms
+         *   lanes of maskA below constA          x < c terms, one SWAR compare
+         *   constB below lanes of maskB          c < x terms, one SWAR compare
+         *   (bits & anyMask[k]) != anyValue[k]   multi-bit mask terms
+         * A lane is a whole field; topA/topB hold the top bit of each lane.
+         */
+        template <int NumAny>
+        struct ConjTest
+        {
+            uint64_t eqMask, eqValue;
+            uint64_t maskA, constA, topA;
+            uint64_t maskB, constB, topB;
+            uint64_t anyMask[NumAny + 1], anyValue[NumAny + 1];
+            bool never;
+        };
+
+        template <int NumAny>
+        inline ConjTest<NumAny> emptyConj()
+        {
+            ConjTest<NumAny> ret;
+            std::memset(&ret, 0, sizeof(ret));
+            return ret;
+        }
+
+        // Top bit of every lane in which x is below y; x and y are zero
+        // outside the lanes. Adding the top bits first keeps the borrow of
+        // the subtraction inside each lane.
+        inline uint64_t swarBorrow(uint64_t x, uint64_t y, uint64_t top)
+        {
+            const uint64_t d = ((x | top) - (y & ~top)) ^ ((x ^ ~y) & top);
+            return ((~x & y) | (~(x ^ y) & d)) & top;
+        }
+
+        template <int NumAny>
+        inline bool testConj(const ConjTest<NumAny> & t, uint64_t bits)
+        {
+            bool ok = !t.never &&
+                      (bits & t.eqMask) == t.eqValue &&
+                      swarBorrow(bits & t.maskA, t.constA, t.topA) == t.topA &&
+                      swarBorrow(t.constB, bits & t.maskB, t.topB) == t.topB;
+            for (int k = 0; k < NumAny; ++k) {
+                ok = ok && (bits & t.anyMask[k]) != t.anyValue[k];
+            }
+            return ok;
+        }
+
+        // Mask of the bits above `lo` up to and including `hi` (lo < hi).
+        inline uint64_t bitsAbove(uint64_t lo, uint64_t hi)
+        {
+            return ((hi - 1) | hi) & ~((lo << 1) - 1);
+        }
+
+        // Merges the lanes of `rhs` into `lhs`; a lane present on both sides
+        // keeps the smaller (keepMin) or larger constant.
+        inline void mergeLanes(uint64_t & mask, uint64_t & consts, uint64_t & top,
+                               uint64_t rhsMask, uint64_t rhsConsts, uint64_t rhsTop, bool keepMin)
+        {
+            uint64_t prev = 0;
+            for (uint64_t rest = rhsTop; rest != 0; rest &= rest - 1) {
+                const uint64_t h = rest & (~rest + 1);
+                const uint64_t lane = rhsMask & (prev == 0 ? (h | (h - 1)) : bitsAbove(prev, h));
+                prev = h;
+                const uint64_t c = rhsConsts & lane;
+                if ((mask & lane) != 0) {
+                    const uint64_t cur = consts & lane;
+                    consts = (consts & ~lane) | ((keepMin ? c < cur : c > cur) ? c : cur);
+                }
+                else {
+                    mask |= lane;
+                    consts |= c;
+                    top |= h;
+                }
+            }
+        }
+
+        template <int A, int B>
+        inline ConjTest<A + B> mergeConj(const ConjTest<A> & lhs, const ConjTest<B> & rhs)
+        {
+            ConjTest<A + B> ret = emptyConj<A + B>();
+            const uint64_t both = lhs.eqMask & rhs.eqMask;
+            ret.never = lhs.never || rhs.never || ((lhs.eqValue ^ rhs.eqValue) & both) != 0;
+            ret.eqMask = lhs.eqMask | rhs.eqMask;
+            ret.eqValue = lhs.eqValue | rhs.eqValue;
+            ret.maskA = lhs.maskA;
+            ret.constA = lhs.constA;
+            ret.topA = lhs.topA;
+            mergeLanes(ret.maskA, ret.constA, ret.topA, rhs.maskA, rhs.constA, rhs.topA, true);
+            ret.maskB = lhs.maskB;
+            ret.constB = lhs.constB;
+            ret.topB = lhs.topB;
+            mergeLanes(ret.maskB, ret.constB, ret.topB, rhs.maskB, rhs.constB, rhs.topB, false);
+            for (int k = 0; k < A; ++k) {
+                ret.anyMask[k] = lhs.anyMask[k];
+                ret.anyValue[k] = lhs.anyValue[k];
+            }
+            for (int k = 0; k < B; ++k) {
+                ret.anyMask[A + k] = rhs.anyMask[k];
+                ret.anyValue[A + k] = rhs.anyValue[k];
+            }
+            return ret;
+        }
+
+        inline int countTrailingZeros(uint64_t x)
+        {
+#if defined(__GNUC__)
+            return __builtin_ctzll(x);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+            unsigned long idx;
+            _BitScanForward64(&idx, x);
+            return static_cast<int>(idx);
+#else
+            int n = 0;
+            while ((x & 1) == 0) {
+                x >>= 1;
+                ++n;
+            }
+            return n;
+#endif
+        }
+
+#if defined(CPPBITFIELD_HAS_SIMD)
+
+        namespace sse2 {
+
+#  define CPPBITFIELD_SIMD_FN inline CPPBITFIELD_TARGET("sse2")
+#  include <cppbitfield/detail/predicate_kernels.inl>
+#  undef CPPBITFIELD_SIMD_FN
+
+        } // namespace sse2
+
+        namespace avx2 {
+
+#  define CPPBITFIELD_SIMD_FN inline CPPBITFIELD_TARGET("avx2")
+#  include <cppbitfield/detail/predicate_kernels.inl>
+#  undef CPPBITFIELD_SIMD_FN
+
+        } // namespace avx2
+
+#  if defined(__GNUC__) && !defined(__clang__)
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#    pragma GCC diagnostic ignored "-Wuninitialized"
+#  endif
+
+        namespace avx512 {
+
+#  define CPPBITFIELD_SIMD_FN inline CPPBITFIELD_TARGET("avx512f")
+#  include <cppbitfield/detail/predicate_kernels.inl>
+#  undef CPPBITFIELD_SIMD_FN
+
+        } // namespace avx512
+
+#  if defined(__GNUC__) && !defined(__clang__)
+#    pragma GCC diagnostic pop
+#  endif
+
+#endif/*defined(CPPBITFIELD_HAS_SIMD)*/
+
+    } // namespace detail
+
+    /**
+     * A folded conjunction of field tests on Record. Built by comparing a
+     * field<Record, X>() against a value and by `&&` between such tests; the
+     * field masks are compile-time constants and the values are folded once
+     * when the expression is built, so a record is checked with one AND-CMP
+     * for all equality terms and one SWAR compare per direction for all range
+     * terms.
+     */
+    template <class Record, int NumAny>
+    class FieldTest : public detail::PredicateBase
+    {
+      public:
+        using RecordType = Record;
+        using StorageType = typename Record::StorageType;
+
+        static_assert(Record::NumBits <= 64, "Predicates require single word storage.");
+
+        explicit FieldTest(const detail::ConjTest<NumAny> & test) : m_test(test) { }
+
+        bool operator()(const Record & rec) const
+        {
+            return test(static_cast<uint64_t>(rec.bits()));
+        }
+
+        bool test(uint64_t bits) const
+        {
+            return detail::testConj(m_test, bits);
+        }
+
+        const detail::ConjTest<NumAny> & conj() const
+        {
+            return m_test;
+        }
+
+        // One bit per record of `in` into words[0 .. (n + 63) / 64); bits past
+        // `n` in the last word are unspecified.
+        void evalBlock(const StorageType * in, std::size_t n, uint64_t * words, SimdLevel level) const
+        {
+            std::memset(words, 0, ((n + 63) / 64) * sizeof(uint64_t));
+            if (m_test.never) {
+                return;
+            }
+            std::size_t done = 0;
+            switch (level) {
+#if defined(CPPBITFIELD_HAS_SIMD)
+              case SimdLevel::Avx512:
+                done = detail::avx512::match(in, n, m_test, words);
+                break;
+              case SimdLevel::Avx2:
+                done = detail::avx2::match(in, n, m_test, words);
+                break;
+              case SimdLevel::Sse2:
+                done = detail::sse2::match(in, n, m_test, words);
+                break;
+#endif
+              default:
+                break;
+            }
+            for (std::size_t i = done; i < n; ++i) {
+                words[i >> 6] |= static_cast<uint64_t>(test(static_cast<uint64_t>(in[i]))) << (i & 63);
+            }
+        }
+
+      private:
+        detail::ConjTest<NumAny> m_test;
+    };
+
+    template <class L, class R>
+    class AndPredicate : public detail::PredicateBase
+    {
+      public:
+        using RecordType = typename L::RecordType;
+        using StorageType = typename RecordType::StorageType;
+
+        static_assert(std::is_same<RecordType, typename R::RecordType>::value, "Predicates on different records.");
+
+        AndPredicate(const L & lhs, const R & rhs) : m_lhs(lhs), m_rhs(rhs) { }
+
+        bool operator()(const RecordType & rec) const { return test(static_cast<uint64_t>(rec.bits())); }
+
+        bool test(uint64_t bits) const { return m_lhs.test(bits) && m_rhs.test(bits); }
+
+        void evalBlock(const StorageType * in, std::size_t n, uint64_t * words, SimdLevel level) const
+        {
+            CPPBITFIELD_ASSERT("At most PREDICATE_BLOCK records per block." && (n <= detail::PREDICATE_BLOCK));
+            uint64_t rhs[detail::PREDICATE_BLOCK_WORDS];
+            m_lhs.evalBlock(in, n, words, level);
+            m_rhs.evalBlock(in, n, rhs, level);
+            for (std::size_t w = 0; w < (n + 63) / 64; ++w) {
+                words[w] &= rhs[w];
+            }
+        }
+
+      private:
+        L m_lhs;
+        R m_rhs;
+    };
+
+    template <class L, class R>
+    class OrPredicate : public detail::PredicateBase
+    {
+      public:
+        using RecordType = typename L::RecordType;
+        using StorageType = typename RecordType::StorageType;
+
+        static_assert(std::is_same<RecordType, typename R::RecordType>::value, "Predicates on different records.");
+
+        OrPredicate(const L & lhs, const R & rhs) : m_lhs(lhs), m_rhs(rhs) { }
+
+        bool operator()(const RecordType & rec) const { return test(static_cast<uint64_t>(rec.bits())); }
+
+        bool test(uint64_t bits) const { return m_lhs.test(bits) || m_rhs.test(bits); }
+
+        void evalBlock(const StorageType * in, std::size_t n, uint64_t * words, SimdLevel level) const
+        {
+            CPPBITFIELD_ASSERT("At most PREDICATE_BLOCK records per block." && (n <= detail::PREDICATE_BLOCK));
+            uint64_t rhs[detail::PREDICATE_BLOCK_WORDS];
+            m_lhs.evalBlock(in, n, words, level);
+            m_rhs.evalBlock(in, n, rhs, level);
+            for (std::size_t w = 0; w < (n + 63) / 64; ++w) {
+                words[w] |= rhs[w];
+            }
+        }
+
+      private:
+        L m_lhs;
+        R m_rhs;
+    };
+
+    template <class E>
+    class NotPredicate : public detail::PredicateBase
+    {
+      public:
+        using RecordType = typename E::RecordType;
+        using StorageType = typename RecordType::StorageType;
+
+        explicit NotPredicate(const E & expr) : m_expr(expr) { }
+
+        bool operator()(const RecordType & rec) const { return test(static_cast<uint64_t>(rec.bits())); }
+
+        bool test(uint64_t bits) const { return !m_expr.test(bits); }
+
+        void evalBlock(const StorageType * in, std::size_t n, uint64_t * words, SimdLevel level) const
+        {
+            m_expr.evalBlock(in, n, words, level);
+            for (std::size_t w = 0; w < (n + 63) / 64; ++w) {
+                words[w] = ~words[w];
+            }
+        }
+
+      private:
+        E m_expr;
+    };
+
+    /**
+     * Operand of a predicate expression: field X of Record, compared against
+     * plain integers. Values that cannot occur in the field fold to a test
+     * that is always or never true.
+     */
+    template <class Record, typename Record::FieldEnum X>
+    class FieldRef
+    {
+      public:
+        using Test = FieldTest<Record, 0>;
+
+        Test operator==(uint64_t val) const
+        {
+            detail::ConjTest<0> t = detail::emptyConj<0>();
+            t.never = val > MAX;
+            t.eqMask = MASK;
+            t.eqValue = (val & MAX) << Pos::offset;
+            return Test(t);
+        }
+
+        NotPredicate<Test> operator!=(uint64_t val) const
+        {
+            return NotPredicate<Test>(*this == val);
+        }
+
+        Test operator<(uint64_t val) const
+        {
+            detail::ConjTest<0> t = detail::emptyConj<0>();
+            t.never = val == 0;
+            if (val != 0 && val <= MAX) {
+                t.maskA = MASK;
+                t.constA = val << Pos::offset;
+                t.topA = TOP;
+            }
+            return Test(t);
+        }
+
+        Test operator<=(uint64_t val) const
+        {
+            return val >= MAX ? Test(detail::emptyConj<0>()) : *this < val + 1;
+        }
+
+        Test operator>(uint64_t val) const
+        {
+            detail::ConjTest<0> t = detail::emptyConj<0>();
+            t.never = val >= MAX;
+            if (val < MAX) {
+                t.maskB = MASK;
+                t.constB = val << Pos::offset;
+                t.topB = TOP;
+            }
+            return Test(t);
+        }
+
+        Test operator>=(uint64_t val) const
+        {
+            return val == 0 ? Test(detail::emptyConj<0>()) : *this > val - 1;
+        }
+
+        /**
+         * True if any bit of `mask` is set in the field. A single bit folds
+         * into the equality test.
+         */
+        FieldTest<Record, 1> operator&(uint64_t mask) const
+        {
+            detail::ConjTest<1> t = detail::emptyConj<1>();
+            const uint64_t m = (mask & MAX) << Pos::offset;
+            t.never = m == 0;
+            if ((m & (m - 1)) == 0) {
+                t.eqMask = m;
+                t.eqValue = m;
+                // disabled slot: (bits & 0) != 1
+                t.anyValue[0] = 1;
+            }
+            else {
+                t.anyMask[0] = m;
+            }
+            return FieldTest<Record, 1>(t);
+        }
+
+      private:
+        using Pos = detail::FieldPos<Record, Record::template AsInt<X>::value>;
+
+        static const uint64_t MAX = detail::LowMask<uint64_t, Pos::length>::value;
+        static const uint64_t MASK = MAX << Pos::offset;
+        static const uint64_t TOP = static_cast<uint64_t>(1) << (Pos::offset + Pos::length - 1);
+    };
+
+    template <class Record, typename Record::FieldEnum X>
+    inline FieldRef<Record, X> field()
+    {
+        return FieldRef<Record, X>();
+    }
+
+    template <class Record, int A, int B>
+    inline FieldTest<Record, A + B> operator&&(const FieldTest<Record, A> & lhs, const FieldTest<Record, B> & rhs)
+    {
+        return FieldTest<Record, A + B>(detail::mergeConj(lhs.conj(), rhs.conj()));
+    }
+
+    template <class L, class R>
+    inline typename std::enable_if<detail::IsPredicate<L>::value && detail::IsPredicate<R>::value, AndPredicate<L, R> >::type
+    operator&&(const L & lhs, const R & rhs)
+    {
+        return AndPredicate<L, R>(lhs, rhs);
+    }
+
+    template <class L, class R>
+    inline typename std::enable_if<detail::IsPredicate<L>::value && detail::IsPredicate<R>::value, OrPredicate<L, R> >::type
+    operator||(const L & lhs, const R & rhs)
+    {
+        return OrPredicate<L, R>(lhs, rhs);
+    }
+
+    template <class E>
+    inline typename std::enable_if<detail::IsPredicate<E>::value, NotPredicate<E> >::type
+    operator!(const E & expr)
+    {
+        return NotPredicate<E>(expr);
+    }
+
+    /**
+     * Evaluates `pred` over a run of records, writing one bit per record
+     * (bit i % 64 of bitmap[i / 64]) into (n + 63) / 64 words. Folded tests
+     * run with the widest SIMD level allowed; `||` and `!` combine the
+     * resulting bitmap words.
+     */
+    template <class Record, class Pred>
+    void filter(const Record * recs, std::size_t n, const Pred & pred, uint64_t * bitmap, SimdLevel level = simdLevel())
+    {
+        using StorageType = typename Record::StorageType;
+        static_assert(detail::IsPredicate<Pred>::value, "Not a field predicate.");
+        static_assert(std::is_same<Record, typename Pred::RecordType>::value, "Predicate on a different record.");
+        static_assert(sizeof(Record) == sizeof(StorageType), "Records must be tightly packed.");
+
+        level = detail::clampSimdLevel(level);
+        const StorageType * in = reinterpret_cast<const StorageType *>(recs);
+        for (std::size_t base = 0; base < n; base += detail::PREDICATE_BLOCK) {
+            const std::size_t count = n - base < detail::PREDICATE_BLOCK ? n - base : detail::PREDICATE_BLOCK;
+            uint64_t * words = bitmap + base / 64;
+            pred.evalBlock(in + base, count, words, level);
+            if ((count & 63) != 0) {
+                words[count / 64] &= (static_cast<uint64_t>(1) << (count & 63)) - 1;
+            }
+        }
+    }
+
+    /**
+     * Writes the indices of the records matching `pred` to `out`, which must
+     * have room for n entries, and returns how many matched.
+     */
+    template <class Record, class Pred>
+    std::size_t select(const Record * recs, std::size_t n, const Pred & pred, uint32_t * out, SimdLevel level = simdLevel())
+    {
+        CPPBITFIELD_ASSERT("Too many records for 32-bit indices." && (n <= 0xFFFFFFFFu));
+        uint64_t words[detail::PREDICATE_BLOCK_WORDS];
+        std::size_t count = 0;
+        for (std::size_t base = 0; base < n; base += detail::PREDICATE_BLOCK) {
+            const std::size_t len = n - base < detail::PREDICATE_BLOCK ? n - base : detail::PREDICATE_BLOCK;
+            filter(recs + base, len, pred, words, level);
+            for (std::size_t w = 0; w < (len + 63) / 64; ++w) {
+                for (uint64_t bits = words[w]; bits != 0; bits &= bits - 1) {
+                    out[count++] = static_cast<uint32_t>(base + 64 * w + detail::countTrailingZeros(bits));
+                }
+            }
+        }
+        return count;
+    }
+
+} // namespace cppbitfield
+
+#endif/*CPPBITFIELD_BITFIELD_PREDICATE_HPP*/
@@ -0,0 +1,306 @@
+/**
+ * \file bitfield_profile.hpp
+ * \date Oct 16, 2026
+ *
+ * Reports of per-field access counts. Building with CPPBITFIELD_PROFILE
+ * defined (for every translation unit) makes BitFields::get and set count
+ * each access by record type and field in thread-local counters; without
+ * it the hooks compile to nothing and the reports are empty.
+ */
+
+#ifndef CPPBITFIELD_BITFIELD_PROFILE_HPP
+#define CPPBITFIELD_BITFIELD_PROFILE_HPP
+
+#include <cppbitfield/bitfield.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#if defined(__GNUC__)
+#  include <cxxabi.h>
+#endif
+
+namespace cppbitfield {
+
+    enum class ProfileFormat
+    {
+        Text,
+        Json
+    };
+
+    struct FieldProfile
+    {
+        int offset;
+        int length;
+        uint64_t reads;
+        uint64_t writes;
+
+        uint64_t accesses() const
+        {
+            return reads + writes;
+        }
+    };
+
+    /**
+     * Counts of one record type since start or the last resetProfile(),
+     * with the layout they were taken on. `name` is the field enum's.
+     */
+    struct RecordProfile
+    {
+        std::string name;
+        int numBits;
+        std::vector<FieldProfile> fields;
+
+        uint64_t accesses() const
+        {
+            uint64_t n = 0;
+            for (std::size_t i = 0; i < fields.size(); ++i) {
+                n += fields[i].accesses();
+            }
+            return n;
+        }
+
+        // Field indices, most accessed first: the order of the hints for
+        // an OptimizedLayout of this record.
+        std::vector<int> hottest() const
+        {
+            std::vector<int> order(fields.size());
+            for (std::size_t i = 0; i < order.size(); ++i) {
+                order[i] = static_cast<int>(i);
+            }
+            std::stable_sort(order.begin(), order.end(), [this](int a, int b) {
+                return fields[a].accesses() > fields[b].accesses();
+            });
+            return order;
+        }
+    };
+
+    namespace detail {
+
+        inline std::string demangle(const char * name)
+        {
+#if defined(__GNUC__)
+            int status = 0;
+            char * readable = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+            if (status == 0 && readable) {
+                const std::string s(readable);
+                std::free(readable);
+                return s;
+            }
+#endif
+            return name;
+        }
+
+#if defined(CPPBITFIELD_PROFILE)
+        inline RecordProfile snapshotOf(ProfileType & type)
+        {
+            const std::vector<uint64_t> counts = type.totals();
+            const std::size_t n = type.offsets.size();
+            RecordProfile p;
+            p.name = demangle(type.name);
+            p.numBits = type.numBits;
+            for (std::size_t i = 0; i < n; ++i) {
+                const FieldProfile f = { type.offsets[i], type.lengths[i], counts[i], counts[n + i] };
+                p.fields.push_back(f);
+            }
+            return p;
+        }
+#endif
+
+        template <class Record>
+        struct ProfileOf;
+
+        template <class EnumType, class Sizes>
+        struct ProfileOf<BitFields<EnumType, Sizes> >
+        {
+            static RecordProfile get()
+            {
+#if defined(CPPBITFIELD_PROFILE)
+                return snapshotOf(FieldCounters<EnumType, Sizes>::type());
+#else
+                RecordProfile p;
+                p.name = demangle(typeid(EnumType).name());
+                p.numBits = Sizes::NumBits;
+                for (int i = 0; i < Sizes::NumFields; ++i) {
+                    const FieldProfile f = { Sizes::offset(i), Sizes::length(i), 0, 0 };
+                    p.fields.push_back(f);
+                }
+                return p;
+#endif
+            }
+        };
+
+        // Share of `part` in `whole` as a fraction with three decimals.
+        inline std::string ratio(uint64_t part, uint64_t whole)
+        {
+            const uint64_t milli = whole == 0 ? 0 : (part * 1000 + whole / 2) / whole;
+            std::string s = std::to_string(milli / 1000) + ".";
+            const std::string frac = std::to_string(1000 + milli % 1000);
+            return s + frac.substr(1);
+        }
+
+        inline std::string jsonString(const std::string & s)
+        {
+            std::string out = "\"";
+            for (std::size_t i = 0; i < s.size(); ++i) {
+                if (s[i] == '"' || s[i] == '\\') {
+                    out += '\\';
+                }
+                out += s[i];
+            }
+            return out + "\"";
+        }
+
+        inline void writeText(std::ostream & os, const RecordProfile & p)
+        {
+            const uint64_t total = p.accesses();
+            os << p.name << ": " << p.numBits << " bits, " << total << " accesses\n";
+            os << "  field  offset  length         reads        writes  share  read\n";
+            for (std::size_t i = 0; i < p.fields.size(); ++i) {
+                const FieldProfile & f = p.fields[i];
+                const std::string cols[] = {
+                    std::to_string(i), std::to_string(f.offset), std::to_string(f.length),
+                    std::to_string(f.reads), std::to_string(f.writes),
+                    ratio(f.accesses(), total), ratio(f.reads, f.accesses())
+                };
+                const std::size_t widths[] = { 7, 8, 8, 14, 14, 7, 6 };
+                for (int c = 0; c < 7; ++c) {
+                    os << std::string(widths[c] > cols[c].size() ? widths[c] - cols[c].size() : 1, ' ') << cols[c];
+                }
+                os << "\n";
+            }
+            const std::vector<int> hot = p.hottest();
+            os << "  hottest:";
+            for (std::size_t i = 0; i < hot.size(); ++i) {
+                os << " " << hot[i];
+            }
+            os << "\n";
+        }
+
+        inline void writeJson(std::ostream & os, const RecordProfile & p, const char * indent)
+        {
+            const uint64_t total = p.accesses();
+            os << indent << "{\"name\": " << jsonString(p.name) << ", \"bits\": " << p.numBits
+               << ", \"accesses\": " << total << ", \"fields\": [";
+            for (std::size_t i = 0; i < p.fields.size(); ++i) {
+                const FieldProfile & f = p.fields[i];
+                os << (i == 0 ? "\n" : ",\n") << indent << "    {\"index\": " << i << ", \"offset\": " << f.offset
+                   << ", \"length\": " << f.length << ", \"reads\": " << f.reads << ", \"writes\": " << f.writes
+                   << ", \"share\": " << ratio(f.accesses(), total) << ", \"readRatio\": " << ratio(f.reads, f.accesses()) << "}";
+            }
+            os << "],\n" << indent << "  \"hottest\": [";
+            const std::vector<int> hot = p.hottest();
+            for (std::size_t i = 0; i < hot.size(); ++i) {
+                os << (i == 0 ? "" : ", ") << hot[i];
+            }
+            os << "]}";
+        }
+
+        struct ProfileExitReport
+        {
+            std::ostream * os;
+            ProfileFormat format;
+        };
+
+        inline ProfileExitReport & profileExitReport()
+        {
+            static ProfileExitReport & r = *new ProfileExitReport();
+            return r;
+        }
+
+    } // namespace detail
+
+    /**
+     * Counts of Record, zero for every field when profiling is disabled.
+     */
+    template <class Record>
+    RecordProfile profileOf()
+    {
+        return detail::ProfileOf<Record>::get();
+    }
+
+    /**
+     * Counts of every record type accessed so far, in first-access order.
+     */
+    inline std::vector<RecordProfile> profileSnapshot()
+    {
+        std::vector<RecordProfile> all;
+#if defined(CPPBITFIELD_PROFILE)
+        std::vector<detail::ProfileType *> types;
+        {
+            std::lock_guard<std::mutex> guard(detail::profileLock());
+            types = detail::profileTypes();
+        }
+        for (std::size_t i = 0; i < types.size(); ++i) {
+            all.push_back(detail::snapshotOf(*types[i]));
+        }
+#endif
+        return all;
+    }
+
+    /**
+     * Starts counting again from zero; accesses racing with the reset may
+     * land on either side of it.
+     */
+    inline void resetProfile()
+    {
+#if defined(CPPBITFIELD_PROFILE)
+        std::vector<detail::ProfileType *> types;
+        {
+            std::lock_guard<std::mutex> guard(detail::profileLock());
+            types = detail::profileTypes();
+        }
+        for (std::size_t i = 0; i < types.size(); ++i) {
+            types[i]->reset();
+        }
+#endif
+    }
+
+    /**
+     * Writes a report of every record type: its layout, and per field the
+     * reads, writes, share of the record's accesses and fraction of reads,
+     * followed by the field indices hottest first.
+     */
+    inline void writeProfile(std::ostream & os, ProfileFormat format = ProfileFormat::Text)
+    {
+        const std::vector<RecordProfile> all = profileSnapshot();
+        if (format == ProfileFormat::Json) {
+            os << "{\"records\": [";
+            for (std::size_t i = 0; i < all.size(); ++i) {
+                os << (i == 0 ? "\n" : ",\n");
+                detail::writeJson(os, all[i], "  ");
+            }
+            os << "]}\n";
+            return;
+        }
+        for (std::size_t i = 0; i < all.size(); ++i) {
+            detail::writeText(os, all[i]);
+        }
+    }
+
+    /**
+     * Writes the report to `os` when the program exits; the stream must
+     * outlive static destruction (std::cerr, std::cout). A later call
+     * replaces the stream and format rather than adding a second report.
+     */
+    inline void writeProfileAtExit(std::ostream & os, ProfileFormat format = ProfileFormat::Text)
+    {
+        detail::ProfileExitReport & r = detail::profileExitReport();
+        const bool registered = r.os != nullptr;
+        r.os = &os;
+        r.format = format;
+        if (!registered) {
+            std::atexit([] {
+                const detail::ProfileExitReport & exit = detail::profileExitReport();
+                writeProfile(*exit.os, exit.format);
+            });
+        }
+    }
+
+} // namespace cppbitfield
+
+#endif/*CPPBITFIELD_BITFIELD_PROFILE_HPP*/
@@ -0,0 +1,483 @@
+/**
+ * \file bitfield_simd.hpp
+ * \date Oct 16, 2026
+ */
+
+#ifndef CPPBITFIELD_BITFIELD_SIMD_HPP
+#define CPPBITFIELD_BITFIELD_SIMD_HPP
+
+#include <cppbitfield/bitfield.hpp>
+
+#include <cstddef>
+#include <cstring>
+
+#if !defined(CPPBITFIELD_NO_SIMD) && \
+    (defined(__x86_64__) || defined(_M_X64) || \
+     ((defined(__i386__) || defined(_M_IX86)) && (defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))))
+#  if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ * 100 + __GNUC_MINOR__) >= 409
+#    define CPPBITFIELD_HAS_SIMD 1
+#    define CPPBITFIELD_TARGET(x) __attribute__((target(x)))
+#  elif defined(__clang__) && (__clang_major__ * 100 + __clang_minor__) >= 308
+#    define CPPBITFIELD_HAS_SIMD 1
+#    define CPPBITFIELD_TARGET(x) __attribute__((target(x)))
+#  elif defined(_MSC_VER) && _MSC_VER >= 1911
+#    define CPPBITFIELD_HAS_SIMD 1
+#    define CPPBITFIELD_TARGET(x)
+#  endif
+#endif
+
+#if defined(CPPBITFIELD_HAS_SIMD)
+#  if defined(_MSC_VER)
+#    include <intrin.h>
+#  endif
+#  include <immintrin.h>
+#endif
+
+namespace cppbitfield {
+
+    enum class SimdLevel
+    {
+        Scalar = 0,
+        Sse2   = 1,
+        Avx2   = 2,
+        Avx512 = 3
+    };
+
+    namespace detail {
+
+#if defined(CPPBITFIELD_HAS_SIMD)
+
+        inline SimdLevel detectSimdLevel()
+        {
+#  if defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7) {
+                return SimdLevel::Sse2;
+            }
+            __cpuid(info, 1);
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            if (!osxsave) {
+                return SimdLevel::Sse2;
+            }
+            const unsigned long long xcr0 = _xgetbv(0);
+            __cpuidex(info, 7, 0);
+            if ((info[1] & (1 << 16)) && (xcr0 & 0xE6) == 0xE6) {
+                return SimdLevel::Avx512;
+            }
+            if ((info[1] & (1 << 5)) && (xcr0 & 0x6) == 0x6) {
+                return SimdLevel::Avx2;
+            }
+            return SimdLevel::Sse2;
+#  else
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) {
+                return SimdLevel::Avx512;
+            }
+            if (__builtin_cpu_supports("avx2")) {
+                return SimdLevel::Avx2;
+            }
+            return SimdLevel::Sse2;
+#  endif
+        }
+
+#else
+
+        inline SimdLevel detectSimdLevel()
+        {
+            return SimdLevel::Scalar;
+        }
+
+#endif/*defined(CPPBITFIELD_HAS_SIMD)*/
+
+    } // namespace detail
+
+    /**
+     * Widest instruction set usable by the batch kernels on this CPU, detected
+     * once on first use.
+     */
+    inline SimdLevel simdLevel()
+    {
+        static const SimdLevel level = detail::detectSimdLevel();
+        return level;
+    }
+
+    namespace detail {
+
+        // Requested level, lowered to what the CPU supports.
+        inline SimdLevel clampSimdLevel(SimdLevel level)
+        {
+            const SimdLevel best = simdLevel();
+            return static_cast<int>(level) < static_cast<int>(best) ? level : best;
+        }
+
+    } // namespace detail
+
+#if defined(CPPBITFIELD_HAS_SIMD)
+
+    namespace detail {
+
+        namespace sse2 {
+
+#  define CPPBITFIELD_SIMD_FN inline CPPBITFIELD_TARGET("sse2")
+
+            struct Isa
+            {
+                using V = __m128i;
+                static const std::size_t N = 4;
+
+                CPPBITFIELD_SIMD_FN static V load32(const uint32_t * p) { return _mm_loadu_si128(reinterpret_cast<const V *>(p)); }
+                CPPBITFIELD_SIMD_FN static void store32(uint32_t * p, V v) { _mm_storeu_si128(reinterpret_cast<V *>(p), v); }
+                CPPBITFIELD_SIMD_FN static V load64(const uint64_t * p) { return _mm_loadu_si128(reinterpret_cast<const V *>(p)); }
+                CPPBITFIELD_SIMD_FN static void store64(uint64_t * p, V v) { _mm_storeu_si128(reinterpret_cast<V *>(p), v); }
+
+                CPPBITFIELD_SIMD_FN static V widen8(const uint8_t * p)
+                {
+                    int32_t bytes;
+                    std::memcpy(&bytes, p, sizeof(bytes));
+                    const V zero = _mm_setzero_si128();
+                    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), zero), zero);
+                }
+
+                CPPBITFIELD_SIMD_FN static V widen16(const uint16_t * p)
+                {
+                    return _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const V *>(p)), _mm_setzero_si128());
+                }
+
+                CPPBITFIELD_SIMD_FN static void narrow8(uint8_t * p, V v)
+                {
+                    // every lane holds a value < 256, so signed saturation is exact
+                    const V w = _mm_packs_epi32(v, v);
+                    const int32_t bytes = _mm_cvtsi128_si32(_mm_packus_epi16(w, w));
+                    std::memcpy(p, &bytes, sizeof(bytes));
+                }
+
+                CPPBITFIELD_SIMD_FN static void narrow16(uint16_t * p, V v)
+                {
+                    // bias into the signed range so _mm_packs_epi32 does not saturate
+                    const V w = _mm_packs_epi32(_mm_sub_epi32(v, _mm_set1_epi32(0x8000)), _mm_setzero_si128());
+                    _mm_storel_epi64(reinterpret_cast<V *>(p), _mm_xor_si128(w, _mm_set1_epi16(static_cast<short>(0x8000))));
+                }
+
+                CPPBITFIELD_SIMD_FN static V narrow64(V a, V b)
+                {
+                    return _mm_unpacklo_epi64(_mm_shuffle_epi32(a, _MM_SHUFFLE(2, 0, 2, 0)),
+                                              _mm_shuffle_epi32(b, _MM_SHUFFLE(2, 0, 2, 0)));
+                }
+
+                CPPBITFIELD_SIMD_FN static V widen32lo(V v) { return _mm_unpacklo_epi32(v, _mm_setzero_si128()); }
+                CPPBITFIELD_SIMD_FN static V widen32hi(V v) { return _mm_unpackhi_epi32(v, _mm_setzero_si128()); }
+
+                CPPBITFIELD_SIMD_FN static V set1_32(uint32_t x) { return _mm_set1_epi32(static_cast<int>(x)); }
+                CPPBITFIELD_SIMD_FN static V set1_64(uint64_t x) { return _mm_set1_epi64x(static_cast<long long>(x)); }
+
+                template <int S> CPPBITFIELD_SIMD_FN static V srl32(V v) { return _mm_srli_epi32(v, S); }
+                template <int S> CPPBITFIELD_SIMD_FN static V sll32(V v) { return _mm_slli_epi32(v, S); }
+                template <int S> CPPBITFIELD_SIMD_FN static V srl64(V v) { return _mm_srli_epi64(v, S); }
+                template <int S> CPPBITFIELD_SIMD_FN static V sll64(V v) { return _mm_slli_epi64(v, S); }
+
+                CPPBITFIELD_SIMD_FN static V and_(V a, V b) { return _mm_and_si128(a, b); }
+                CPPBITFIELD_SIMD_FN static V or_(V a, V b) { return _mm_or_si128(a, b); }
+                CPPBITFIELD_SIMD_FN static V xor_(V a, V b) { return _mm_xor_si128(a, b); }
+                CPPBITFIELD_SIMD_FN static V andnot_(V a, V b) { return _mm_andnot_si128(a, b); }
+
+                CPPBITFIELD_SIMD_FN static V add32(V a, V b) { return _mm_add_epi32(a, b); }
+                CPPBITFIELD_SIMD_FN static V add64(V a, V b) { return _mm_add_epi64(a, b); }
+                CPPBITFIELD_SIMD_FN static V sub32(V a, V b) { return _mm_sub_epi32(a, b); }
+                CPPBITFIELD_SIMD_FN static V sub64(V a, V b) { return _mm_sub_epi64(a, b); }
+                CPPBITFIELD_SIMD_FN static V cmpeq32(V a, V b) { return _mm_cmpeq_epi32(a, b); }
+
+                CPPBITFIELD_SIMD_FN static V cmpeq64(V a, V b)
+                {
+                    // both 32-bit halves equal; SSE2 has no 64-bit compare
+                    const V eq = _mm_cmpeq_epi32(a, b);
+                    return _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+                }
+
+                // unsigned order through a signed compare of biased lanes; SSE2
+                // has no unsigned 32-bit min/max
+                CPPBITFIELD_SIMD_FN static V min32u(V a, V b)
+                {
+                    const V bias = _mm_set1_epi32(static_cast<int>(0x80000000u));
+                    const V gt = _mm_cmpgt_epi32(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+                    return _mm_or_si128(_mm_and_si128(gt, b), _mm_andnot_si128(gt, a));
+                }
+
+                CPPBITFIELD_SIMD_FN static V max32u(V a, V b)
+                {
+                    const V bias = _mm_set1_epi32(static_cast<int>(0x80000000u));
+                    const V gt = _mm_cmpgt_epi32(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+                    return _mm_or_si128(_mm_and_si128(gt, a), _mm_andnot_si128(gt, b));
+                }
+
+                CPPBITFIELD_SIMD_FN static unsigned movemask32(V v) { return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(v))); }
+                CPPBITFIELD_SIMD_FN static unsigned movemask64(V v) { return static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(v))); }
+            };
+
+#  include <cppbitfield/detail/simd_kernels.inl>
+#  undef CPPBITFIELD_SIMD_FN
+
+        } // namespace sse2
+
+        namespace avx2 {
+
+#  define CPPBITFIELD_SIMD_FN inline CPPBITFIELD_TARGET("avx2")
+
+            struct Isa
+            {
+                using V = __m256i;
+                static const std::size_t N = 8;
+
+                CPPBITFIELD_SIMD_FN static V load32(const uint32_t * p) { return _mm256_loadu_si256(reinterpret_cast<const V *>(p)); }
+                CPPBITFIELD_SIMD_FN static void store32(uint32_t * p, V v) { _mm256_storeu_si256(reinterpret_cast<V *>(p), v); }
+                CPPBITFIELD_SIMD_FN static V load64(const uint64_t * p) { return _mm256_loadu_si256(reinterpret_cast<const V *>(p)); }
+                CPPBITFIELD_SIMD_FN static void store64(uint64_t * p, V v) { _mm256_storeu_si256(reinterpret_cast<V *>(p), v); }
+
+                CPPBITFIELD_SIMD_FN static V widen8(const uint8_t * p)
+                {
+                    return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p)));
+                }
+
+                CPPBITFIELD_SIMD_FN static V widen16(const uint16_t * p)
+                {
+                    return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+                }
+
+                CPPBITFIELD_SIMD_FN static void narrow8(uint8_t * p, V v)
+                {
+                    // gather byte 0 of every lane to the bottom of each 128-bit half
+                    const V ctrl = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                    0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+                    const V b = _mm256_shuffle_epi8(v, ctrl);
+                    const __m128i lo = _mm_unpacklo_epi32(_mm256_castsi256_si128(b), _mm256_extracti128_si256(b, 1));
+                    _mm_storel_epi64(reinterpret_cast<__m128i *>(p), lo);
+                }
+
+                CPPBITFIELD_SIMD_FN static void narrow16(uint16_t * p, V v)
+                {
+                    const V w = _mm256_permute4x64_epi64(_mm256_packus_epi32(v, v), _MM_SHUFFLE(3, 1, 2, 0));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(p), _mm256_castsi256_si128(w));
+                }
+
+                CPPBITFIELD_SIMD_FN static V narrow64(V a, V b)
+                {
+                    const V idx = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+                    const __m128i lo = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(a, idx));
+                    const __m128i hi = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(b, idx));
+                    return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+                }
+
+                CPPBITFIELD_SIMD_FN static V widen32lo(V v) { return _mm256_cvtepu32_epi64(_mm256_castsi256_si128(v)); }
+                CPPBITFIELD_SIMD_FN static V widen32hi(V v) { return _mm256_cvtepu32_epi64(_mm256_extracti128_si256(v, 1)); }
+
+                CPPBITFIELD_SIMD_FN static V set1_32(uint32_t x) { return _mm256_set1_epi32(static_cast<int>(x)); }
+                CPPBITFIELD_SIMD_FN static V set1_64(uint64_t x) { return _mm256_set1_epi64x(static_cast<long long>(x)); }
+
+                template <int S> CPPBITFIELD_SIMD_FN static V srl32(V v) { return _mm256_srli_epi32(v, S); }
+                template <int S> CPPBITFIELD_SIMD_FN static V sll32(V v) { return _mm256_slli_epi32(v, S); }
+                template <int S> CPPBITFIELD_SIMD_FN static V srl64(V v) { return _mm256_srli_epi64(v, S); }
+                template <int S> CPPBITFIELD_SIMD_FN static V sll64(V v) { return _mm256_slli_epi64(v, S); }
+
+                CPPBITFIELD_SIMD_FN static V and_(V a, V b) { return _mm256_and_si256(a, b); }
+                CPPBITFIELD_SIMD_FN static V or_(V a, V b) { return _mm256_or_si256(a, b); }
+                CPPBITFIELD_SIMD_FN static V xor_(V a, V b) { return _mm256_xor_si256(a, b); }
+                CPPBITFIELD_SIMD_FN static V andnot_(V a, V b) { return _mm256_andnot_si256(a, b); }
+
+                CPPBITFIELD_SIMD_FN static V add32(V a, V b) { return _mm256_add_epi32(a, b); }
+                CPPBITFIELD_SIMD_FN static V add64(V a, V b) { return _mm256_add_epi64(a, b); }
+                CPPBITFIELD_SIMD_FN static V sub32(V a, V b) { return _mm256_sub_epi32(a, b); }
+                CPPBITFIELD_SIMD_FN static V sub64(V a, V b) { return _mm256_sub_epi64(a, b); }
+                CPPBITFIELD_SIMD_FN static V cmpeq32(V a, V b) { return _mm256_cmpeq_epi32(a, b); }
+                CPPBITFIELD_SIMD_FN static V cmpeq64(V a, V b) { return _mm256_cmpeq_epi64(a, b); }
+                CPPBITFIELD_SIMD_FN static V min32u(V a, V b) { return _mm256_min_epu32(a, b); }
+                CPPBITFIELD_SIMD_FN static V max32u(V a, V b) { return _mm256_max_epu32(a, b); }
+
+                CPPBITFIELD_SIMD_FN static unsigned movemask32(V v) { return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(v))); }
+                CPPBITFIELD_SIMD_FN static unsigned movemask64(V v) { return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(v))); }
+            };
+
+#  include <cppbitfield/detail/simd_kernels.inl>
+#  undef CPPBITFIELD_SIMD_FN
+
+        } // namespace avx2
+
+#  if defined(__GNUC__) && !defined(__clang__)
+        // GCC flags the _mm512_undefined_* placeholders used inside its own
+        // AVX-512 conversion intrinsics
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#    pragma GCC diagnostic ignored "-Wuninitialized"
+#  endif
+
+        namespace avx512 {
+
+#  define CPPBITFIELD_SIMD_FN inline CPPBITFIELD_TARGET("avx512f")
+
+            struct Isa
+            {
+                using V = __m512i;
+                static const std::size_t N = 16;
+
+                CPPBITFIELD_SIMD_FN static V load32(const uint32_t * p) { return _mm512_loadu_si512(p); }
+                CPPBITFIELD_SIMD_FN static void store32(uint32_t * p, V v) { _mm512_storeu_si512(p, v); }
+                CPPBITFIELD_SIMD_FN static V load64(const uint64_t * p) { return _mm512_loadu_si512(p); }
+                CPPBITFIELD_SIMD_FN static void store64(uint64_t * p, V v) { _mm512_storeu_si512(p, v); }
+
+                CPPBITFIELD_SIMD_FN static V widen8(const uint8_t * p)
+                {
+                    return _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+                }
+
+                CPPBITFIELD_SIMD_FN static V widen16(const uint16_t * p)
+                {
+                    return _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)));
+                }
+
+                CPPBITFIELD_SIMD_FN static void narrow8(uint8_t * p, V v)
+                {
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(p), _mm512_cvtepi32_epi8(v));
+                }
+
+                CPPBITFIELD_SIMD_FN static void narrow16(uint16_t * p, V v)
+                {
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), _mm512_cvtepi32_epi16(v));
+                }
+
+                CPPBITFIELD_SIMD_FN static V narrow64(V a, V b)
+                {
+                    return _mm512_inserti64x4(_mm512_castsi256_si512(_mm512_cvtepi64_epi32(a)), _mm512_cvtepi64_epi32(b), 1);
+                }
+
+                CPPBITFIELD_SIMD_FN static V widen32lo(V v) { return _mm512_cvtepu32_epi64(_mm512_castsi512_si256(v)); }
+                CPPBITFIELD_SIMD_FN static V widen32hi(V v) { return _mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(v, 1)); }
+
+                CPPBITFIELD_SIMD_FN static V set1_32(uint32_t x) { return _mm512_set1_epi32(static_cast<int>(x)); }
+                CPPBITFIELD_SIMD_FN static V set1_64(uint64_t x) { return _mm512_set1_epi64(static_cast<long long>(x)); }
+
+                template <int S> CPPBITFIELD_SIMD_FN static V srl32(V v) { return _mm512_srli_epi32(v, S); }
+                template <int S> CPPBITFIELD_SIMD_FN static V sll32(V v) { return _mm512_slli_epi32(v, S); }
+                template <int S> CPPBITFIELD_SIMD_FN static V srl64(V v) { return _mm512_srli_epi64(v, S); }
+                template <int S> CPPBITFIELD_SIMD_FN static V sll64(V v) { return _mm512_slli_epi64(v, S); }
+
+                CPPBITFIELD_SIMD_FN static V and_(V a, V b) { return _mm512_and_si512(a, b); }
+                CPPBITFIELD_SIMD_FN static V or_(V a, V b) { return _mm512_or_si512(a, b); }
+                CPPBITFIELD_SIMD_FN static V xor_(V a, V b) { return _mm512_xor_si512(a, b); }
+                CPPBITFIELD_SIMD_FN static V andnot_(V a, V b) { return _mm512_andnot_si512(a, b); }
+
+                CPPBITFIELD_SIMD_FN static V add32(V a, V b) { return _mm512_add_epi32(a, b); }
+                CPPBITFIELD_SIMD_FN static V add64(V a, V b) { return _mm512_add_epi64(a, b); }
+                CPPBITFIELD_SIMD_FN static V sub32(V a, V b) { return _mm512_sub_epi32(a, b); }
+                CPPBITFIELD_SIMD_FN static V sub64(V a, V b) { return _mm512_sub_epi64(a, b); }
+                CPPBITFIELD_SIMD_FN static V min32u(V a, V b) { return _mm512_min_epu32(a, b); }
+                CPPBITFIELD_SIMD_FN static V max32u(V a, V b) { return _mm512_max_epu32(a, b); }
+
+                // comparisons produce k-masks; widen back to all-ones lanes
+                CPPBITFIELD_SIMD_FN static V cmpeq32(V a, V b) { return _mm512_maskz_set1_epi32(_mm512_cmpeq_epi32_mask(a, b), -1); }
+                CPPBITFIELD_SIMD_FN static V cmpeq64(V a, V b) { return _mm512_maskz_set1_epi64(_mm512_cmpeq_epi64_mask(a, b), -1); }
+
+                CPPBITFIELD_SIMD_FN static unsigned movemask32(V v) { return static_cast<unsigned>(_mm512_test_epi32_mask(v, v)); }
+                CPPBITFIELD_SIMD_FN static unsigned movemask64(V v) { return static_cast<unsigned>(_mm512_test_epi64_mask(v, v)); }
+            };
+
+#  include <cppbitfield/detail/simd_kernels.inl>
+#  undef CPPBITFIELD_SIMD_FN
+
+        } // namespace avx512
+
+#  if defined(__GNUC__) && !defined(__clang__)
+#    pragma GCC diagnostic pop
+#  endif
+
+    } // namespace detail
+
+#endif/*defined(CPPBITFIELD_HAS_SIMD)*/
+
+    /**
+     * Bulk field access over contiguous runs of BitFields records. Each call
+     * dispatches once to the widest kernel the CPU supports (or the requested
+     * level, if lower) and finishes any tail with the scalar get/set.
+     */
+    template <class Record>
+    struct BitFieldBatch
+    {
+        using StorageType = typename Record::StorageType;
+        using IntType = typename Record::IntType;
+        using EnumType = typename Record::FieldEnum;
+
+        static_assert(Record::NumBits <= 64, "Batch kernels require single word storage.");
+        static_assert(sizeof(Record) == sizeof(StorageType), "Records must be tightly packed.");
+
+        template <IntType Idx>
+        using Field = detail::FieldPos<Record, Idx>;
+
+        template <EnumType X>
+        static void extract(const Record * recs, std::size_t n, uint32_t * out, SimdLevel level = simdLevel())
+        {
+            using F = Field<Record::template AsInt<X>::value>;
+            static_assert(F::length <= 32, "Field does not fit in uint32_t.");
+            std::size_t done = 0;
+            switch (detail::clampSimdLevel(level)) {
+#if defined(CPPBITFIELD_HAS_SIMD)
+              case SimdLevel::Avx512:
+                done = detail::avx512::extract<F::offset, F::length>(storage(recs), n, out);
+                break;
+              case SimdLevel::Avx2:
+                done = detail::avx2::extract<F::offset, F::length>(storage(recs), n, out);
+                break;
+              case SimdLevel::Sse2:
+                done = detail::sse2::extract<F::offset, F::length>(storage(recs), n, out);
+                break;
+#endif
+              default:
+                break;
+            }
+            for (std::size_t i = done; i < n; ++i) {
+                out[i] = recs[i].template get<X, uint32_t>();
+            }
+        }
+
+        template <EnumType X>
+        static void insert(Record * recs, std::size_t n, const uint32_t * in, SimdLevel level = simdLevel())
+        {
+            using F = Field<Record::template AsInt<X>::value>;
+            static_assert(F::length <= 32, "Field does not fit in uint32_t.");
+            for (std::size_t i = 0; i < n; ++i) {
+                CPPBITFIELD_ASSERT("Value too large for bitfield length." &&
+                                   (in[i] <= detail::LowMask<uint32_t, F::length>::value));
+            }
+            std::size_t done = 0;
+            switch (detail::clampSimdLevel(level)) {
+#if defined(CPPBITFIELD_HAS_SIMD)
+              case SimdLevel::Avx512:
+                done = detail::avx512::insert<F::offset, F::length>(storage(recs), n, in);
+                break;
+              case SimdLevel::Avx2:
+                done = detail::avx2::insert<F::offset, F::length>(storage(recs), n, in);
+                break;
+              case SimdLevel::Sse2:
+                done = detail::sse2::insert<F::offset, F::length>(storage(recs), n, in);
+                break;
+#endif
+              default:
+                break;
+            }
+            for (std::size_t i = done; i < n; ++i) {
+                recs[i].template set<X>(in[i]);
+            }
+        }
+
+      private:
+        static const StorageType * storage(const Record * recs)
+        {
+            return reinterpret_cast<const StorageType *>(recs);
+        }
+
+        static StorageType * storage(Record * recs)
+        {
+            return reinterpret_cast<StorageType *>(recs);
+        }
+    };
+
+} // namespace cppbitfield
+
+#endif/*CPPBITFIELD_BITFIELD_SIMD_HPP*/
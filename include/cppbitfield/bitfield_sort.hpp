@@ -0,0 +1,195 @@
+/**
+ * \file bitfield_sort.hpp
+ * \date Oct 16, 2026
+ */
+
+#ifndef CPPBITFIELD_BITFIELD_SORT_HPP
+#define CPPBITFIELD_BITFIELD_SORT_HPP
+
+#include <cppbitfield/bitfield.hpp>
+#include <cppbitfield/bitfield_parallel.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace cppbitfield {
+
+    namespace detail {
+
+        // Widest radix digit: 2^11 counters of a pass stay inside L1.
+        static const int RADIX_MAX_DIGIT_BITS = 11;
+
+        // Below this many records a comparison sort on the key is faster
+        // than the counting passes.
+        static const std::size_t RADIX_MIN_RECORDS = 256;
+
+        /**
+         * Sort key of fields Xs... of a single-word record: the fields
+         * concatenated with the first one most significant, so keys compare
+         * like the field tuples.
+         */
+        template <class Record, typename Record::FieldEnum... Xs>
+        struct SortKey;
+
+        template <class Record>
+        struct SortKey<Record>
+        {
+            static const int Bits = 0;
+
+            static uint64_t get(uint64_t) { return 0; }
+        };
+
+        template <class Record, typename Record::FieldEnum X, typename Record::FieldEnum... Xs>
+        struct SortKey<Record, X, Xs...>
+        {
+            using Pos = FieldPos<Record, Record::template AsInt<X>::value>;
+            using Rest = SortKey<Record, Xs...>;
+
+            static const int Bits = Pos::length + Rest::Bits;
+
+            static uint64_t get(uint64_t bits)
+            {
+                return (((bits >> Pos::offset) & LowMask<uint64_t, Pos::length>::value) << Rest::Bits) | Rest::get(bits);
+            }
+        };
+
+        /**
+         * Passes of an LSD radix sort over a KeyBits-bit key: as few as
+         * digits of at most RADIX_MAX_DIGIT_BITS allow, with the bits spread
+         * evenly so no pass counts more buckets than it needs.
+         */
+        template <int KeyBits>
+        struct RadixPlan
+        {
+            static const int Passes = (KeyBits + RADIX_MAX_DIGIT_BITS - 1) / RADIX_MAX_DIGIT_BITS;
+            static const int DigitBits = Passes == 0 ? 1 : (KeyBits + Passes - 1) / Passes;
+            static const std::size_t Buckets = static_cast<std::size_t>(1) << DigitBits;
+        };
+
+        template <class Record, class Key>
+        struct RadixSorter
+        {
+            using StorageType = typename Record::StorageType;
+            using Plan = RadixPlan<Key::Bits>;
+
+            static const std::size_t B = Plan::Buckets;
+
+            static std::size_t digit(StorageType bits, int pass)
+            {
+                return static_cast<std::size_t>((Key::get(static_cast<uint64_t>(bits)) >> (pass * Plan::DigitBits)) & (B - 1));
+            }
+
+            static void sort(Record * recs, std::size_t n, unsigned threads)
+            {
+                if (n < RADIX_MIN_RECORDS || Plan::Passes == 0) {
+                    std::stable_sort(recs, recs + n, [](const Record & a, const Record & b) {
+                        return Key::get(static_cast<uint64_t>(a.bits())) < Key::get(static_cast<uint64_t>(b.bits()));
+                    });
+                    return;
+                }
+                const StorageType * in = reinterpret_cast<const StorageType *>(recs);
+
+                // one read of the input counts every pass; a pass whose
+                // digit is the same for all records would not move anything
+                const std::vector<std::vector<std::size_t> > hist = forEachSlice(n, threads, std::vector<std::size_t>(Plan::Passes * B, 0),
+                    [in](std::size_t begin, std::size_t end, std::vector<std::size_t> & h) {
+                        for (std::size_t i = begin; i < end; ++i) {
+                            const uint64_t key = Key::get(static_cast<uint64_t>(in[i]));
+                            for (int p = 0; p < Plan::Passes; ++p) {
+                                ++h[p * B + ((key >> (p * Plan::DigitBits)) & (B - 1))];
+                            }
+                        }
+                    });
+
+                std::vector<StorageType> buffer(n);
+                StorageType * src = reinterpret_cast<StorageType *>(recs);
+                StorageType * dst = buffer.data();
+                for (int p = 0; p < Plan::Passes; ++p) {
+                    bool constant = false;
+                    for (std::size_t b = 0; b < B; ++b) {
+                        std::size_t c = 0;
+                        for (std::size_t t = 0; t < hist.size(); ++t) {
+                            c += hist[t][p * B + b];
+                        }
+                        constant = constant || c == n;
+                    }
+                    if (constant) {
+                        continue;
+                    }
+                    scatter(src, dst, n, p, hist);
+                    std::swap(src, dst);
+                }
+                if (src != reinterpret_cast<StorageType *>(recs)) {
+                    std::copy(src, src + n, reinterpret_cast<StorageType *>(recs));
+                }
+            }
+
+            // One stable counting pass on digit `pass`, one thread per slice
+            // of `hist`: each slice counts its own digits and writes after the
+            // records of every lower bucket and of the same bucket in earlier
+            // slices. A single slice reuses the counts of the whole input.
+            static void scatter(const StorageType * src, StorageType * dst, std::size_t n, int pass,
+                                const std::vector<std::vector<std::size_t> > & hist)
+            {
+                const std::size_t slices = hist.size();
+                std::vector<std::vector<std::size_t> > offsets(slices, std::vector<std::size_t>(B, 0));
+                if (slices > 1) {
+                    forEachSlice(n, offsets, [src, pass](std::size_t begin, std::size_t end, std::vector<std::size_t> & c) {
+                        for (std::size_t i = begin; i < end; ++i) {
+                            ++c[digit(src[i], pass)];
+                        }
+                    });
+                }
+                else {
+                    std::copy(hist[0].begin() + pass * B, hist[0].begin() + (pass + 1) * B, offsets[0].begin());
+                }
+                std::size_t sum = 0;
+                for (std::size_t b = 0; b < B; ++b) {
+                    for (std::size_t t = 0; t < slices; ++t) {
+                        const std::size_t c = offsets[t][b];
+                        offsets[t][b] = sum;
+                        sum += c;
+                    }
+                }
+                forEachSlice(n, offsets, [src, dst, pass](std::size_t begin, std::size_t end, std::vector<std::size_t> & next) {
+                    for (std::size_t i = begin; i < end; ++i) {
+                        dst[next[digit(src[i], pass)]++] = src[i];
+                    }
+                });
+            }
+        };
+
+    } // namespace detail
+
+    /**
+     * Stable sort of recs[0 .. n) by the fields Xs..., the first field
+     * most significant. The key is the fields concatenated (at most 64
+     * bits), sorted LSD with the digit widths planned at compile time from
+     * the field lengths; a pass whose digit is the same for every record is
+     * skipped. With `threads` other than 1 (0: one per hardware thread)
+     * large inputs count and scatter every pass in parallel slices.
+     */
+    template <class Record, typename Record::FieldEnum... Xs>
+    void radixSort(Record * recs, std::size_t n, unsigned threads = 1)
+    {
+        using Key = detail::SortKey<Record, Xs...>;
+        static_assert(sizeof...(Xs) > 0, "No fields to sort by.");
+        static_assert(Record::NumBits <= 64, "Radix sort requires single word storage.");
+        static_assert(sizeof(Record) == sizeof(typename Record::StorageType), "Records must be tightly packed.");
+        static_assert(Key::Bits <= 64, "Sort fields exceed a 64-bit key.");
+        detail::RadixSorter<Record, Key>::sort(recs, n, threads);
+    }
+
+    /**
+     * Sort key of `rec` as used by radixSort<Record, Xs...>.
+     */
+    template <class Record, typename Record::FieldEnum... Xs>
+    uint64_t sortKey(const Record & rec)
+    {
+        return detail::SortKey<Record, Xs...>::get(static_cast<uint64_t>(rec.bits()));
+    }
+
+} // namespace cppbitfield
+
+#endif/*CPPBITFIELD_BITFIELD_SORT_HPP*/
@@ -0,0 +1,639 @@
+/**
+ * \file bitfield_stream.hpp
+ * \date Oct 16, 2026
+ */
+
+#ifndef CPPBITFIELD_BITFIELD_STREAM_HPP
+#define CPPBITFIELD_BITFIELD_STREAM_HPP
+
+#include <cppbitfield/bitfield_file.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cppbitfield {
+
+    /**
+     * Stream file header. Blocks follow at `headerSize`: each is a
+     * BitFieldBlockHeader and the block's records packed from bit 0 of its
+     * own words. All blocks but the last hold `recordsPerBlock` records, so
+     * block k starts at a computable offset and decodes independently.
+     */
+    struct BitFieldStreamHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t headerSize;
+        uint64_t fingerprint;
+        uint32_t recordBits;
+        uint32_t byteOrder;
+        uint64_t numRecords;
+        uint64_t recordsPerBlock;
+        uint64_t numBlocks;
+        uint64_t reserved;
+    };
+
+    static_assert(sizeof(BitFieldStreamHeader) == 64, "Header keeps blocks 64-byte aligned.");
+
+    struct BitFieldBlockHeader
+    {
+        uint64_t numRecords;
+        uint64_t checksum; // blockChecksum of the payload words
+    };
+
+    namespace detail {
+
+        const char BITFIELD_STREAM_MAGIC[8] = { 'C', 'P', 'P', 'B', 'F', 'S', 'T', 'M' };
+
+        inline uint64_t rotl64(uint64_t x, int r)
+        {
+            return (x << r) | (x >> (64 - r));
+        }
+
+        // Four independent multiply-rotate lanes, folded at the end: keeps up
+        // with memory bandwidth and catches torn or misplaced blocks.
+        inline uint64_t blockChecksum(const uint64_t * words, std::size_t n)
+        {
+            static const uint64_t P1 = 0x9E3779B185EBCA87ULL;
+            static const uint64_t P2 = 0xC2B2AE3D27D4EB4FULL;
+            uint64_t h[4] = { P1, P2, ~P1, ~P2 };
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                for (int j = 0; j < 4; ++j) {
+                    h[j] = rotl64(h[j] + words[i + j] * P2, 31) * P1;
+                }
+            }
+            for (; i < n; ++i) {
+                h[0] = rotl64(h[0] + words[i] * P2, 31) * P1;
+            }
+            uint64_t ret = static_cast<uint64_t>(n) * P1;
+            for (int j = 0; j < 4; ++j) {
+                ret = rotl64(ret ^ h[j], 27) * P1 + P2;
+            }
+            return ret;
+        }
+
+        // File positions as 64-bit offsets: ftell and fseek take a long,
+        // which stops at 2 GiB on LLP64 and 32-bit targets. On 32-bit POSIX
+        // targets off_t is 64 bits with _FILE_OFFSET_BITS=64.
+        inline int64_t fileTell(std::FILE * f)
+        {
+#if defined(_WIN32)
+            return _ftelli64(f);
+#elif defined(CPPBITFIELD_HAS_POSIX_IO)
+            return static_cast<int64_t>(::ftello(f));
+#else
+            return std::ftell(f);
+#endif
+        }
+
+        inline bool fileSeek(std::FILE * f, int64_t offset)
+        {
+#if defined(_WIN32)
+            return _fseeki64(f, offset, SEEK_SET) == 0;
+#elif defined(CPPBITFIELD_HAS_POSIX_IO)
+            return ::fseeko(f, static_cast<off_t>(offset), SEEK_SET) == 0;
+#else
+            return std::fseek(f, static_cast<long>(offset), SEEK_SET) == 0;
+#endif
+        }
+
+        template <int NumBits>
+        inline std::size_t blockWords(uint64_t numRecords)
+        {
+            return static_cast<std::size_t>(wordsForBits(numRecords * NumBits));
+        }
+
+    } // namespace detail
+
+    /**
+     * Appends records to a stream file in blocks of `recordsPerBlock`. Each
+     * full block is packed, checksummed and written as it fills; close()
+     * writes the last partial block and the final record count.
+     */
+    template <class EnumType, class Sizes>
+    class BitFieldStreamWriter
+    {
+      public:
+        using value_type = BitFields<EnumType, Sizes>;
+        using size_type = std::size_t;
+        using StorageType = typename value_type::StorageType;
+
+        static const int NumBits = value_type::NumBits;
+
+        BitFieldStreamWriter() : m_file(nullptr), m_recordsPerBlock(0), m_count(0), m_numRecords(0), m_numBlocks(0),
+                                 m_status(BitFieldFileStatus::Ok) { }
+
+        BitFieldStreamWriter(const BitFieldStreamWriter &) = delete;
+        BitFieldStreamWriter & operator=(const BitFieldStreamWriter &) = delete;
+
+        ~BitFieldStreamWriter()
+        {
+            close();
+        }
+
+        BitFieldFileStatus open(const char * path, size_type recordsPerBlock = 1 << 16)
+        {
+            close();
+            CPPBITFIELD_ASSERT("Blocks hold at least one record." && (recordsPerBlock > 0));
+            m_file = std::fopen(path, "wb");
+            if (!m_file) {
+                return BitFieldFileStatus::IoError;
+            }
+            m_recordsPerBlock = recordsPerBlock;
+            m_count = 0;
+            m_numRecords = 0;
+            m_numBlocks = 0;
+            m_block.assign(sizeof(BitFieldBlockHeader) / sizeof(uint64_t) + detail::blockWords<NumBits>(recordsPerBlock), 0);
+            m_status = writeHeader();
+            return m_status;
+        }
+
+        void push(const value_type & rec)
+        {
+            CPPBITFIELD_ASSERT("Stream is not open." && (m_file != nullptr));
+            detail::RecordBits<StorageType, NumBits>::store(payload(), static_cast<uint64_t>(m_count) * NumBits, rec.bits());
+            if (++m_count == m_recordsPerBlock) {
+                flushBlock();
+            }
+        }
+
+        BitFieldFileStatus close()
+        {
+            if (m_file) {
+                if (m_count > 0) {
+                    flushBlock();
+                }
+                if (m_status == BitFieldFileStatus::Ok) {
+                    m_status = writeHeader();
+                }
+                if (std::fclose(m_file) != 0 && m_status == BitFieldFileStatus::Ok) {
+                    m_status = BitFieldFileStatus::IoError;
+                }
+                m_file = nullptr;
+            }
+            return m_status;
+        }
+
+        BitFieldFileStatus status() const { return m_status; }
+
+        uint64_t numRecords() const { return m_numRecords + m_count; }
+
+      private:
+        uint64_t * payload()
+        {
+            return m_block.data() + sizeof(BitFieldBlockHeader) / sizeof(uint64_t);
+        }
+
+        BitFieldFileStatus writeHeader()
+        {
+            BitFieldStreamHeader hdr;
+            std::memset(&hdr, 0, sizeof(hdr));
+            std::memcpy(hdr.magic, detail::BITFIELD_STREAM_MAGIC, sizeof(hdr.magic));
+            hdr.version = detail::BITFIELD_FILE_VERSION;
+            hdr.headerSize = sizeof(hdr);
+            hdr.fingerprint = LayoutFingerprint<EnumType, Sizes>::value;
+            hdr.recordBits = NumBits;
+            hdr.byteOrder = detail::BITFIELD_FILE_BYTE_ORDER;
+            hdr.numRecords = m_numRecords;
+            hdr.recordsPerBlock = m_recordsPerBlock;
+            hdr.numBlocks = m_numBlocks;
+            const int64_t end = detail::fileTell(m_file);
+            const bool ok = detail::fileSeek(m_file, 0) && std::fwrite(&hdr, sizeof(hdr), 1, m_file) == 1 &&
+                            (end <= 0 || detail::fileSeek(m_file, end));
+            return ok ? BitFieldFileStatus::Ok : BitFieldFileStatus::IoError;
+        }
+
+        void flushBlock()
+        {
+            const std::size_t words = detail::blockWords<NumBits>(m_count);
+            BitFieldBlockHeader hdr;
+            hdr.numRecords = m_count;
+            hdr.checksum = detail::blockChecksum(payload(), words);
+            std::memcpy(m_block.data(), &hdr, sizeof(hdr));
+            const std::size_t total = sizeof(hdr) / sizeof(uint64_t) + words;
+            if (m_status == BitFieldFileStatus::Ok && std::fwrite(m_block.data(), sizeof(uint64_t), total, m_file) != total) {
+                m_status = BitFieldFileStatus::IoError;
+            }
+            std::fill(m_block.begin(), m_block.end(), 0);
+            m_numRecords += m_count;
+            ++m_numBlocks;
+            m_count = 0;
+        }
+
+        std::FILE * m_file;
+        std::vector<uint64_t> m_block;
+        size_type m_recordsPerBlock;
+        size_type m_count;
+        uint64_t m_numRecords;
+        uint64_t m_numBlocks;
+        BitFieldFileStatus m_status;
+    };
+
+    /**
+     * Reads a stream file written by BitFieldStreamWriter as a steady
+     * sequence of records. One I/O thread preads blocks into a ring of
+     * buffers (at least two, so the next read overlaps the current decode),
+     * a pool of workers verifies checksums and unpacks blocks into arrays
+     * of BitFields, and the consumer takes them in file order through
+     * next(), nextBlock() or the input iterator. A failed read or checksum
+     * ends the sequence and is reported by status().
+     */
+    template <class EnumType, class Sizes>
+    class BitFieldStreamReader
+    {
+      public:
+        using value_type = BitFields<EnumType, Sizes>;
+        using size_type = std::size_t;
+        using StorageType = typename value_type::StorageType;
+
+        static const int NumBits = value_type::NumBits;
+
+        class iterator
+        {
+          public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = typename BitFieldStreamReader::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const value_type *;
+            using reference = const value_type &;
+
+            iterator() : m_reader(nullptr) { }
+
+            reference operator*() const { return m_rec; }
+            pointer operator->() const { return &m_rec; }
+
+            iterator & operator++()
+            {
+                if (!m_reader->next(m_rec)) {
+                    m_reader = nullptr;
+                }
+                return *this;
+            }
+
+            bool operator==(const iterator & rhs) const { return m_reader == rhs.m_reader; }
+            bool operator!=(const iterator & rhs) const { return m_reader != rhs.m_reader; }
+
+          private:
+            friend class BitFieldStreamReader;
+
+            explicit iterator(BitFieldStreamReader * reader) : m_reader(reader)
+            {
+                ++*this;
+            }
+
+            BitFieldStreamReader * m_reader;
+            value_type m_rec;
+        };
+
+        BitFieldStreamReader() : m_fd(-1), m_status(BitFieldFileStatus::Ok), m_stop(false), m_held(-1),
+                                 m_nextBlock(0), m_cur(nullptr), m_curEnd(nullptr)
+        {
+            std::memset(&m_hdr, 0, sizeof(m_hdr));
+        }
+
+        BitFieldStreamReader(const BitFieldStreamReader &) = delete;
+        BitFieldStreamReader & operator=(const BitFieldStreamReader &) = delete;
+
+        ~BitFieldStreamReader()
+        {
+            close();
+        }
+
+        /**
+         * Validates the header and starts the pipeline with `numWorkers`
+         * decode threads (0: one per hardware thread) and `depth` block
+         * buffers (0: two per worker).
+         */
+        BitFieldFileStatus open(const char * path, unsigned numWorkers = 0, unsigned depth = 0)
+        {
+            close();
+#if defined(CPPBITFIELD_HAS_POSIX_IO)
+            m_fd = ::open(path, O_RDONLY);
+            if (m_fd < 0) {
+                return m_status = BitFieldFileStatus::IoError;
+            }
+            m_status = readHeader();
+            if (m_status != BitFieldFileStatus::Ok) {
+                std::memset(&m_hdr, 0, sizeof(m_hdr));
+                closeFd();
+                return m_status;
+            }
+
+            if (numWorkers == 0) {
+                numWorkers = std::max(1u, std::thread::hardware_concurrency());
+            }
+            depth = std::max(2u, depth == 0 ? 2 * numWorkers : depth);
+            m_slots.assign(depth, Slot());
+            // no block holds more records than the file
+            const uint64_t maxRecords = blockRecords(0);
+            const std::size_t blockWords = detail::blockWords<NumBits>(maxRecords);
+            for (std::size_t s = 0; s < m_slots.size(); ++s) {
+                m_slots[s].raw.resize(sizeof(BitFieldBlockHeader) / sizeof(uint64_t) + blockWords);
+                m_slots[s].records.resize(static_cast<std::size_t>(maxRecords));
+            }
+            m_stop = false;
+            m_nextBlock = 0;
+            m_held = -1;
+            m_io = std::thread(&BitFieldStreamReader::ioLoop, this);
+            for (unsigned w = 0; w < numWorkers; ++w) {
+                m_workers.push_back(std::thread(&BitFieldStreamReader::workLoop, this));
+            }
+            return m_status;
+#else
+            static_cast<void>(path);
+            static_cast<void>(numWorkers);
+            static_cast<void>(depth);
+            return m_status = BitFieldFileStatus::Unsupported;
+#endif
+        }
+
+        void close()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_freeCv.notify_all();
+            m_workCv.notify_all();
+            if (m_io.joinable()) {
+                m_io.join();
+            }
+            for (std::size_t w = 0; w < m_workers.size(); ++w) {
+                m_workers[w].join();
+            }
+            m_workers.clear();
+            m_queue.clear();
+            m_slots.clear();
+            m_cur = m_curEnd = nullptr;
+            closeFd();
+        }
+
+        BitFieldFileStatus status() const { return m_status; }
+
+        uint64_t size() const { return m_hdr.numRecords; }
+
+        /**
+         * Hands out the next decoded block, valid until the following call;
+         * returns false at the end of the stream or on error.
+         */
+        bool nextBlock(const value_type *& recs, size_type & n)
+        {
+            release();
+            if (m_nextBlock >= m_hdr.numBlocks || m_status != BitFieldFileStatus::Ok) {
+                return false;
+            }
+            const int s = static_cast<int>(m_nextBlock % m_slots.size());
+            Slot & slot = m_slots[s];
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                while (slot.state != Slot::READY) {
+                    m_readyCv.wait(lock);
+                }
+            }
+            m_held = s;
+            ++m_nextBlock;
+            if (slot.status != BitFieldFileStatus::Ok) {
+                m_status = slot.status;
+                return false;
+            }
+            recs = slot.records.data();
+            n = slot.count;
+            return true;
+        }
+
+        bool next(value_type & rec)
+        {
+            while (m_cur == m_curEnd) {
+                size_type n = 0;
+                if (!nextBlock(m_cur, n)) {
+                    m_cur = m_curEnd = nullptr;
+                    return false;
+                }
+                m_curEnd = m_cur + n;
+            }
+            rec = *m_cur++;
+            return true;
+        }
+
+        iterator begin() { return iterator(this); }
+        iterator end() { return iterator(); }
+
+      private:
+        struct Slot
+        {
+            enum State { FREE, READ, READY };
+
+            std::vector<uint64_t> raw;
+            std::vector<value_type> records;
+            size_type count = 0;
+            BitFieldFileStatus status = BitFieldFileStatus::Ok;
+            State state = FREE;
+        };
+
+        void closeFd()
+        {
+#if defined(CPPBITFIELD_HAS_POSIX_IO)
+            if (m_fd >= 0) {
+                ::close(m_fd);
+            }
+#endif
+            m_fd = -1;
+        }
+
+#if defined(CPPBITFIELD_HAS_POSIX_IO)
+        BitFieldFileStatus readHeader()
+        {
+            struct stat st;
+            if (::fstat(m_fd, &st) != 0) {
+                return BitFieldFileStatus::IoError;
+            }
+            if (static_cast<uint64_t>(st.st_size) < sizeof(m_hdr) ||
+                ::pread(m_fd, &m_hdr, sizeof(m_hdr), 0) != static_cast<ssize_t>(sizeof(m_hdr))) {
+                return BitFieldFileStatus::BadHeader;
+            }
+            if (std::memcmp(m_hdr.magic, detail::BITFIELD_STREAM_MAGIC, sizeof(m_hdr.magic)) != 0 ||
+                m_hdr.version != detail::BITFIELD_FILE_VERSION || m_hdr.byteOrder != detail::BITFIELD_FILE_BYTE_ORDER ||
+                m_hdr.headerSize < sizeof(m_hdr) || m_hdr.headerSize % sizeof(uint64_t) != 0 ||
+                m_hdr.recordsPerBlock == 0) {
+                return BitFieldFileStatus::BadHeader;
+            }
+            if (m_hdr.fingerprint != LayoutFingerprint<EnumType, Sizes>::value ||
+                m_hdr.recordBits != static_cast<uint32_t>(NumBits)) {
+                return BitFieldFileStatus::LayoutMismatch;
+            }
+            // bound the counts before any block arithmetic can wrap: a full
+            // block's bits must be countable, and every record takes NumBits
+            // bits of the file
+            if (m_hdr.recordsPerBlock > std::numeric_limits<uint64_t>::max() / NumBits) {
+                return BitFieldFileStatus::BadHeader;
+            }
+            if (m_hdr.numRecords > (static_cast<uint64_t>(st.st_size) / NumBits + 1) * 8) {
+                return BitFieldFileStatus::Truncated;
+            }
+            if (m_hdr.numBlocks != (m_hdr.numRecords + m_hdr.recordsPerBlock - 1) / m_hdr.recordsPerBlock) {
+                return BitFieldFileStatus::BadHeader;
+            }
+            const uint64_t last = m_hdr.numBlocks == 0 ? 0 : m_hdr.numBlocks - 1;
+            if (m_hdr.numBlocks > 0 &&
+                static_cast<uint64_t>(st.st_size) < blockOffset(last) + blockBytes(last)) {
+                return BitFieldFileStatus::Truncated;
+            }
+            return BitFieldFileStatus::Ok;
+        }
+#endif
+
+        uint64_t blockRecords(uint64_t k) const
+        {
+            return std::min(m_hdr.recordsPerBlock, m_hdr.numRecords - k * m_hdr.recordsPerBlock);
+        }
+
+        uint64_t blockBytes(uint64_t k) const
+        {
+            return sizeof(BitFieldBlockHeader) + detail::blockWords<NumBits>(blockRecords(k)) * sizeof(uint64_t);
+        }
+
+        uint64_t blockOffset(uint64_t k) const
+        {
+            return m_hdr.headerSize + k * blockBytes(0);
+        }
+
+        void release()
+        {
+            if (m_held >= 0) {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_slots[m_held].state = Slot::FREE;
+                }
+                m_freeCv.notify_one();
+                m_held = -1;
+            }
+        }
+
+        void ioLoop()
+        {
+#if defined(CPPBITFIELD_HAS_POSIX_IO)
+            for (uint64_t k = 0; k < m_hdr.numBlocks; ++k) {
+                Slot & slot = m_slots[k % m_slots.size()];
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    while (slot.state != Slot::FREE && !m_stop) {
+                        m_freeCv.wait(lock);
+                    }
+                    if (m_stop) {
+                        return;
+                    }
+                }
+                const uint64_t bytes = blockBytes(k);
+                const bool ok = readFully(reinterpret_cast<char *>(slot.raw.data()), bytes, blockOffset(k));
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (!ok) {
+                        slot.status = BitFieldFileStatus::IoError;
+                        slot.state = Slot::READY;
+                        m_readyCv.notify_all();
+                        return;
+                    }
+                    slot.state = Slot::READ;
+                    m_queue.push_back(k);
+                }
+                m_workCv.notify_one();
+            }
+#endif
+        }
+
+#if defined(CPPBITFIELD_HAS_POSIX_IO)
+        bool readFully(char * dst, uint64_t bytes, uint64_t offset) const
+        {
+            while (bytes > 0) {
+                const ssize_t got = ::pread(m_fd, dst, static_cast<std::size_t>(bytes), static_cast<off_t>(offset));
+                if (got <= 0) {
+                    return false;
+                }
+                dst += got;
+                bytes -= static_cast<uint64_t>(got);
+                offset += static_cast<uint64_t>(got);
+            }
+            return true;
+        }
+#endif
+
+        void workLoop()
+        {
+            for (;;) {
+                uint64_t k;
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    while (m_queue.empty() && !m_stop) {
+                        m_workCv.wait(lock);
+                    }
+                    if (m_queue.empty()) {
+                        return;
+                    }
+                    k = m_queue.front();
+                    m_queue.pop_front();
+                }
+                Slot & slot = m_slots[k % m_slots.size()];
+                decode(slot, blockRecords(k));
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    slot.state = Slot::READY;
+                }
+                m_readyCv.notify_all();
+            }
+        }
+
+        static void decode(Slot & slot, uint64_t expected)
+        {
+            BitFieldBlockHeader hdr;
+            std::memcpy(&hdr, slot.raw.data(), sizeof(hdr));
+            const uint64_t * words = slot.raw.data() + sizeof(hdr) / sizeof(uint64_t);
+            if (hdr.numRecords != expected ||
+                hdr.checksum != detail::blockChecksum(words, detail::blockWords<NumBits>(expected))) {
+                slot.status = BitFieldFileStatus::ChecksumMismatch;
+                return;
+            }
+            const std::size_t n = static_cast<std::size_t>(expected);
+            value_type * out = slot.records.data();
+            for (std::size_t i = 0; i < n; ++i) {
+                out[i] = value_type::fromBits(detail::RecordBits<StorageType, NumBits>::load(words, static_cast<uint64_t>(i) * NumBits));
+            }
+            slot.count = n;
+            slot.status = BitFieldFileStatus::Ok;
+        }
+
+        int m_fd;
+        BitFieldStreamHeader m_hdr;
+        BitFieldFileStatus m_status;
+
+        std::mutex m_mutex;
+        std::condition_variable m_freeCv;  // a slot was released by the consumer
+        std::condition_variable m_workCv;  // a block was read, or stop
+        std::condition_variable m_readyCv; // a block was decoded
+        bool m_stop;
+        std::deque<uint64_t> m_queue;
+        std::vector<Slot> m_slots;
+        std::thread m_io;
+        std::vector<std::thread> m_workers;
+
+        // consumer side
+        int m_held;
+        uint64_t m_nextBlock;
+        const value_type * m_cur;
+        const value_type * m_curEnd;
+    };
+
+} // namespace cppbitfield
+
+#define DEFINE_BITFIELD_STREAM_WRITER(N, X, Y) \
+    using N = cppbitfield::BitFieldStreamWriter<X, Y>
+
+#define DEFINE_BITFIELD_STREAM_READER(N, X, Y) \
+    using N = cppbitfield::BitFieldStreamReader<X, Y>
+
+#endif/*CPPBITFIELD_BITFIELD_STREAM_HPP*/
@@ -0,0 +1,337 @@
+/**
+ * \file bitfield_view.hpp
+ * \date Oct 16, 2026
+ */
+
+#ifndef CPPBITFIELD_BITFIELD_VIEW_HPP
+#define CPPBITFIELD_BITFIELD_VIEW_HPP
+
+#include <cppbitfield/bitfield.hpp>
+#include <cppbitfield/bitfield_endian.hpp>
+
+#include <cstddef>
+
+namespace cppbitfield {
+
+    namespace detail {
+
+        // Bits [Offset, Offset + Length) of a Size-byte integer stored in
+        // Endian byte order: one load of the Count bytes covering the field.
+        template <class Endian, int Size, int Offset, int Length,
+                  int First = Offset / 8, int Count = (Offset + Length + 7) / 8 - Offset / 8>
+        struct ByteField
+        {
+            static const int Shift = Offset % 8;
+            static const int Pos = Endian::position(Size, First, Count);
+
+            static uint64_t get(const unsigned char * p)
+            {
+                return (Endian::template load<Count>(p + Pos) >> Shift) & LowMask<uint64_t, Length>::value;
+            }
+
+            static void set(unsigned char * p, uint64_t val)
+            {
+                set(p, val, std::integral_constant<bool, ByteAligned<Offset, Length>::value>());
+            }
+
+          private:
+            static void set(unsigned char * p, uint64_t val, std::false_type)
+            {
+                static const uint64_t mask = LowMask<uint64_t, Length>::value;
+                const uint64_t w = Endian::template load<Count>(p + Pos);
+                Endian::template store<Count>(p + Pos, (w & ~(mask << Shift)) | (val << Shift));
+            }
+
+            // the field is exactly the bytes it covers: nothing to keep
+            static void set(unsigned char * p, uint64_t val, std::true_type)
+            {
+                Endian::template store<Count>(p + Pos, val);
+            }
+        };
+
+        // A field of up to 64 bits that starts mid-byte can touch 9 bytes:
+        // eight as one word plus the top byte, funnelled as in WordField.
+        template <class Endian, int Size, int Offset, int Length, int First>
+        struct ByteField<Endian, Size, Offset, Length, First, 9>
+        {
+            static const int Shift = Offset % 8;
+            static const int PosLo = Endian::position(Size, First, 8);
+            static const int PosHi = Endian::position(Size, First + 8, 1);
+
+            static uint64_t get(const unsigned char * p)
+            {
+                return ((Endian::template load<8>(p + PosLo) >> Shift) |
+                        (Endian::template load<1>(p + PosHi) << (64 - Shift))) & LowMask<uint64_t, Length>::value;
+            }
+
+            static void set(unsigned char * p, uint64_t val)
+            {
+                static const uint64_t mask = LowMask<uint64_t, Length>::value;
+                const uint64_t lo = Endian::template load<8>(p + PosLo);
+                const uint64_t hi = Endian::template load<1>(p + PosHi);
+                Endian::template store<8>(p + PosLo, (lo & ~(mask << Shift)) | (val << Shift));
+                Endian::template store<1>(p + PosHi, (hi & ~(mask >> (64 - Shift))) | (val >> (64 - Shift)));
+            }
+        };
+
+        // Unused low bits of a record whose size is not a whole number of
+        // bytes: MSB-first layouts start at the top of the first byte, so
+        // their padding sits below the record instead of above it.
+        template <class Sizes>
+        struct ViewPad
+        {
+            static const int value = std::is_same<typename Sizes::BitOrder, MsbFirst>::value ?
+                                     (8 - Sizes::NumBits % 8) % 8 : 0;
+        };
+
+        // Record access on external bytes. Integer storage loads the whole
+        // record once and shifts and masks it like BitFields::get, so a view
+        // over a full-width little-endian record is one unaligned load;
+        // byte-aligned fields only touch their own bytes.
+        template <class Endian, class StorageType, int NumBits, int Pad>
+        struct ViewBits
+        {
+            static const int Size = (NumBits + 7) / 8;
+
+            using Access = BitsAccess<StorageType>;
+
+            static StorageType load(const unsigned char * p)
+            {
+                return static_cast<StorageType>((Endian::template load<Size>(p) >> Pad) & LowMask<uint64_t, NumBits>::value);
+            }
+
+            // padding bits of the first or last byte are preserved
+            static void store(unsigned char * p, StorageType bits)
+            {
+                static const uint64_t pad = ~(LowMask<uint64_t, NumBits>::value << Pad) & LowMask<uint64_t, 8 * Size>::value;
+                const uint64_t keep = pad != 0 ? Endian::template load<Size>(p) & pad : 0;
+                Endian::template store<Size>(p, keep | (static_cast<uint64_t>(bits) << Pad));
+            }
+
+            template <int Offset, int Length>
+            static StorageType get(const unsigned char * p)
+            {
+                return get<Offset, Length>(p, std::integral_constant<bool, ByteAligned<Offset + Pad, Length>::value>());
+            }
+
+            template <int Offset, int Length>
+            static void set(unsigned char * p, StorageType val)
+            {
+                set<Offset, Length>(p, val, std::integral_constant<bool, ByteAligned<Offset + Pad, Length>::value>());
+            }
+
+          private:
+            template <int Offset, int Length>
+            static StorageType get(const unsigned char * p, std::false_type)
+            {
+                return Access::template get<Offset + Pad, Length>(static_cast<StorageType>(Endian::template load<Size>(p)));
+            }
+
+            template <int Offset, int Length>
+            static StorageType get(const unsigned char * p, std::true_type)
+            {
+                return static_cast<StorageType>(ByteField<Endian, Size, Offset + Pad, Length>::get(p));
+            }
+
+            template <int Offset, int Length>
+            static void set(unsigned char * p, StorageType val, std::false_type)
+            {
+                StorageType bits = static_cast<StorageType>(Endian::template load<Size>(p));
+                Access::template set<Offset + Pad, Length>(bits, val);
+                Endian::template store<Size>(p, static_cast<uint64_t>(bits));
+            }
+
+            template <int Offset, int Length>
+            static void set(unsigned char * p, StorageType val, std::true_type)
+            {
+                ByteField<Endian, Size, Offset + Pad, Length>::set(p, static_cast<uint64_t>(val));
+            }
+        };
+
+        // Multi-word storage touches only the bytes covering each field.
+        template <class Endian, int NumWords, int NumBits, int Pad>
+        struct ViewBits<Endian, WordArray<NumWords>, NumBits, Pad>
+        {
+            static const int Size = (NumBits + 7) / 8;
+
+            template <int W>
+            struct Word : ByteField<Endian, Size, Pad + 64 * W, (W == NumWords - 1 ? NumBits - 64 * W : 64)> { };
+
+            static WordArray<NumWords> load(const unsigned char * p)
+            {
+                return load(p, typename MakeIndexSeq<NumWords>::type());
+            }
+
+            static void store(unsigned char * p, const WordArray<NumWords> & bits)
+            {
+                store(p, bits, typename MakeIndexSeq<NumWords>::type());
+            }
+
+            template <int Offset, int Length>
+            static uint64_t get(const unsigned char * p)
+            {
+                return ByteField<Endian, Size, Offset + Pad, Length>::get(p);
+            }
+
+            template <int Offset, int Length>
+            static void set(unsigned char * p, uint64_t val)
+            {
+                ByteField<Endian, Size, Offset + Pad, Length>::set(p, val);
+            }
+
+          private:
+            template <int... Is>
+            static WordArray<NumWords> load(const unsigned char * p, IndexSeq<Is...>)
+            {
+                return WordArray<NumWords>{ { Word<Is>::get(p)... } };
+            }
+
+            template <int... Is>
+            static void store(unsigned char * p, const WordArray<NumWords> & bits, IndexSeq<Is...>)
+            {
+                const int expand[] = { (Word<Is>::set(p, bits.words[Is]), 0)... };
+                static_cast<void>(expand);
+            }
+        };
+
+    } // namespace detail
+
+    /**
+     * Non-owning, read-only view of one record stored in an external byte
+     * buffer at any alignment. The record occupies (NumBits + 7) / 8 bytes
+     * holding one integer in the Endian byte order (LittleEndian or
+     * BigEndian); fields are read in place without copying the record.
+     * With an MsbFirst layout and BigEndian bytes, the first field starts at
+     * the first bit on the wire, so protocol headers parse in place.
+     */
+    template <class EnumType, class Sizes, class Endian = LittleEndian>
+    class BitFieldsView
+    {
+      public:
+        using value_type = BitFields<EnumType, Sizes>;
+        using StorageType = typename value_type::StorageType;
+        using ValueType = typename value_type::ValueType;
+        using ByteOrder = Endian;
+
+        static const int NumBits = value_type::NumBits;
+
+        static const int SizeInBytes = (NumBits + 7) / 8;
+
+        template <EnumType X>
+        using Field = detail::FieldPos<value_type, value_type::template AsInt<X>::value>;
+
+        explicit BitFieldsView(const void * data) : m_data(static_cast<const unsigned char *>(data)) { }
+
+        template <EnumType X, class Y = ValueType>
+        Y get() const
+        {
+            return static_cast<Y>(Bits::template get<Field<X>::offset, Field<X>::length>(m_data));
+        }
+
+        // copy of the whole record
+        value_type load() const
+        {
+            return value_type::fromBits(Bits::load(m_data));
+        }
+
+        // view of the i-th record in a buffer of records stored back to back
+        BitFieldsView at(std::size_t i) const
+        {
+            return BitFieldsView(m_data + i * SizeInBytes);
+        }
+
+        const unsigned char * data() const
+        {
+            return m_data;
+        }
+
+      private:
+        using Bits = detail::ViewBits<Endian, StorageType, NumBits, detail::ViewPad<Sizes>::value>;
+
+        const unsigned char * m_data;
+    };
+
+    /**
+     * Mutable counterpart of BitFieldsView: set writes only the bytes
+     * covering the field (the whole record for integer storage).
+     */
+    template <class EnumType, class Sizes, class Endian = LittleEndian>
+    class MutableBitFieldsView
+    {
+      public:
+        using value_type = BitFields<EnumType, Sizes>;
+        using StorageType = typename value_type::StorageType;
+        using ValueType = typename value_type::ValueType;
+        using ByteOrder = Endian;
+
+        static const int NumBits = value_type::NumBits;
+
+        static const int SizeInBytes = (NumBits + 7) / 8;
+
+        template <EnumType X>
+        using Field = detail::FieldPos<value_type, value_type::template AsInt<X>::value>;
+
+        explicit MutableBitFieldsView(void * data) : m_data(static_cast<unsigned char *>(data)) { }
+
+        template <EnumType X, class Y = ValueType>
+        Y get() const
+        {
+            return static_cast<Y>(Bits::template get<Field<X>::offset, Field<X>::length>(m_data));
+        }
+
+        template <EnumType X, class Y>
+        void set(Y val)
+        {
+            const ValueType mask = detail::LowMask<ValueType, Field<X>::length>::value;
+            auto valtrunc = static_cast<ValueType>(static_cast<ValueType>(val) & mask);
+            CPPBITFIELD_ASSERT("Value too large for bitfield length." &&
+                               (static_cast<ValueType>(val) == valtrunc));
+            Bits::template set<Field<X>::offset, Field<X>::length>(m_data, valtrunc);
+        }
+
+        template <EnumType X>
+        void set(bool val)
+        {
+            set<X>(static_cast<ValueType>(val ? 1 : 0));
+        }
+
+        value_type load() const
+        {
+            return value_type::fromBits(Bits::load(m_data));
+        }
+
+        void store(const value_type & val)
+        {
+            Bits::store(m_data, val.bits());
+        }
+
+        MutableBitFieldsView at(std::size_t i) const
+        {
+            return MutableBitFieldsView(m_data + i * SizeInBytes);
+        }
+
+        unsigned char * data() const
+        {
+            return m_data;
+        }
+
+        operator BitFieldsView<EnumType, Sizes, Endian>() const
+        {
+            return BitFieldsView<EnumType, Sizes, Endian>(m_data);
+        }
+
+      private:
+        using Bits = detail::ViewBits<Endian, StorageType, NumBits, detail::ViewPad<Sizes>::value>;
+
+        unsigned char * m_data;
+    };
+
+} // namespace cppbitfield
+
+#define DEFINE_BITFIELDS_VIEW(N, X, Y, E) \
+    using N = cppbitfield::BitFieldsView<X, Y, cppbitfield::E>
+
+#define DEFINE_MUTABLE_BITFIELDS_VIEW(N, X, Y, E) \
+    using N = cppbitfield::MutableBitFieldsView<X, Y, cppbitfield::E>
+
+#endif/*CPPBITFIELD_BITFIELD_VIEW_HPP*/
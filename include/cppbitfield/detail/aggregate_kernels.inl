@@ -0,0 +1,148 @@
+/**
+ * \file aggregate_kernels.inl
+ * \date Oct 16, 2026
+ *
+ * Field aggregation kernels, included by bitfield_aggregate.hpp into each
+ * instruction set namespace of bitfield_simd.hpp, with CPPBITFIELD_SIMD_FN
+ * carrying the target attribute. Every kernel reads one field of up to 32
+ * bits into 32-bit lanes, handles as many whole vectors as fit in `n`
+ * (at most AGGREGATE_BLOCK records, so 32-bit lane counters cannot wrap)
+ * and returns the number of records processed.
+ */
+
+template <int Offset, int Length>
+CPPBITFIELD_SIMD_FN Isa::V fieldLanes(const uint8_t * in)
+{
+    return Isa::and_(Isa::template srl32<Offset>(Isa::widen8(in)), Isa::set1_32(LowMask<uint32_t, Length>::value));
+}
+
+template <int Offset, int Length>
+CPPBITFIELD_SIMD_FN Isa::V fieldLanes(const uint16_t * in)
+{
+    return Isa::and_(Isa::template srl32<Offset>(Isa::widen16(in)), Isa::set1_32(LowMask<uint32_t, Length>::value));
+}
+
+template <int Offset, int Length>
+CPPBITFIELD_SIMD_FN Isa::V fieldLanes(const uint32_t * in)
+{
+    return Isa::and_(Isa::template srl32<Offset>(Isa::load32(in)), Isa::set1_32(LowMask<uint32_t, Length>::value));
+}
+
+template <int Offset, int Length>
+CPPBITFIELD_SIMD_FN Isa::V fieldLanes(const uint64_t * in)
+{
+    const Isa::V mask = Isa::set1_64(LowMask<uint64_t, Length>::value);
+    const Isa::V a = Isa::and_(Isa::template srl64<Offset>(Isa::load64(in)), mask);
+    const Isa::V b = Isa::and_(Isa::template srl64<Offset>(Isa::load64(in + Isa::N / 2)), mask);
+    return Isa::narrow64(a, b);
+}
+
+CPPBITFIELD_SIMD_FN uint64_t sumLanes64(Isa::V acc)
+{
+    uint64_t lanes[Isa::N / 2];
+    Isa::store64(lanes, acc);
+    uint64_t ret = 0;
+    for (std::size_t j = 0; j < Isa::N / 2; ++j) {
+        ret += lanes[j];
+    }
+    return ret;
+}
+
+template <int Offset, int Length, class T>
+CPPBITFIELD_SIMD_FN std::size_t sumField(const T * in, std::size_t n, uint64_t & total)
+{
+    Isa::V acc = Isa::set1_64(0);
+    Isa::V acc32 = Isa::set1_32(0);
+    std::size_t i = 0;
+    for (; i + Isa::N <= n; i += Isa::N) {
+        const Isa::V v = fieldLanes<Offset, Length>(in + i);
+        if (Length <= AGGREGATE_NARROW_SUM) {
+            acc32 = Isa::add32(acc32, v);
+        }
+        else {
+            acc = Isa::add64(acc, Isa::add64(Isa::widen32lo(v), Isa::widen32hi(v)));
+        }
+    }
+    acc = Isa::add64(acc, Isa::add64(Isa::widen32lo(acc32), Isa::widen32hi(acc32)));
+    total += sumLanes64(acc);
+    return i;
+}
+
+template <int Offset, int Length, class T>
+CPPBITFIELD_SIMD_FN std::size_t minmaxField(const T * in, std::size_t n, uint32_t & lo, uint32_t & hi)
+{
+    Isa::V vlo = Isa::set1_32(lo);
+    Isa::V vhi = Isa::set1_32(hi);
+    std::size_t i = 0;
+    for (; i + Isa::N <= n; i += Isa::N) {
+        const Isa::V v = fieldLanes<Offset, Length>(in + i);
+        vlo = Isa::min32u(vlo, v);
+        vhi = Isa::max32u(vhi, v);
+    }
+    uint32_t los[Isa::N], his[Isa::N];
+    Isa::store32(los, vlo);
+    Isa::store32(his, vhi);
+    for (std::size_t j = 0; j < Isa::N; ++j) {
+        lo = los[j] < lo ? los[j] : lo;
+        hi = his[j] > hi ? his[j] : hi;
+    }
+    return i;
+}
+
+template <int Offset, int Length, class T>
+CPPBITFIELD_SIMD_FN std::size_t countField(const T * in, std::size_t n, uint32_t value, uint64_t & total)
+{
+    const Isa::V val = Isa::set1_32(value);
+    // matching lanes are all ones, so subtracting counts them
+    Isa::V acc = Isa::set1_32(0);
+    std::size_t i = 0;
+    for (; i + Isa::N <= n; i += Isa::N) {
+        acc = Isa::sub32(acc, Isa::cmpeq32(fieldLanes<Offset, Length>(in + i), val));
+    }
+    total += sumLanes64(Isa::add64(Isa::widen32lo(acc), Isa::widen32hi(acc)));
+    return i;
+}
+
+/**
+ * Histogram of a field of up to 8 bits with one sub-histogram per lane:
+ * lane j of a vector increments sub[value * N + j], so the N increments of
+ * a vector never hit the same counter and equal neighbouring values do not
+ * serialize on one address. `sub` holds (1 << Length) * N zeroed counters;
+ * they are folded into counts[] before returning.
+ */
+template <int Offset, int Length, class T>
+CPPBITFIELD_SIMD_FN std::size_t histogramLanes(const T * in, std::size_t n, uint32_t * sub, uint64_t * counts)
+{
+    static const int LaneBits = Isa::N == 4 ? 2 : Isa::N == 8 ? 3 : 4;
+    static const uint32_t laneIds[16] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+    const Isa::V lanes = Isa::load32(laneIds);
+    uint32_t idx[Isa::N];
+    std::size_t i = 0;
+    for (; i + Isa::N <= n; i += Isa::N) {
+        Isa::store32(idx, Isa::or_(Isa::template sll32<LaneBits>(fieldLanes<Offset, Length>(in + i)), lanes));
+        for (std::size_t j = 0; j < Isa::N; ++j) {
+            ++sub[idx[j]];
+        }
+    }
+    for (std::size_t v = 0; v < (static_cast<std::size_t>(1) << Length); ++v) {
+        for (std::size_t j = 0; j < Isa::N; ++j) {
+            counts[v] += sub[v * Isa::N + j];
+        }
+    }
+    return i;
+}
+
+// Wider fields: a shared table is sparse enough that conflicts are rare.
+template <int Offset, int Length, class T>
+CPPBITFIELD_SIMD_FN std::size_t histogramField(const T * in, std::size_t n, uint64_t * counts)
+{
+    uint32_t vals[Isa::N];
+    std::size_t i = 0;
+    for (; i + Isa::N <= n; i += Isa::N) {
+        Isa::store32(vals, fieldLanes<Offset, Length>(in + i));
+        for (std::size_t j = 0; j < Isa::N; ++j) {
+            ++counts[vals[j]];
+        }
+    }
+    return i;
+}
@@ -0,0 +1,94 @@
+/**
+ * \file codec_kernels.inl
+ * \date Oct 16, 2026
+ *
+ * Block unpacking for compressed columns, included by bitfield_codec.hpp into
+ * each instruction set namespace of bitfield_simd.hpp, with
+ * CPPBITFIELD_SIMD_FN carrying the target attribute. A block holds
+ * CODEC_BLOCK values packed vertically over CODEC_LANES 32-bit lanes (see
+ * packVertical), so value k of lane j lands at out[k * CODEC_LANES + j] and
+ * every row of a vector's lanes is one fixed shift-and-mask of one or two
+ * loads. Widths are template parameters; each table below maps a run time
+ * width to its unrolled kernel.
+ */
+
+// Adds the frame of reference to every unpacked value.
+struct ForOp
+{
+    Isa::V base;
+
+    CPPBITFIELD_SIMD_FN Isa::V operator()(Isa::V v) { return Isa::add32(v, base); }
+};
+
+// Running sum down each lane: values are deltas from the value one row above.
+struct DeltaOp
+{
+    Isa::V acc;
+
+    CPPBITFIELD_SIMD_FN Isa::V operator()(Isa::V v) { return acc = Isa::add32(acc, v); }
+};
+
+template <int W, int K = 0, bool Done = (K == CODEC_ROWS)>
+struct UnpackRows
+{
+    static const int Bit = K * W;
+    static const int R = Bit / 32;
+    static const int S = Bit % 32;
+    static const bool Spill = S + W > 32;
+
+    template <class Op>
+    CPPBITFIELD_SIMD_FN static void run(const uint32_t * in, uint32_t * out, Isa::V mask, Op & op)
+    {
+        // zero width blocks have no payload to load
+        Isa::V v = mask;
+        if (W != 0) {
+            v = Isa::template srl32<S>(Isa::load32(in + R * CODEC_LANES));
+        }
+        if (Spill) {
+            v = Isa::or_(v, Isa::template sll32<(32 - S) % 32>(Isa::load32(in + (R + 1) * CODEC_LANES)));
+        }
+        Isa::store32(out + K * CODEC_LANES, op(Isa::and_(v, mask)));
+        UnpackRows<W, K + 1>::run(in, out, mask, op);
+    }
+};
+
+template <int W, int K>
+struct UnpackRows<W, K, true>
+{
+    template <class Op>
+    CPPBITFIELD_SIMD_FN static void run(const uint32_t *, uint32_t *, Isa::V, Op &) { }
+};
+
+template <int W>
+CPPBITFIELD_SIMD_FN void unpackFor(const uint32_t * in, uint32_t * out, uint32_t base)
+{
+    const Isa::V mask = Isa::set1_32(W == 0 ? 0 : LowMask<uint32_t, W == 0 ? 1 : W>::value);
+    for (std::size_t j = 0; j < CODEC_LANES; j += Isa::N) {
+        ForOp op = { Isa::set1_32(base) };
+        UnpackRows<W>::run(in + j, out + j, mask, op);
+    }
+}
+
+template <int W>
+CPPBITFIELD_SIMD_FN void unpackDelta(const uint32_t * in, uint32_t * out, uint32_t base)
+{
+    const Isa::V mask = Isa::set1_32(W == 0 ? 0 : LowMask<uint32_t, W == 0 ? 1 : W>::value);
+    for (std::size_t j = 0; j < CODEC_LANES; j += Isa::N) {
+        DeltaOp op = { Isa::set1_32(base) };
+        UnpackRows<W>::run(in + j, out + j, mask, op);
+    }
+}
+
+template <int... Ws>
+inline UnpackFn unpackForFn(int w, IndexSeq<Ws...>)
+{
+    static const UnpackFn fns[] = { &unpackFor<Ws>... };
+    return fns[w];
+}
+
+template <int... Ws>
+inline UnpackFn unpackDeltaFn(int w, IndexSeq<Ws...>)
+{
+    static const UnpackFn fns[] = { &unpackDelta<Ws>... };
+    return fns[w];
+}
@@ -0,0 +1,56 @@
+/**
+ * \file diff_kernels.inl
+ * \date Oct 16, 2026
+ *
+ * Vector search for the records that differ between two runs, included by
+ * bitfield_diff.hpp into each instruction set namespace of bitfield_simd.hpp,
+ * with CPPBITFIELD_SIMD_FN carrying the target attribute. Records narrower
+ * than 32 bits are widened to 32-bit lanes; 64-bit records use 64-bit lanes.
+ * Every kernel ORs one bit per differing record into a zeroed bitmap and
+ * returns the number of records processed.
+ */
+
+CPPBITFIELD_SIMD_FN std::size_t differ(const uint8_t * a, const uint8_t * b, std::size_t n, uint64_t * bitmap)
+{
+    const unsigned all = (1u << Isa::N) - 1;
+    std::size_t i = 0;
+    for (; i + Isa::N <= n; i += Isa::N) {
+        const unsigned same = Isa::movemask32(Isa::cmpeq32(Isa::widen8(a + i), Isa::widen8(b + i)));
+        bitmap[i >> 6] |= static_cast<uint64_t>(~same & all) << (i & 63);
+    }
+    return i;
+}
+
+CPPBITFIELD_SIMD_FN std::size_t differ(const uint16_t * a, const uint16_t * b, std::size_t n, uint64_t * bitmap)
+{
+    const unsigned all = (1u << Isa::N) - 1;
+    std::size_t i = 0;
+    for (; i + Isa::N <= n; i += Isa::N) {
+        const unsigned same = Isa::movemask32(Isa::cmpeq32(Isa::widen16(a + i), Isa::widen16(b + i)));
+        bitmap[i >> 6] |= static_cast<uint64_t>(~same & all) << (i & 63);
+    }
+    return i;
+}
+
+CPPBITFIELD_SIMD_FN std::size_t differ(const uint32_t * a, const uint32_t * b, std::size_t n, uint64_t * bitmap)
+{
+    const unsigned all = (1u << Isa::N) - 1;
+    std::size_t i = 0;
+    for (; i + Isa::N <= n; i += Isa::N) {
+        const unsigned same = Isa::movemask32(Isa::cmpeq32(Isa::load32(a + i), Isa::load32(b + i)));
+        bitmap[i >> 6] |= static_cast<uint64_t>(~same & all) << (i & 63);
+    }
+    return i;
+}
+
+CPPBITFIELD_SIMD_FN std::size_t differ(const uint64_t * a, const uint64_t * b, std::size_t n, uint64_t * bitmap)
+{
+    const std::size_t lanes = Isa::N / 2;
+    const unsigned all = (1u << lanes) - 1;
+    std::size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        const unsigned same = Isa::movemask64(Isa::cmpeq64(Isa::load64(a + i), Isa::load64(b + i)));
+        bitmap[i >> 6] |= static_cast<uint64_t>(~same & all) << (i & 63);
+    }
+    return i;
+}
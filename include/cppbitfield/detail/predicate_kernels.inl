@@ -0,0 +1,128 @@
+/**
+ * \file predicate_kernels.inl
+ * \date Oct 16, 2026
+ *
+ * Vector evaluation of a folded field predicate (detail::ConjTest), included
+ * by bitfield_predicate.hpp into each instruction set namespace of
+ * bitfield_simd.hpp, with CPPBITFIELD_SIMD_FN carrying the target attribute.
+ * Records narrower than 32 bits are widened to 32-bit lanes; 64-bit records
+ * use 64-bit lanes. Every kernel ORs one bit per record into a zeroed bitmap
+ * and returns the number of records processed.
+ */
+
+struct Lanes32
+{
+    static const std::size_t N = Isa::N;
+
+    CPPBITFIELD_SIMD_FN static Isa::V set1(uint64_t x) { return Isa::set1_32(static_cast<uint32_t>(x)); }
+    CPPBITFIELD_SIMD_FN static Isa::V sub(Isa::V a, Isa::V b) { return Isa::sub32(a, b); }
+    CPPBITFIELD_SIMD_FN static Isa::V eq(Isa::V a, Isa::V b) { return Isa::cmpeq32(a, b); }
+    CPPBITFIELD_SIMD_FN static unsigned movemask(Isa::V v) { return Isa::movemask32(v); }
+};
+
+struct Lanes64
+{
+    static const std::size_t N = Isa::N / 2;
+
+    CPPBITFIELD_SIMD_FN static Isa::V set1(uint64_t x) { return Isa::set1_64(x); }
+    CPPBITFIELD_SIMD_FN static Isa::V sub(Isa::V a, Isa::V b) { return Isa::sub64(a, b); }
+    CPPBITFIELD_SIMD_FN static Isa::V eq(Isa::V a, Isa::V b) { return Isa::cmpeq64(a, b); }
+    CPPBITFIELD_SIMD_FN static unsigned movemask(Isa::V v) { return Isa::movemask64(v); }
+};
+
+// ConjTest with every constant broadcast once, outside the loop.
+template <class L, int NumAny>
+struct MatchVec
+{
+    Isa::V eqMask, eqValue;
+    Isa::V maskA, topA, yLowA, yHighA, nyHighA;
+    Isa::V maskLowB, topB, xOrTopB, cxHighB, nxHighB;
+    Isa::V anyMask[NumAny + 1], anyValue[NumAny + 1];
+
+    CPPBITFIELD_SIMD_FN explicit MatchVec(const ConjTest<NumAny> & t)
+    {
+        eqMask = L::set1(t.eqMask);
+        eqValue = L::set1(t.eqValue);
+        maskA = L::set1(t.maskA);
+        topA = L::set1(t.topA);
+        yLowA = L::set1(t.constA & ~t.topA);
+        yHighA = L::set1(t.constA & t.topA);
+        nyHighA = L::set1(~t.constA & t.topA);
+        maskLowB = L::set1(t.maskB & ~t.topB);
+        topB = L::set1(t.topB);
+        xOrTopB = L::set1(t.constB | t.topB);
+        cxHighB = L::set1((t.constB & t.topB) ^ t.topB);
+        nxHighB = L::set1(~t.constB & t.topB);
+        for (int k = 0; k < NumAny; ++k) {
+            anyMask[k] = L::set1(t.anyMask[k]);
+            anyValue[k] = L::set1(t.anyValue[k]);
+        }
+    }
+
+    // all-ones lanes for matching records; same algebra as ConjTest::test
+    CPPBITFIELD_SIMD_FN Isa::V eval(Isa::V b) const
+    {
+        Isa::V ok = L::eq(Isa::and_(b, eqMask), eqValue);
+
+        const Isa::V xHighA = Isa::and_(b, topA);
+        const Isa::V tA = Isa::xor_(xHighA, nyHighA);
+        const Isa::V dA = Isa::xor_(L::sub(Isa::or_(Isa::and_(b, maskA), topA), yLowA), tA);
+        const Isa::V borrowA = Isa::or_(Isa::andnot_(xHighA, yHighA), Isa::and_(tA, dA));
+        ok = Isa::and_(ok, L::eq(borrowA, topA));
+
+        const Isa::V yHighB = Isa::and_(b, topB);
+        const Isa::V tB = Isa::xor_(cxHighB, yHighB);
+        const Isa::V dB = Isa::xor_(L::sub(xOrTopB, Isa::and_(b, maskLowB)), tB);
+        const Isa::V borrowB = Isa::or_(Isa::and_(yHighB, nxHighB), Isa::and_(tB, dB));
+        ok = Isa::and_(ok, L::eq(borrowB, topB));
+
+        for (int k = 0; k < NumAny; ++k) {
+            ok = Isa::andnot_(L::eq(Isa::and_(b, anyMask[k]), anyValue[k]), ok);
+        }
+        return ok;
+    }
+};
+
+template <int NumAny>
+CPPBITFIELD_SIMD_FN std::size_t match(const uint8_t * in, std::size_t n, const ConjTest<NumAny> & t, uint64_t * bitmap)
+{
+    const MatchVec<Lanes32, NumAny> m(t);
+    std::size_t i = 0;
+    for (; i + Lanes32::N <= n; i += Lanes32::N) {
+        bitmap[i >> 6] |= static_cast<uint64_t>(Lanes32::movemask(m.eval(Isa::widen8(in + i)))) << (i & 63);
+    }
+    return i;
+}
+
+template <int NumAny>
+CPPBITFIELD_SIMD_FN std::size_t match(const uint16_t * in, std::size_t n, const ConjTest<NumAny> & t, uint64_t * bitmap)
+{
+    const MatchVec<Lanes32, NumAny> m(t);
+    std::size_t i = 0;
+    for (; i + Lanes32::N <= n; i += Lanes32::N) {
+        bitmap[i >> 6] |= static_cast<uint64_t>(Lanes32::movemask(m.eval(Isa::widen16(in + i)))) << (i & 63);
+    }
+    return i;
+}
+
+template <int NumAny>
+CPPBITFIELD_SIMD_FN std::size_t match(const uint32_t * in, std::size_t n, const ConjTest<NumAny> & t, uint64_t * bitmap)
+{
+    const MatchVec<Lanes32, NumAny> m(t);
+    std::size_t i = 0;
+    for (; i + Lanes32::N <= n; i += Lanes32::N) {
+        bitmap[i >> 6] |= static_cast<uint64_t>(Lanes32::movemask(m.eval(Isa::load32(in + i)))) << (i & 63);
+    }
+    return i;
+}
+
+template <int NumAny>
+CPPBITFIELD_SIMD_FN std::size_t match(const uint64_t * in, std::size_t n, const ConjTest<NumAny> & t, uint64_t * bitmap)
+{
+    const MatchVec<Lanes64, NumAny> m(t);
+    std::size_t i = 0;
+    for (; i + Lanes64::N <= n; i += Lanes64::N) {
+        bitmap[i >> 6] |= static_cast<uint64_t>(Lanes64::movemask(m.eval(Isa::load64(in + i)))) << (i & 63);
+    }
+    return i;
+}
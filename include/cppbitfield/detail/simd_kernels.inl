@@ -0,0 +1,122 @@
+/**
+ * \file simd_kernels.inl
+ * \date Oct 16, 2026
+ *
+ * Batch extract/insert kernels, written once against an `Isa` struct and
+ * included by bitfield_simd.hpp once per instruction set. The including
+ * namespace provides `Isa` and defines CPPBITFIELD_SIMD_FN to carry the
+ * matching target attribute. Each kernel handles as many whole vectors as fit
+ * in `n` and returns the number of records processed; the caller finishes the
+ * tail with scalar code.
+ */
+
+// -- extract: StorageType -> uint32_t
+
+template <int Offset, int Length>
+CPPBITFIELD_SIMD_FN std::size_t extract(const uint8_t * in, std::size_t n, uint32_t * out)
+{
+    const Isa::V mask = Isa::set1_32(LowMask<uint32_t, Length>::value);
+    std::size_t i = 0;
+    for (; i + Isa::N <= n; i += Isa::N) {
+        Isa::V v = Isa::widen8(in + i);
+        Isa::store32(out + i, Isa::and_(Isa::template srl32<Offset>(v), mask));
+    }
+    return i;
+}
+
+template <int Offset, int Length>
+CPPBITFIELD_SIMD_FN std::size_t extract(const uint16_t * in, std::size_t n, uint32_t * out)
+{
+    const Isa::V mask = Isa::set1_32(LowMask<uint32_t, Length>::value);
+    std::size_t i = 0;
+    for (; i + Isa::N <= n; i += Isa::N) {
+        Isa::V v = Isa::widen16(in + i);
+        Isa::store32(out + i, Isa::and_(Isa::template srl32<Offset>(v), mask));
+    }
+    return i;
+}
+
+template <int Offset, int Length>
+CPPBITFIELD_SIMD_FN std::size_t extract(const uint32_t * in, std::size_t n, uint32_t * out)
+{
+    const Isa::V mask = Isa::set1_32(LowMask<uint32_t, Length>::value);
+    std::size_t i = 0;
+    for (; i + Isa::N <= n; i += Isa::N) {
+        Isa::V v = Isa::load32(in + i);
+        Isa::store32(out + i, Isa::and_(Isa::template srl32<Offset>(v), mask));
+    }
+    return i;
+}
+
+template <int Offset, int Length>
+CPPBITFIELD_SIMD_FN std::size_t extract(const uint64_t * in, std::size_t n, uint32_t * out)
+{
+    const Isa::V mask = Isa::set1_64(LowMask<uint64_t, Length>::value);
+    std::size_t i = 0;
+    for (; i + Isa::N <= n; i += Isa::N) {
+        Isa::V a = Isa::and_(Isa::template srl64<Offset>(Isa::load64(in + i)), mask);
+        Isa::V b = Isa::and_(Isa::template srl64<Offset>(Isa::load64(in + i + Isa::N / 2)), mask);
+        Isa::store32(out + i, Isa::narrow64(a, b));
+    }
+    return i;
+}
+
+// -- insert: uint32_t -> StorageType
+
+template <int Offset, int Length>
+CPPBITFIELD_SIMD_FN std::size_t insert(uint8_t * io, std::size_t n, const uint32_t * in)
+{
+    const Isa::V mask = Isa::set1_32(LowMask<uint32_t, Length>::value);
+    const Isa::V keep = Isa::set1_32(~(LowMask<uint32_t, Length>::value << Offset));
+    std::size_t i = 0;
+    for (; i + Isa::N <= n; i += Isa::N) {
+        Isa::V r = Isa::widen8(io + i);
+        Isa::V v = Isa::and_(Isa::load32(in + i), mask);
+        Isa::narrow8(io + i, Isa::or_(Isa::and_(r, keep), Isa::template sll32<Offset>(v)));
+    }
+    return i;
+}
+
+template <int Offset, int Length>
+CPPBITFIELD_SIMD_FN std::size_t insert(uint16_t * io, std::size_t n, const uint32_t * in)
+{
+    const Isa::V mask = Isa::set1_32(LowMask<uint32_t, Length>::value);
+    const Isa::V keep = Isa::set1_32(~(LowMask<uint32_t, Length>::value << Offset));
+    std::size_t i = 0;
+    for (; i + Isa::N <= n; i += Isa::N) {
+        Isa::V r = Isa::widen16(io + i);
+        Isa::V v = Isa::and_(Isa::load32(in + i), mask);
+        Isa::narrow16(io + i, Isa::or_(Isa::and_(r, keep), Isa::template sll32<Offset>(v)));
+    }
+    return i;
+}
+
+template <int Offset, int Length>
+CPPBITFIELD_SIMD_FN std::size_t insert(uint32_t * io, std::size_t n, const uint32_t * in)
+{
+    const Isa::V mask = Isa::set1_32(LowMask<uint32_t, Length>::value);
+    const Isa::V keep = Isa::set1_32(~(LowMask<uint32_t, Length>::value << Offset));
+    std::size_t i = 0;
+    for (; i + Isa::N <= n; i += Isa::N) {
+        Isa::V r = Isa::load32(io + i);
+        Isa::V v = Isa::and_(Isa::load32(in + i), mask);
+        Isa::store32(io + i, Isa::or_(Isa::and_(r, keep), Isa::template sll32<Offset>(v)));
+    }
+    return i;
+}
+
+template <int Offset, int Length>
+CPPBITFIELD_SIMD_FN std::size_t insert(uint64_t * io, std::size_t n, const uint32_t * in)
+{
+    const Isa::V mask = Isa::set1_32(LowMask<uint32_t, Length>::value);
+    const Isa::V keep = Isa::set1_64(~(LowMask<uint64_t, Length>::value << Offset));
+    std::size_t i = 0;
+    for (; i + Isa::N <= n; i += Isa::N) {
+        Isa::V v = Isa::and_(Isa::load32(in + i), mask);
+        Isa::V r0 = Isa::load64(io + i);
+        Isa::V r1 = Isa::load64(io + i + Isa::N / 2);
+        Isa::store64(io + i, Isa::or_(Isa::and_(r0, keep), Isa::template sll64<Offset>(Isa::widen32lo(v))));
+        Isa::store64(io + i + Isa::N / 2, Isa::or_(Isa::and_(r1, keep), Isa::template sll64<Offset>(Isa::widen32hi(v))));
+    }
+    return i;
+}
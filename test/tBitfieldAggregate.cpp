@@ -0,0 +1,140 @@
+/**
+ * \file tBitfieldAggregate.cpp
+ * \date Oct 16, 2026
+ */
+
+#include "unittest.hpp"
+#include "testutil.hpp"
+
+#include <cppbitfield/bitfield_aggregate.hpp>
+
+#include <vector>
+
+namespace {
+
+    using testutil::nextRand;
+
+    // sum, count and minmax of field X at every level and thread count
+    // against a loop of get<X>()
+    template <class Record, typename Record::FieldEnum X>
+    bool matchesLoop(const std::vector<Record> & recs)
+    {
+        const std::size_t n = recs.size();
+        uint64_t sum = 0, lo = ~0ULL, hi = 0, ones = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const uint64_t v = recs[i].template get<X, uint64_t>();
+            sum += v;
+            lo = v < lo ? v : lo;
+            hi = v > hi ? v : hi;
+            ones += v == 1 ? 1 : 0;
+        }
+
+        bool ok = true;
+        const unsigned threads[] = { 1, 3 };
+        testutil::forEachSimdLevel([&](cppbitfield::SimdLevel level) {
+            for (unsigned t : threads) {
+                ok = ok && cppbitfield::sum<Record, X>(recs.data(), n, level, t) == sum;
+                ok = ok && cppbitfield::count<Record, X>(recs.data(), n, 1, level, t) == ones;
+                if (n > 0) {
+                    const auto mm = cppbitfield::minmax<Record, X>(recs.data(), n, level, t);
+                    ok = ok && static_cast<uint64_t>(mm.first) == lo && static_cast<uint64_t>(mm.second) == hi;
+                }
+            }
+        });
+        return ok;
+    }
+
+    template <class Record, typename Record::FieldEnum X>
+    bool histogramMatches(const std::vector<Record> & recs)
+    {
+        const std::size_t numValues = static_cast<std::size_t>(1) << Record::template FieldLength<Record::template AsInt<X>::value>::value;
+        std::vector<uint64_t> expected(numValues, 0);
+        for (std::size_t i = 0; i < recs.size(); ++i) {
+            ++expected[recs[i].template get<X, uint64_t>()];
+        }
+        bool ok = true;
+        testutil::forEachSimdLevel([&](cppbitfield::SimdLevel level) {
+            for (unsigned t = 1; t <= 3; t += 2) {
+                std::vector<uint64_t> counts(numValues, 7);
+                cppbitfield::histogram<Record, X>(recs.data(), recs.size(), counts.data(), level, t);
+                ok = ok && counts == expected;
+            }
+        });
+        return ok;
+    }
+
+} // namespace
+
+CPP_TEST( storages )
+{
+    DEFINE_BITFIELD_ENUM(E8, Flag, Prio, State);
+    DEFINE_BITFIELD_SIZES(S8, 1, 2, 5);
+    DEFINE_BITFIELDS(R8, E8, S8);
+
+    DEFINE_BITFIELD_ENUM(E16, Low, Mid);
+    DEFINE_BITFIELD_SIZES(S16, 3, 13);
+    DEFINE_BITFIELDS(R16, E16, S16);
+
+    DEFINE_BITFIELD_ENUM(E32, Tag, Value);
+    DEFINE_BITFIELD_SIZES(S32, 1, 31);
+    DEFINE_BITFIELDS(R32, E32, S32);
+
+    DEFINE_BITFIELD_ENUM(E64, State, Word, Wide);
+    DEFINE_BITFIELD_SIZES(S64, 4, 32, 28);
+    DEFINE_BITFIELDS(R64, E64, S64);
+
+    DEFINE_BITFIELD_ENUM(EW, Bit, Huge);
+    DEFINE_BITFIELD_SIZES(SW, 2, 40);
+    DEFINE_BITFIELDS(RW, EW, SW);
+
+    uint64_t seed = 17;
+    bool ok = true;
+    const std::size_t sizes[] = { 0, 1, 15, 16, 17, 1000 };
+    for (std::size_t n : sizes) {
+        std::vector<R8> r8(n);
+        std::vector<R16> r16(n);
+        std::vector<R32> r32(n);
+        std::vector<R64> r64(n);
+        std::vector<RW> rw(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            r8[i] = R8::fromBits(static_cast<uint8_t>(nextRand(seed)));
+            r16[i] = R16::fromBits(static_cast<uint16_t>(nextRand(seed)));
+            r32[i] = R32::fromBits(static_cast<uint32_t>(nextRand(seed)));
+            r64[i] = R64::fromBits(nextRand(seed) ^ (nextRand(seed) << 40));
+            rw[i] = RW::fromBits(nextRand(seed) & 0x3FFFFFFFFFFULL);
+        }
+        ok = ok && matchesLoop<R8, E8::Flag>(r8) && matchesLoop<R8, E8::State>(r8);
+        ok = ok && matchesLoop<R16, E16::Mid>(r16);
+        ok = ok && matchesLoop<R32, E32::Value>(r32);
+        ok = ok && matchesLoop<R64, E64::State>(r64) && matchesLoop<R64, E64::Word>(r64);
+        ok = ok && matchesLoop<RW, EW::Huge>(rw) && matchesLoop<RW, EW::Bit>(rw);
+        ok = ok && histogramMatches<R8, E8::Flag>(r8) && histogramMatches<R8, E8::State>(r8);
+        ok = ok && histogramMatches<R16, E16::Mid>(r16) && histogramMatches<R64, E64::State>(r64);
+        ok = ok && histogramMatches<RW, EW::Bit>(rw);
+    }
+    TEST_TRUE(ok);
+}
+
+CPP_TEST( histograms )
+{
+    DEFINE_BITFIELD_ENUM(E, Prio, State, Code);
+    DEFINE_BITFIELD_SIZES(S, 2, 8, 16);
+    DEFINE_BITFIELDS(R, E, S);
+
+    // long runs of one value, the case per-lane counters exist for, plus
+    // more records than one block so partial counters are folded
+    const std::size_t n = (1 << 20) + 1000;
+    std::vector<R> recs(n);
+    uint64_t seed = 23;
+    for (std::size_t i = 0; i < n; ++i) {
+        const uint64_t r = nextRand(seed);
+        recs[i] = R::make(E::Prio, (i / 5000) % 4, E::State, i < n / 2 ? 200 : r % 256, E::Code, (r >> 40) & 0xFFFF);
+    }
+    TEST_TRUE((histogramMatches<R, E::Prio>(recs)));
+    TEST_TRUE((histogramMatches<R, E::State>(recs)));
+    TEST_TRUE((histogramMatches<R, E::Code>(recs)));
+    TEST_TRUE((cppbitfield::count<R, E::State>(recs.data(), n, 200, cppbitfield::simdLevel(), 0) >= n / 2));
+    TEST_TRUE((cppbitfield::count<R, E::Prio>(recs.data(), n, 4) == 0));
+    TEST_TRUE((cppbitfield::sum<R, E::Code>(recs.data(), n, cppbitfield::simdLevel(), 4) ==
+               cppbitfield::sum<R, E::Code>(recs.data(), n, cppbitfield::SimdLevel::Scalar)));
+}
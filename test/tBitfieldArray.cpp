@@ -0,0 +1,244 @@
+/**
+ * \file tBitfieldArray.cpp
+ * \date Oct 16, 2026
+ */
+
+#include "unittest.hpp"
+
+#include <cppbitfield/bitfield_array.hpp>
+
+CPP_TEST( t0 )
+{
+    DEFINE_BITFIELD_ENUM(
+         FooEnum,
+               A,
+               B,
+               C);
+
+    // 21 bits per record: stored in a uint32_t by BitFields
+    DEFINE_BITFIELD_SIZES(
+        FooSizes,
+               3,
+               7,
+              11);
+
+    DEFINE_BITFIELDS(
+        Foo,
+        FooEnum,
+        FooSizes);
+
+    DEFINE_BITFIELD_ARRAY(
+        FooArray,
+        FooEnum,
+        FooSizes);
+
+    TEST_TRUE(FooArray::NumBits == 21);
+
+    const size_t n = 1000;
+    FooArray arr(n);
+    TEST_TRUE(arr.size() == n);
+    TEST_TRUE(arr.numWords() == (n * 21 + 63) / 64);
+    TEST_TRUE(arr.sizeInBytes() < n * sizeof(Foo));
+
+    for (size_t i = 0; i < n; ++i) {
+        TEST_TRUE(arr.get<FooEnum::A>(i) == 0);
+        TEST_TRUE(arr.get<FooEnum::B>(i) == 0);
+        TEST_TRUE(arr.get<FooEnum::C>(i) == 0);
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        arr.set<FooEnum::A>(i, i % 8);
+        arr.set<FooEnum::B>(i, (i * 7) % 128);
+        arr.set<FooEnum::C>(i, (i * 13) % 2048);
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        TEST_TRUE(arr.get<FooEnum::A>(i) == i % 8);
+        TEST_TRUE(arr.get<FooEnum::B>(i) == (i * 7) % 128);
+        TEST_TRUE(arr.get<FooEnum::C>(i) == (i * 13) % 2048);
+
+        Foo rec = arr.get(i);
+        TEST_TRUE(rec.get<FooEnum::A>() == i % 8);
+        TEST_TRUE(rec.get<FooEnum::B>() == (i * 7) % 128);
+        TEST_TRUE(rec.get<FooEnum::C>() == (i * 13) % 2048);
+    }
+
+    // overwriting one field must leave the neighbouring records untouched
+    arr.set<FooEnum::C>(3, 2047);
+    arr.set<FooEnum::A>(4, true);
+    TEST_TRUE(arr.get<FooEnum::C>(3) == 2047);
+    TEST_TRUE(arr.get<FooEnum::B>(3) == 21);
+    TEST_TRUE(arr.get<FooEnum::A>(4) == 1);
+    TEST_TRUE(arr.get<FooEnum::B>(4) == 28);
+    TEST_TRUE(arr.get<FooEnum::C>(2) == 26);
+}
+
+CPP_TEST( t1 )
+{
+    DEFINE_BITFIELD_ENUM(
+         BarEnum,
+               A,
+               B);
+
+    DEFINE_BITFIELD_SIZES(
+        BarSizes,
+               4,
+               5);
+
+    DEFINE_BITFIELDS(
+        Bar,
+        BarEnum,
+        BarSizes);
+
+    DEFINE_BITFIELD_ARRAY(
+        BarArray,
+        BarEnum,
+        BarSizes);
+
+    BarArray arr;
+    TEST_TRUE(arr.empty());
+
+    for (unsigned i = 0; i < 100; ++i) {
+        Bar rec;
+        rec.set<BarEnum::A>(i % 16);
+        rec.set<BarEnum::B>(i % 32);
+        arr.push_back(rec);
+    }
+    TEST_TRUE(arr.size() == 100);
+
+    unsigned i = 0;
+    for (BarArray::const_iterator it = arr.cbegin(); it != arr.cend(); ++it, ++i) {
+        Bar rec = *it;
+        TEST_TRUE(rec.get<BarEnum::A>() == i % 16);
+        TEST_TRUE(rec.get<BarEnum::B>() == i % 32);
+    }
+    TEST_TRUE(arr.end() - arr.begin() == 100);
+
+    // proxy access
+    arr[10].set<BarEnum::B>(31);
+    TEST_TRUE(arr[10].get<BarEnum::B>() == 31);
+    TEST_TRUE(arr[10].get<BarEnum::A>() == 10);
+    arr[11] = arr[10];
+    TEST_TRUE(arr.get<BarEnum::A>(11) == 10);
+    TEST_TRUE(arr.get<BarEnum::B>(11) == 31);
+
+    for (BarArray::iterator it = arr.begin(); it != arr.end(); ++it) {
+        (*it).set<BarEnum::A>(15);
+    }
+    for (i = 0; i < arr.size(); ++i) {
+        TEST_TRUE(arr.get<BarEnum::A>(i) == 15);
+    }
+
+    // shrinking clears the dropped records
+    arr.resize(7);
+    arr.resize(100);
+    TEST_TRUE(arr.get<BarEnum::A>(6) == 15);
+    TEST_TRUE(arr.get<BarEnum::A>(7) == 0);
+    TEST_TRUE(arr.get<BarEnum::B>(99) == 0);
+}
+
+CPP_TEST( t2 )
+{
+    DEFINE_BITFIELD_ENUM(
+         HdrEnum,
+               A,
+               B,
+               C);
+
+    // 90 bit records, multi-word storage in BitFields
+    DEFINE_BITFIELD_SIZES(
+        HdrSizes,
+              13,
+              64,
+              13);
+
+    DEFINE_BITFIELDS(
+        Hdr,
+        HdrEnum,
+        HdrSizes);
+
+    DEFINE_BITFIELD_ARRAY(
+        HdrArray,
+        HdrEnum,
+        HdrSizes);
+
+    HdrArray arr(50);
+    TEST_TRUE(arr.numWords() == (50 * 90 + 63) / 64);
+
+    for (size_t i = 0; i < arr.size(); ++i) {
+        Hdr rec;
+        rec.set<HdrEnum::A>(i);
+        rec.set<HdrEnum::B>(~static_cast<uint64_t>(i));
+        rec.set<HdrEnum::C>(8191 - i);
+        arr[i] = rec;
+    }
+
+    for (size_t i = 0; i < arr.size(); ++i) {
+        TEST_TRUE(arr.get<HdrEnum::A>(i) == i);
+        TEST_TRUE(arr.get<HdrEnum::B>(i) == ~static_cast<uint64_t>(i));
+        TEST_TRUE(arr.get<HdrEnum::C>(i) == 8191 - i);
+        Hdr rec = arr[i];
+        TEST_TRUE(rec.get<HdrEnum::B>() == ~static_cast<uint64_t>(i));
+        TEST_TRUE(rec.get<HdrEnum::C>() == 8191 - i);
+    }
+}
+
+CPP_TEST( t3 )
+{
+    DEFINE_BITFIELD_ENUM(
+         PktEnum,
+               Kind,
+               Port,
+               Flags,
+               Len);
+
+    // 56 bit records: Kind, Port and Len sit on byte boundaries of every
+    // record and are written with narrow stores, Flags is not
+    DEFINE_BITFIELD_SIZES(
+        PktSizes,
+               8,
+              16,
+               8,
+              24);
+
+    DEFINE_BITFIELD_ARRAY(
+        PktArray,
+        PktEnum,
+        PktSizes);
+
+    static_assert(cppbitfield::detail::ByteAligned<8, 16>::value, "Port is a narrow field");
+    static_assert(!cppbitfield::detail::ByteAligned<32, 24>::value, "24 bits is not an integer");
+
+    PktArray arr(37);
+    for (size_t i = 0; i < arr.size(); ++i) {
+        arr.set<PktEnum::Len>(i, 0xFFFFFF);
+        arr.set<PktEnum::Flags>(i, 0xFF);
+        arr.set<PktEnum::Kind>(i, i);
+        arr.set<PktEnum::Port>(i, 0xFF00 | i);
+    }
+    // overwrite every other record's Kind and Port; neighbours keep theirs
+    for (size_t i = 0; i < arr.size(); i += 2) {
+        arr.set<PktEnum::Kind>(i, 0xA5);
+        arr.set<PktEnum::Port>(i, 0x1234);
+    }
+    for (size_t i = 0; i < arr.size(); ++i) {
+        const bool even = i % 2 == 0;
+        TEST_TRUE(arr.get<PktEnum::Kind>(i) == (even ? 0xA5 : i));
+        TEST_TRUE(arr.get<PktEnum::Port>(i) == (even ? 0x1234 : (0xFF00 | i)));
+        TEST_TRUE(arr.get<PktEnum::Flags>(i) == 0xFF);
+        TEST_TRUE(arr.get<PktEnum::Len>(i) == 0xFFFFFF);
+    }
+
+    // 32 bit records move as one narrow word
+    DEFINE_BITFIELD_ENUM(WordEnum, Lo, Hi);
+    DEFINE_BITFIELD_SIZES(WordSizes, 16, 16);
+    DEFINE_BITFIELD_ARRAY(WordArray, WordEnum, WordSizes);
+    WordArray words(5);
+    for (size_t i = 0; i < words.size(); ++i) {
+        words[i] = WordArray::value_type::make(WordEnum::Lo, i, WordEnum::Hi, 0xBEEF);
+    }
+    for (size_t i = 0; i < words.size(); ++i) {
+        const WordArray::value_type rec = words[i];
+        TEST_TRUE(rec.get<WordEnum::Lo>() == i && rec.get<WordEnum::Hi>() == 0xBEEF);
+    }
+}
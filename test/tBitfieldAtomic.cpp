@@ -0,0 +1,108 @@
+/**
+ * \file tBitfieldAtomic.cpp
+ * \date Oct 16, 2026
+ */
+
+#include "unittest.hpp"
+
+#include <cppbitfield/bitfield_atomic.hpp>
+
+#include <thread>
+#include <vector>
+
+DEFINE_BITFIELD_ENUM(
+     StatusEnum,
+           RefCount,
+           State,
+           Flags);
+
+DEFINE_BITFIELD_SIZES(
+    StatusSizes,
+          20,
+           4,
+           8);
+
+DEFINE_BITFIELDS(
+    Status,
+    StatusEnum,
+    StatusSizes);
+
+DEFINE_ATOMIC_BITFIELDS(
+    AtomicStatus,
+    StatusEnum,
+    StatusSizes);
+
+CPP_TEST( t0 )
+{
+    AtomicStatus x;
+    TEST_TRUE(x.is_lock_free());
+    TEST_TRUE(x.load<StatusEnum::RefCount>() == 0);
+
+    x.store<StatusEnum::State>(3);
+    x.store<StatusEnum::Flags>(0x81);
+    TEST_TRUE(x.load<StatusEnum::State>() == 3);
+    TEST_TRUE(x.load<StatusEnum::Flags>(std::memory_order_acquire) == 0x81);
+    TEST_TRUE(x.load<StatusEnum::RefCount>() == 0);
+
+    uint32_t expected = 2;
+    TEST_TRUE(!x.compare_exchange<StatusEnum::State>(expected, 5));
+    TEST_TRUE(expected == 3);
+    TEST_TRUE(x.compare_exchange<StatusEnum::State>(expected, 5));
+    TEST_TRUE(x.load<StatusEnum::State>() == 5);
+    TEST_TRUE(x.load<StatusEnum::Flags>() == 0x81);
+
+    uint32_t prev = 0;
+    TEST_TRUE(x.fetch_add<StatusEnum::State>(10, prev));
+    TEST_TRUE(prev == 5);
+    TEST_TRUE(x.load<StatusEnum::State>() == 15);
+    // would carry into Flags
+    TEST_TRUE(!x.fetch_add<StatusEnum::State>(1, prev));
+    TEST_TRUE(prev == 15);
+    TEST_TRUE(x.load<StatusEnum::State>() == 15);
+    TEST_TRUE(x.load<StatusEnum::Flags>() == 0x81);
+
+    TEST_TRUE(!x.fetch_sub<StatusEnum::RefCount>(1, prev));
+    TEST_TRUE(prev == 0);
+    TEST_TRUE(x.load<StatusEnum::RefCount>() == 0);
+
+    x.update<StatusEnum::RefCount, StatusEnum::State, StatusEnum::Flags>(7, 1, true);
+    Status snap = x.load();
+    TEST_TRUE(snap.get<StatusEnum::RefCount>() == 7);
+    TEST_TRUE(snap.get<StatusEnum::State>() == 1);
+    TEST_TRUE(snap.get<StatusEnum::Flags>() == 1);
+
+    Status next = x.modify([](Status & s) { s.set<StatusEnum::Flags>(s.get<StatusEnum::State>() + 1); });
+    TEST_TRUE(next.get<StatusEnum::Flags>() == 2);
+    TEST_TRUE(x.load<StatusEnum::Flags>() == 2);
+    TEST_TRUE(x.load<StatusEnum::RefCount>() == 7);
+}
+
+CPP_TEST( t1 )
+{
+    // concurrent updates to different fields must not lose each other
+    AtomicStatus x;
+    const uint32_t iters = 20000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.push_back(std::thread([&x, iters]() {
+            uint32_t prev;
+            for (uint32_t i = 0; i < iters; ++i) {
+                x.fetch_add<StatusEnum::RefCount>(1, prev);
+            }
+        }));
+    }
+    threads.push_back(std::thread([&x, iters]() {
+        for (uint32_t i = 0; i < iters; ++i) {
+            x.store<StatusEnum::State>(i % 16);
+            x.update<StatusEnum::Flags>(i % 256);
+        }
+    }));
+    for (size_t t = 0; t < threads.size(); ++t) {
+        threads[t].join();
+    }
+
+    TEST_TRUE(x.load<StatusEnum::RefCount>() == 4 * iters);
+    TEST_TRUE(x.load<StatusEnum::State>() == (iters - 1) % 16);
+    TEST_TRUE(x.load<StatusEnum::Flags>() == (iters - 1) % 256);
+}
@@ -0,0 +1,93 @@
+/**
+ * \file tBitfieldBmi2.cpp
+ * \date Oct 16, 2026
+ */
+
+#include "unittest.hpp"
+#include "testutil.hpp"
+
+#include <cppbitfield/bitfield_bmi2.hpp>
+
+#include <vector>
+
+namespace {
+
+    using testutil::nextRand;
+
+} // namespace
+
+CPP_TEST( single )
+{
+    DEFINE_BITFIELD_ENUM(E, A, B, C, D, F);
+    DEFINE_BITFIELD_SIZES(S, 3, 9, 1, 20, 7);
+    DEFINE_BITFIELDS(R, E, S);
+
+    using Pack = cppbitfield::BitFieldPack<R>;
+    TEST_TRUE((Pack::PackedBits<E::A, E::C, E::F>::value == 11));
+
+    R x;
+    x.set<E::A, E::B, E::C, E::D, E::F>(5, 300, 1, 0xABCDE, 99);
+
+    for (int p = 0; p < 2; ++p) {
+        const bool usePext = p == 1;
+        // field order in the list does not change the packed layout
+        const uint64_t packed = Pack::gather<E::F, E::A, E::C>(x, usePext);
+        TEST_TRUE(packed == (5u | (1u << 3) | (99u << 4)));
+        TEST_TRUE(Pack::gather<E::B>(x, usePext) == 300);
+
+        R y = x;
+        Pack::scatter<E::A, E::C, E::F>(y, 2u | (0u << 3) | (17u << 4), usePext);
+        TEST_TRUE(y.get<E::A>() == 2);
+        TEST_TRUE(y.get<E::B>() == 300);
+        TEST_TRUE(y.get<E::C>() == 0);
+        TEST_TRUE(y.get<E::D>() == 0xABCDE);
+        TEST_TRUE(y.get<E::F>() == 17);
+    }
+}
+
+CPP_TEST( bulk )
+{
+    DEFINE_BITFIELD_ENUM(E, A, B, C, D);
+    DEFINE_BITFIELD_SIZES(S, 7, 23, 13, 21);
+    DEFINE_BITFIELDS(R, E, S);
+    DEFINE_BITFIELD_ARRAY(Arr, E, S);
+
+    using Pack = cppbitfield::BitFieldPack<R>;
+    const std::size_t n = 1000 + 7;
+    uint64_t seed = 3;
+    std::vector<R> recs(n);
+    Arr arr(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        recs[i] = R::fromBits(nextRand(seed) ^ (nextRand(seed) << 32));
+        arr.set(i, recs[i]);
+    }
+    std::vector<uint64_t> vals(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        vals[i] = nextRand(seed) & ((1ULL << 34) - 1);
+    }
+
+    for (int p = 0; p < 2; ++p) {
+        const bool usePext = p == 1;
+        std::vector<uint64_t> out(n), outArr(n);
+        Pack::gather<E::A, E::D>(recs.data(), n, out.data(), usePext);
+        Pack::gather<E::A, E::D>(arr, outArr.data(), usePext);
+        bool ok = true;
+        for (std::size_t i = 0; i < n; ++i) {
+            ok = ok && out[i] == Pack::gather<E::A, E::D>(recs[i], false);
+            ok = ok && outArr[i] == out[i];
+        }
+        TEST_TRUE(ok);
+
+        std::vector<R> ins(recs);
+        Arr insArr(arr);
+        Pack::scatter<E::D, E::B>(ins.data(), n, vals.data(), usePext);
+        Pack::scatter<E::D, E::B>(insArr, vals.data(), usePext);
+        for (std::size_t i = 0; i < n; ++i) {
+            R expected = recs[i];
+            expected.set<E::B, E::D>(vals[i] & ((1 << 23) - 1), vals[i] >> 23);
+            ok = ok && ins[i].bits() == expected.bits();
+            ok = ok && insArr.get(i).bits() == expected.bits();
+        }
+        TEST_TRUE(ok);
+    }
+}
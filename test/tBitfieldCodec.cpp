@@ -0,0 +1,135 @@
+/**
+ * \file tBitfieldCodec.cpp
+ * \date Oct 16, 2026
+ */
+
+#include "unittest.hpp"
+#include "testutil.hpp"
+
+#include <cppbitfield/bitfield_codec.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+    using testutil::nextRand;
+
+    bool roundTrips(const std::vector<uint32_t> & vals)
+    {
+        const cppbitfield::CompressedColumn col = cppbitfield::CompressedColumn::encode(vals.data(), vals.size());
+        bool ok = col.size() == vals.size();
+        testutil::forEachSimdLevel([&](cppbitfield::SimdLevel level) {
+            std::vector<uint32_t> out(vals.size() + 1, 0xDEADBEEF);
+            col.decode(out.data(), level);
+            ok = ok && std::equal(vals.begin(), vals.end(), out.begin()) && out.back() == 0xDEADBEEF;
+        });
+        return ok;
+    }
+
+    // the ragged last block is left out: its padding favours run-length
+    bool fullBlocks(const cppbitfield::CompressedColumn & col, cppbitfield::ColumnEncoding enc)
+    {
+        bool ok = col.numBlocks() > 1;
+        for (std::size_t b = 0; b + 1 < col.numBlocks(); ++b) {
+            ok = ok && col.blockEncoding(b) == enc;
+        }
+        return ok;
+    }
+
+} // namespace
+
+CPP_TEST( encodings )
+{
+    const std::size_t n = 10 * 512 + 77;
+    uint64_t seed = 9;
+    std::vector<uint32_t> state(n), seq(n), near(n), noise(n);
+    uint32_t s = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        // a few state changes in every block: a constant block bit-packs at width 0
+        if (i % 97 == 0) {
+            s = static_cast<uint32_t>((s + 1 + nextRand(seed) % 5) % 6);
+        }
+        state[i] = s;
+        seq[i] = static_cast<uint32_t>(1000000 + 3 * i + nextRand(seed) % 3);
+        near[i] = static_cast<uint32_t>(700000 + nextRand(seed) % 100);
+        noise[i] = static_cast<uint32_t>(nextRand(seed));
+    }
+
+    typedef cppbitfield::CompressedColumn Col;
+    const Col cState = Col::encode(state.data(), n);
+    const Col cSeq = Col::encode(seq.data(), n);
+    const Col cNear = Col::encode(near.data(), n);
+    const Col cNoise = Col::encode(noise.data(), n);
+
+    TEST_TRUE(fullBlocks(cState, cppbitfield::ColumnEncoding::RunLength));
+    TEST_TRUE(fullBlocks(cSeq, cppbitfield::ColumnEncoding::Delta));
+    TEST_TRUE(fullBlocks(cNear, cppbitfield::ColumnEncoding::FrameOfReference));
+    TEST_TRUE(fullBlocks(cNoise, cppbitfield::ColumnEncoding::BitPack));
+
+    // a 3-bit state field packed at full length would take 3 bits per value
+    TEST_TRUE(cState.sizeInBytes() * 8 * 3 < n * 3);
+
+    TEST_TRUE(roundTrips(state));
+    TEST_TRUE(roundTrips(seq));
+    TEST_TRUE(roundTrips(near));
+    TEST_TRUE(roundTrips(noise));
+}
+
+CPP_TEST( widths )
+{
+    // every width, block-sized and ragged, plus constant blocks (zero width)
+    uint64_t seed = 4;
+    bool ok = true;
+    for (int w = 0; w <= 32; ++w) {
+        const std::size_t n = 512 * 2 + static_cast<std::size_t>(w) * 5;
+        std::vector<uint32_t> vals(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            vals[i] = static_cast<uint32_t>(nextRand(seed) & cppbitfield::detail::lowMask64(w));
+            if (w == 0) {
+                vals[i] = 42;
+            }
+        }
+        ok = ok && roundTrips(vals);
+        std::vector<uint32_t> sorted(vals);
+        std::sort(sorted.begin(), sorted.end());
+        ok = ok && roundTrips(sorted);
+    }
+    TEST_TRUE(ok);
+    TEST_TRUE(roundTrips(std::vector<uint32_t>(1, 7)));
+    TEST_TRUE(cppbitfield::CompressedColumn::encode(nullptr, 0).numBlocks() == 0);
+}
+
+CPP_TEST( fields )
+{
+    DEFINE_BITFIELD_ENUM(E, State, Seq, Payload);
+    DEFINE_BITFIELD_SIZES(S, 3, 20, 9);
+    DEFINE_BITFIELDS(R, E, S);
+
+    const std::size_t n = 3000;
+    std::vector<R> recs(n), back(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        recs[i] = R::make(E::State, (i / 700) % 8, E::Seq, i, E::Payload, (i * 37) & 0x1FF);
+        back[i] = R::make(E::Payload, (i * 37) & 0x1FF);
+    }
+    const cppbitfield::CompressedColumn st = cppbitfield::compressField<R, E::State>(recs.data(), n);
+    const cppbitfield::CompressedColumn sq = cppbitfield::compressField<R, E::Seq>(recs.data(), n);
+    cppbitfield::decompressField<R, E::State>(st, back.data());
+    cppbitfield::decompressField<R, E::Seq>(sq, back.data());
+    bool same = true;
+    for (std::size_t i = 0; i < n; ++i) {
+        same = same && back[i].bits() == recs[i].bits();
+    }
+    TEST_TRUE(same);
+    TEST_TRUE(st.sizeInBytes() < n * 3 / 8 / 3);
+
+    DEFINE_BITFIELD_COLUMNS(Cols, E, S);
+    Cols cols(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        cols.set(i, recs[i]);
+    }
+    const cppbitfield::CompressedColumn cc = cppbitfield::compressColumn(cols.column<E::Seq>());
+    std::vector<uint32_t> out(n);
+    cc.decode(out.data());
+    TEST_TRUE(out[0] == 0 && out[n - 1] == n - 1);
+}
@@ -0,0 +1,84 @@
+/**
+ * \file tBitfieldColumns.cpp
+ * \date Oct 16, 2026
+ */
+
+#include "unittest.hpp"
+
+#include <cppbitfield/bitfield_columns.hpp>
+
+CPP_TEST( t0 )
+{
+    DEFINE_BITFIELD_ENUM(
+         FooEnum,
+               State,
+               Prio,
+               Id);
+
+    DEFINE_BITFIELD_SIZES(
+        FooSizes,
+               3,
+               2,
+              20);
+
+    DEFINE_BITFIELDS(
+        Foo,
+        FooEnum,
+        FooSizes);
+
+    DEFINE_BITFIELD_COLUMNS(
+        FooColumns,
+        FooEnum,
+        FooSizes);
+
+    const size_t n = 777;
+    FooColumns cols(n);
+    TEST_TRUE(cols.size() == n);
+
+    for (size_t i = 0; i < n; ++i) {
+        Foo rec;
+        rec.set<FooEnum::State>(i % 8);
+        rec.set<FooEnum::Prio>(i % 4);
+        rec.set<FooEnum::Id>(i * 1031 % (1 << 20));
+        cols[i] = rec;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        TEST_TRUE(cols.get<FooEnum::State>(i) == i % 8);
+        TEST_TRUE(cols.get<FooEnum::Prio>(i) == i % 4);
+        TEST_TRUE(cols.get<FooEnum::Id>(i) == i * 1031 % (1 << 20));
+
+        Foo rec = cols[i];
+        TEST_TRUE(rec.get<FooEnum::State>() == i % 8);
+        TEST_TRUE(rec.get<FooEnum::Prio>() == i % 4);
+        TEST_TRUE(rec.get<FooEnum::Id>() == i * 1031 % (1 << 20));
+    }
+
+    // a single field scan only reads its own column
+    FooColumns::Column<FooEnum::Prio> prio = cols.column<FooEnum::Prio>();
+    TEST_TRUE(prio.size() == n);
+    TEST_TRUE(prio.numWords() == (n * 2 + 63) / 64);
+    size_t sum = 0;
+    for (size_t i = 0; i < prio.size(); ++i) {
+        sum += prio[i];
+    }
+    size_t expected = 0;
+    for (size_t i = 0; i < n; ++i) {
+        expected += i % 4;
+    }
+    TEST_TRUE(sum == expected);
+
+    cols[5].set<FooEnum::Prio>(3);
+    cols.set<FooEnum::State>(6, true);
+    TEST_TRUE(cols[5].get<FooEnum::Prio>() == 3);
+    TEST_TRUE(cols[5].get<FooEnum::State>() == 5);
+    TEST_TRUE(cols.get<FooEnum::State>(6) == 1);
+    TEST_TRUE(cols.get<FooEnum::Id>(6) == 6 * 1031);
+
+    cols.resize(3);
+    cols.push_back(Foo());
+    TEST_TRUE(cols.size() == 4);
+    TEST_TRUE(cols.get<FooEnum::Id>(2) == 2 * 1031);
+    TEST_TRUE(cols.get<FooEnum::Id>(3) == 0);
+    TEST_TRUE(cols.get<FooEnum::State>(3) == 0);
+}
@@ -0,0 +1,219 @@
+/**
+ * \file tBitfieldDelta.cpp
+ * \date Oct 16, 2026
+ */
+
+#include "unittest.hpp"
+#include "testutil.hpp"
+
+#include <cppbitfield/bitfield_delta.hpp>
+
+#include <vector>
+
+using cppbitfield::DeltaStatus;
+using cppbitfield::SimdLevel;
+
+namespace {
+
+    using testutil::nextRand;
+
+    // Sets field `idx` of `rec` to a random value through the raw bits.
+    template <class Sizes, class Record>
+    Record randomField(uint64_t & seed, const Record & rec, int idx)
+    {
+        using Access = cppbitfield::detail::BitsAccess<typename Record::StorageType>;
+        return Record::fromBits(Access::put(rec.bits(), Sizes::offset(idx), Sizes::length(idx),
+                                            nextRand(seed) & cppbitfield::detail::lowMask64(Sizes::length(idx))));
+    }
+
+    // Random table and a copy with one record in `every` changed in one to
+    // three random fields.
+    template <class Sizes, class Record>
+    void randomVersions(uint64_t & seed, std::size_t n, int every, std::vector<Record> & prev, std::vector<Record> & next)
+    {
+        prev.assign(n, Record());
+        for (std::size_t i = 0; i < n; ++i) {
+            for (int f = 0; f < Sizes::NumFields; ++f) {
+                prev[i] = randomField<Sizes>(seed, prev[i], f);
+            }
+        }
+        next = prev;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (nextRand(seed) % every == 0) {
+                for (int k = 1 + static_cast<int>(nextRand(seed) % 3); k > 0; --k) {
+                    next[i] = randomField<Sizes>(seed, next[i], static_cast<int>(nextRand(seed) % Sizes::NumFields));
+                }
+            }
+        }
+    }
+
+    template <class Record>
+    std::size_t numDiffering(const std::vector<Record> & a, const std::vector<Record> & b)
+    {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            count += cppbitfield::diff(a[i], b[i]) != 0 ? 1 : 0;
+        }
+        return count;
+    }
+
+    template <class Record>
+    bool sameRecords(const std::vector<Record> & a, const std::vector<Record> & b)
+    {
+        return a.size() == b.size() && numDiffering(a, b) == 0;
+    }
+
+    template <class Enum, class Sizes>
+    bool checkRecords(uint64_t & seed, std::size_t n, int every)
+    {
+        using Delta = cppbitfield::DeltaStream<Enum, Sizes>;
+        using Record = typename Delta::value_type;
+        std::vector<Record> prev, next;
+        randomVersions<Sizes>(seed, n, every, prev, next);
+
+        bool ok = true;
+        testutil::forEachSimdLevel([&](SimdLevel level) {
+            const Delta delta = Delta::encode(prev.data(), next.data(), n, level);
+            std::vector<Record> replica = prev;
+            ok = ok && delta.numRecords() == n && delta.numChanges() == numDiffering(prev, next);
+            ok = ok && delta.apply(replica.data(), n) == DeltaStatus::Ok && sameRecords(replica, next);
+        });
+        return ok;
+    }
+
+    template <class Enum, class Sizes>
+    bool checkArrays(uint64_t & seed, std::size_t n, int every)
+    {
+        using Delta = cppbitfield::DeltaStream<Enum, Sizes>;
+        using Record = typename Delta::value_type;
+        using Array = cppbitfield::BitFieldArray<Enum, Sizes>;
+        std::vector<Record> prev, next;
+        randomVersions<Sizes>(seed, n, every, prev, next);
+        Array a(n), b(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            a.set(i, prev[i]);
+            b.set(i, next[i]);
+        }
+
+        bool ok = true;
+        testutil::forEachSimdLevel([&](SimdLevel level) {
+            const Delta delta = Delta::encode(a, b, level);
+            Array replica = a;
+            ok = ok && delta.numChanges() == numDiffering(prev, next);
+            ok = ok && delta.apply(replica) == DeltaStatus::Ok;
+            for (std::size_t w = 0; ok && w < replica.numWords(); ++w) {
+                ok = replica.words()[w] == b.words()[w];
+            }
+            // the same stream as from the records
+            const Delta fromRecords = Delta::encode(prev.data(), next.data(), n, level);
+            ok = ok && fromRecords.numWords() == delta.numWords();
+            for (std::size_t w = 0; ok && w < delta.numWords(); ++w) {
+                ok = fromRecords.words()[w] == delta.words()[w];
+            }
+        });
+        return ok;
+    }
+
+} // namespace
+
+CPP_TEST( roundTrip )
+{
+    DEFINE_BITFIELD_ENUM(E, A, B, C, D, F);
+    DEFINE_BITFIELD_SIZES(S8, 1, 2, 1, 3, 1);
+    DEFINE_BITFIELD_SIZES(S16, 3, 5, 1, 4, 2);
+    DEFINE_BITFIELD_SIZES(S32, 7, 12, 1, 3, 9);
+    DEFINE_BITFIELD_SIZES(S64, 33, 20, 1, 2, 8);
+    DEFINE_BITFIELD_SIZES(W, 60, 8, 64, 3, 64);
+
+    uint64_t seed = 11;
+    TEST_TRUE((checkRecords<E, S8>(seed, 5003, 10)));
+    TEST_TRUE((checkRecords<E, S16>(seed, 5003, 10)));
+    TEST_TRUE((checkRecords<E, S32>(seed, 5003, 100)));
+    TEST_TRUE((checkRecords<E, S64>(seed, 5003, 3)));
+    TEST_TRUE((checkRecords<E, W>(seed, 2001, 5)));
+    TEST_TRUE((checkRecords<E, S64>(seed, 150000, 1000)));
+}
+
+CPP_TEST( arrays )
+{
+    DEFINE_BITFIELD_ENUM(E, A, B, C, D);
+    DEFINE_BITFIELD_SIZES(S23, 3, 7, 1, 12);
+    DEFINE_BITFIELD_SIZES(S64, 40, 7, 1, 16);
+    DEFINE_BITFIELD_SIZES(W, 60, 8, 64, 3);
+
+    uint64_t seed = 17;
+    TEST_TRUE((checkArrays<E, S23>(seed, 20011, 50)));
+    TEST_TRUE((checkArrays<E, S23>(seed, 3, 1)));
+    TEST_TRUE((checkArrays<E, S64>(seed, 5003, 7)));
+    TEST_TRUE((checkArrays<E, W>(seed, 3001, 20)));
+}
+
+CPP_TEST( format )
+{
+    DEFINE_BITFIELD_ENUM(E, A, B, C, D, F);
+    DEFINE_BITFIELD_SIZES(S, 3, 9, 1, 12, 5);
+    DEFINE_BITFIELDS(R, E, S);
+    using Delta = cppbitfield::DeltaStream<E, S>;
+    const std::size_t header = cppbitfield::detail::DELTA_HEADER_WORDS;
+
+    // nothing changed: just the header
+    std::vector<R> prev(1000, R::make(E::A, 5, E::D, 77));
+    std::vector<R> next = prev;
+    Delta delta = Delta::encode(prev.data(), next.data(), prev.size());
+    TEST_TRUE(delta.empty() && delta.numWords() == header);
+    TEST_TRUE(delta.apply(prev.data(), prev.size()) == DeltaStatus::Ok && sameRecords(prev, next));
+
+    // one 3-bit field of record 0: gap width, flag, field index, value
+    next[0].set<E::A>(2);
+    delta = Delta::encode(prev.data(), next.data(), prev.size());
+    TEST_TRUE(delta.numChanges() == 1 && delta.words()[3] == 6 + 1 + 3 + 3);
+    TEST_TRUE(delta.words()[header] == (static_cast<uint64_t>(2) << 10 | 1u << 6));
+
+    // two fields of record 513: gap 513 in 6 + 9 bits, flag, mask, values
+    next[0] = prev[0];
+    next[513].set<E::C>(1);
+    next[513].set<E::F>(31);
+    delta = Delta::encode(prev.data(), next.data(), prev.size());
+    TEST_TRUE(delta.words()[3] == 6 + 9 + 1 + 5 + 1 + 5);
+    std::vector<R> replica = prev;
+    TEST_TRUE(delta.apply(replica.data(), replica.size()) == DeltaStatus::Ok && sameRecords(replica, next));
+    TEST_TRUE(delta.apply(replica.data(), replica.size() - 1) == DeltaStatus::SizeMismatch);
+}
+
+CPP_TEST( fromWords )
+{
+    DEFINE_BITFIELD_ENUM(E, A, B, C);
+    DEFINE_BITFIELD_SIZES(S, 4, 11, 6);
+    DEFINE_BITFIELD_SIZES(T, 4, 11, 7);
+    using Delta = cppbitfield::DeltaStream<E, S>;
+    using Other = cppbitfield::DeltaStream<E, T>;
+    using Record = Delta::value_type;
+
+    uint64_t seed = 23;
+    std::vector<Record> prev, next;
+    randomVersions<S>(seed, 4000, 20, prev, next);
+    const Delta sent = Delta::encode(prev.data(), next.data(), prev.size());
+    std::vector<uint64_t> wire(sent.words(), sent.words() + sent.numWords());
+
+    Delta received;
+    TEST_TRUE(Delta::fromWords(wire.data(), wire.size(), received) == DeltaStatus::Ok);
+    TEST_TRUE(received.numChanges() == sent.numChanges() && received.numRecords() == prev.size());
+    std::vector<Record> replica = prev;
+    TEST_TRUE(received.apply(replica.data(), replica.size()) == DeltaStatus::Ok && sameRecords(replica, next));
+
+    Other other;
+    TEST_TRUE(Other::fromWords(wire.data(), wire.size(), other) == DeltaStatus::LayoutMismatch);
+    TEST_TRUE(Delta::fromWords(wire.data(), 3, received) == DeltaStatus::BadHeader);
+    TEST_TRUE(Delta::fromWords(wire.data(), wire.size() - 1, received) == DeltaStatus::BadHeader);
+
+    // a table too small for the last entry, and one entry too many
+    std::vector<uint64_t> bad = wire;
+    bad[1] = next.size() / 2;
+    TEST_TRUE(Delta::fromWords(bad.data(), bad.size(), received) == DeltaStatus::Corrupt);
+    bad = wire;
+    bad[2] += 1;
+    TEST_TRUE(Delta::fromWords(bad.data(), bad.size(), received) == DeltaStatus::Corrupt);
+
+    // a rejected stream leaves the previous one in place
+    TEST_TRUE(received.numChanges() == sent.numChanges());
+}
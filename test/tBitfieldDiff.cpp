@@ -0,0 +1,204 @@
+/**
+ * \file tBitfieldDiff.cpp
+ * \date Oct 16, 2026
+ */
+
+#include "unittest.hpp"
+#include "testutil.hpp"
+
+#include <cppbitfield/bitfield_diff.hpp>
+#include <cppbitfield/bitfield_optimized.hpp>
+
+#include <vector>
+
+using cppbitfield::FieldChange;
+using cppbitfield::SimdLevel;
+
+namespace {
+
+    using testutil::nextRand;
+
+    // Field by field reference for single-word records.
+    template <class Sizes, class Record>
+    uint64_t naiveDiff(const Record & a, const Record & b)
+    {
+        const uint64_t x = static_cast<uint64_t>(a.bits()) ^ static_cast<uint64_t>(b.bits());
+        uint64_t mask = 0;
+        for (int i = 0; i < Sizes::NumFields; ++i) {
+            if (((x >> Sizes::offset(i)) & cppbitfield::detail::lowMask64(Sizes::length(i))) != 0) {
+                mask |= static_cast<uint64_t>(1) << i;
+            }
+        }
+        return mask;
+    }
+
+    // Random record with a few bits flipped in a copy.
+    template <class Record>
+    void randomPair(uint64_t & seed, Record & a, Record & b)
+    {
+        using StorageType = typename Record::StorageType;
+        const uint64_t used = cppbitfield::detail::lowMask64(Record::NumBits);
+        const uint64_t bits = nextRand(seed) & used;
+        uint64_t flip = 0;
+        for (int k = static_cast<int>(nextRand(seed) % 4); k > 0; --k) {
+            flip |= static_cast<uint64_t>(1) << (nextRand(seed) % Record::NumBits);
+        }
+        a = Record::fromBits(static_cast<StorageType>(bits));
+        b = Record::fromBits(static_cast<StorageType>(bits ^ flip));
+    }
+
+} // namespace
+
+CPP_TEST( single )
+{
+    DEFINE_BITFIELD_ENUM(E, A, B, C, D, F);
+    DEFINE_BITFIELD_SIZES(S, 1, 7, 12, 1, 3);
+    DEFINE_BITFIELDS(R, E, S);
+
+    const R a = R::make(E::A, 1, E::B, 100, E::C, 4000, E::D, 0, E::F, 5);
+    TEST_TRUE(cppbitfield::diff(a, a) == 0);
+    TEST_TRUE(cppbitfield::diff(a, a.with<E::C>(4001)) == 1u << 2);
+    TEST_TRUE(cppbitfield::diff(a, a.with<E::A>(0).with<E::F>(4)) == ((1u << 0) | (1u << 4)));
+    TEST_TRUE(cppbitfield::diff(a, a.with<E::B>(0)) == 1u << 1);
+
+    uint64_t seed = 3;
+    bool ok = true;
+    for (int i = 0; i < 20000; ++i) {
+        R x, y;
+        randomPair(seed, x, y);
+        ok = ok && cppbitfield::diff(x, y) == naiveDiff<S>(x, y);
+    }
+    TEST_TRUE(ok);
+
+    // full 64-bit storage: one bit fields at both ends, a 63-bit field
+    DEFINE_BITFIELD_ENUM(G, Lo, Mid, Hi);
+    DEFINE_BITFIELD_SIZES(T, 1, 62, 1);
+    DEFINE_BITFIELDS(Q, G, T);
+    DEFINE_BITFIELD_ENUM(H, Wide, Top);
+    DEFINE_BITFIELD_SIZES(U, 63, 1);
+    DEFINE_BITFIELDS(P, H, U);
+    for (int i = 0; i < 20000; ++i) {
+        Q x, y;
+        randomPair(seed, x, y);
+        ok = ok && cppbitfield::diff(x, y) == naiveDiff<T>(x, y);
+        P p, q;
+        randomPair(seed, p, q);
+        ok = ok && cppbitfield::diff(p, q) == naiveDiff<U>(p, q);
+    }
+    TEST_TRUE(ok);
+}
+
+CPP_TEST( layouts )
+{
+    DEFINE_BITFIELD_ENUM(E, A, B, C, D);
+    DEFINE_BITFIELD_LAYOUT(M, MsbFirst, 4, 4, 6, 2);
+    DEFINE_BITFIELDS(R, E, M);
+    using cppbitfield::BitFieldHints;
+    DEFINE_BITFIELD_SIZES(S, 3, 8, 5, 16);
+    using O = cppbitfield::OptimizedBitFields<E, S, BitFieldHints<E, E::C> >;
+    using L = cppbitfield::OptimizedLayout<S, BitFieldHints<E, E::C> >;
+
+    // masks are by field index, wherever the layout puts the fields
+    const R r = R::make(E::A, 9, E::D, 1);
+    TEST_TRUE(cppbitfield::diff(r, r.with<E::A>(8)) == 1u);
+    TEST_TRUE(cppbitfield::diff(r, r.with<E::D>(2)) == 1u << 3);
+
+    uint64_t seed = 5;
+    bool ok = true;
+    for (int i = 0; i < 20000; ++i) {
+        R x, y;
+        randomPair(seed, x, y);
+        ok = ok && cppbitfield::diff(x, y) == naiveDiff<M>(x, y);
+        O p, q;
+        randomPair(seed, p, q);
+        ok = ok && cppbitfield::diff(p, q) == naiveDiff<L>(p, q);
+    }
+    TEST_TRUE(ok);
+}
+
+CPP_TEST( multiWord )
+{
+    DEFINE_BITFIELD_ENUM(E, A, B, C, D);
+    DEFINE_BITFIELD_SIZES(S, 60, 8, 64, 3);
+    DEFINE_BITFIELDS(R, E, S);
+
+    R a;
+    a.set<E::A>(0x123456789ABCDEFULL);
+    a.set<E::B>(0xFF);
+    a.set<E::C>(0xFEDCBA9876543210ULL);
+
+    // B straddles the first two words, C the second and third
+    R b = a;
+    b.set<E::B>(0x0F);
+    TEST_TRUE(cppbitfield::diff(a, b) == 1u << 1);
+    b = a;
+    b.set<E::B>(0xF7);
+    TEST_TRUE(cppbitfield::diff(a, b) == 1u << 1);
+    b.set<E::C>(0x7EDCBA9876543210ULL);
+    b.set<E::D>(1);
+    TEST_TRUE(cppbitfield::diff(a, b) == ((1u << 1) | (1u << 2) | (1u << 3)));
+
+    std::vector<R> lhs(100, a);
+    std::vector<R> rhs(100, a);
+    rhs[7].set<E::A>(0);
+    rhs[99].set<E::C>(1);
+    std::vector<FieldChange> out(100);
+    TEST_TRUE(cppbitfield::diff(lhs.data(), rhs.data(), 100, out.data()) == 2);
+    TEST_TRUE(out[0].index == 7 && out[0].fields == 1u);
+    TEST_TRUE(out[1].index == 99 && out[1].fields == 1u << 2);
+}
+
+namespace {
+
+    template <class Record, class Sizes>
+    bool checkBulk(uint64_t & seed, std::size_t n)
+    {
+        using StorageType = typename Record::StorageType;
+        std::vector<Record> a(n);
+        std::vector<Record> b(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            a[i] = Record::fromBits(static_cast<StorageType>(nextRand(seed) & cppbitfield::detail::lowMask64(Record::NumBits)));
+            b[i] = a[i];
+            if (nextRand(seed) % 10 == 0) {
+                b[i] = Record::fromBits(static_cast<StorageType>(
+                    a[i].bits() ^ (static_cast<uint64_t>(1) << (nextRand(seed) % Record::NumBits))));
+            }
+        }
+        std::vector<FieldChange> expect;
+        for (std::size_t i = 0; i < n; ++i) {
+            const uint64_t m = naiveDiff<Sizes>(a[i], b[i]);
+            if (m != 0) {
+                const FieldChange c = { static_cast<uint32_t>(i), m };
+                expect.push_back(c);
+            }
+        }
+
+        bool ok = true;
+        testutil::forEachSimdLevel([&](SimdLevel level) {
+            std::vector<FieldChange> out(n);
+            const std::size_t count = cppbitfield::diff(a.data(), b.data(), n, out.data(), level);
+            ok = ok && count == expect.size();
+            for (std::size_t k = 0; ok && k < count; ++k) {
+                ok = out[k].index == expect[k].index && out[k].fields == expect[k].fields;
+            }
+        });
+        return ok;
+    }
+
+} // namespace
+
+CPP_TEST( bulk )
+{
+    DEFINE_BITFIELD_ENUM(E, A, B, C);
+    DEFINE_BITFIELD_SIZES(S8, 3, 1, 4);
+    DEFINE_BITFIELD_SIZES(S16, 5, 9, 2);
+    DEFINE_BITFIELD_SIZES(S32, 20, 1, 11);
+    DEFINE_BITFIELD_SIZES(S64, 33, 30, 1);
+
+    uint64_t seed = 9;
+    TEST_TRUE((checkBulk<cppbitfield::BitFields<E, S8>, S8>(seed, 5003)));
+    TEST_TRUE((checkBulk<cppbitfield::BitFields<E, S16>, S16>(seed, 5003)));
+    TEST_TRUE((checkBulk<cppbitfield::BitFields<E, S32>, S32>(seed, 5003)));
+    TEST_TRUE((checkBulk<cppbitfield::BitFields<E, S64>, S64>(seed, 5003)));
+    TEST_TRUE((checkBulk<cppbitfield::BitFields<E, S64>, S64>(seed, 7)));
+}
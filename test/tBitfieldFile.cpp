@@ -0,0 +1,108 @@
+/**
+ * \file tBitfieldFile.cpp
+ * \date Oct 16, 2026
+ */
+
+#include "unittest.hpp"
+
+#include <cppbitfield/bitfield_file.hpp>
+
+#include <cstdio>
+
+DEFINE_BITFIELD_ENUM(E, A, B, C);
+DEFINE_BITFIELD_SIZES(S, 7, 23, 13);
+DEFINE_BITFIELD_ARRAY(Arr, E, S);
+DEFINE_MAPPED_BITFIELD_ARRAY(Mapped, E, S);
+
+namespace {
+
+    const char * const PATH = "tBitfieldFile.bin";
+
+    Arr makeArray(std::size_t n)
+    {
+        Arr arr(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            arr.set<E::A>(i, i & 0x7F);
+            arr.set<E::B>(i, (i * 2654435761u) & 0x7FFFFF);
+            arr.set<E::C>(i, (i * 7) & 0x1FFF);
+        }
+        return arr;
+    }
+
+} // namespace
+
+CPP_TEST( roundTrip )
+{
+    const Arr arr = makeArray(1000 + 3);
+    TEST_TRUE(cppbitfield::writeBitFieldArray(PATH, arr) == cppbitfield::BitFieldFileStatus::Ok);
+
+    Mapped m;
+    TEST_TRUE(m.open(PATH) == cppbitfield::BitFieldFileStatus::Ok);
+    TEST_TRUE(m.isOpen());
+    TEST_TRUE(m.size() == arr.size());
+    TEST_TRUE(m.numWords() == arr.numWords());
+    bool same = true;
+    for (std::size_t i = 0; i < arr.size(); ++i) {
+        same = same && m.get<E::A>(i) == arr.get<E::A>(i) && m.get<E::B>(i) == arr.get<E::B>(i) &&
+               m.get<E::C>(i) == arr.get<E::C>(i) && m[i].bits() == arr[i].bits();
+    }
+    TEST_TRUE(same);
+
+    // copy-on-write: changes stay in this mapping
+    Mapped cow;
+    TEST_TRUE(cow.open(PATH, cppbitfield::MapMode::CopyOnWrite) == cppbitfield::BitFieldFileStatus::Ok);
+    cow.set<E::B>(17, 0x123456);
+    cow.set(18, arr[3]);
+    TEST_TRUE(cow.get<E::B>(17) == 0x123456);
+    TEST_TRUE(cow[18].bits() == arr[3].bits());
+    TEST_TRUE(cow.get<E::A>(16) == arr.get<E::A>(16) && cow.get<E::A>(19) == arr.get<E::A>(19));
+    TEST_TRUE(m.get<E::B>(17) == arr.get<E::B>(17));
+
+    Mapped moved(std::move(cow));
+    TEST_TRUE(!cow.isOpen() && moved.get<E::B>(17) == 0x123456);
+    moved.close();
+    TEST_TRUE(moved.open(PATH) == cppbitfield::BitFieldFileStatus::Ok);
+    TEST_TRUE(moved.get<E::B>(17) == arr.get<E::B>(17));
+
+    TEST_TRUE(cppbitfield::writeBitFieldArray(PATH, Arr()) == cppbitfield::BitFieldFileStatus::Ok);
+    Mapped none;
+    TEST_TRUE(none.open(PATH) == cppbitfield::BitFieldFileStatus::Ok);
+    TEST_TRUE(none.empty());
+    std::remove(PATH);
+}
+
+CPP_TEST( rejects )
+{
+    TEST_TRUE(cppbitfield::writeBitFieldArray(PATH, makeArray(100)) == cppbitfield::BitFieldFileStatus::Ok);
+
+    // same total size, different field boundaries or bit order
+    DEFINE_BITFIELD_SIZES(Other, 7, 22, 14);
+    DEFINE_BITFIELD_LAYOUT(Msb, MsbFirst, 7, 23, 13);
+    static_assert(cppbitfield::LayoutFingerprint<E, Other>::value != cppbitfield::LayoutFingerprint<E, S>::value,
+                  "field boundaries are part of the fingerprint");
+    cppbitfield::MappedBitFieldArray<E, Other> other;
+    TEST_TRUE(other.open(PATH) == cppbitfield::BitFieldFileStatus::LayoutMismatch);
+    TEST_TRUE(!other.isOpen());
+    cppbitfield::MappedBitFieldArray<E, Msb> msb;
+    TEST_TRUE(msb.open(PATH) == cppbitfield::BitFieldFileStatus::LayoutMismatch);
+
+    Mapped m;
+    TEST_TRUE(m.open("tBitfieldFile.missing") == cppbitfield::BitFieldFileStatus::IoError);
+
+    // drop the last payload word
+    std::FILE * f = std::fopen(PATH, "rb");
+    char buf[4096];
+    const std::size_t n = std::fread(buf, 1, sizeof(buf), f);
+    std::fclose(f);
+    f = std::fopen(PATH, "wb");
+    std::fwrite(buf, 1, n - 8, f);
+    std::fclose(f);
+    TEST_TRUE(m.open(PATH) == cppbitfield::BitFieldFileStatus::Truncated);
+
+    buf[0] = 'X';
+    f = std::fopen(PATH, "wb");
+    std::fwrite(buf, 1, n, f);
+    std::fclose(f);
+    TEST_TRUE(m.open(PATH) == cppbitfield::BitFieldFileStatus::BadHeader);
+    std::remove(PATH);
+}
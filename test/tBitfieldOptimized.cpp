@@ -0,0 +1,175 @@
+/**
+ * \file tBitfieldOptimized.cpp
+ * \date Oct 16, 2026
+ */
+
+#include "unittest.hpp"
+#include "testutil.hpp"
+
+#include <cppbitfield/bitfield_array.hpp>
+#include <cppbitfield/bitfield_optimized.hpp>
+
+using cppbitfield::BitFieldHints;
+using cppbitfield::FieldLayout;
+
+namespace {
+
+    using testutil::nextRand;
+
+} // namespace
+
+CPP_TEST( longestFirst )
+{
+    DEFINE_BITFIELD_ENUM(E, A, B, C, D);
+    DEFINE_BITFIELD_SIZES(S, 3, 8, 5, 16);
+    DEFINE_OPTIMIZED_BITFIELDS(R, E, S);
+
+    // no hints: D, B, C, A from bit 0, so B is on a byte and D on a word
+    static_assert(R::NumBits == 32, "no gaps without hints");
+    static_assert(std::is_same<R::StorageType, uint32_t>::value, "storage");
+    TEST_TRUE(R::FieldOffset<3>::value == 0);
+    TEST_TRUE(R::FieldOffset<1>::value == 16);
+    TEST_TRUE(R::FieldOffset<2>::value == 24);
+    TEST_TRUE(R::FieldOffset<0>::value == 29);
+    TEST_TRUE(FieldLayout<R>::Field<E::B>::naturallyAligned);
+    TEST_TRUE(!FieldLayout<R>::Field<E::A>::byteAligned);
+    TEST_TRUE(FieldLayout<R>::GapBits == 0);
+
+    constexpr R r = R::make(E::A, 5, E::B, 0xAB, E::C, 17, E::D, 0xBEEF);
+    static_assert(r.get<E::C>() == 17, "constexpr access");
+    TEST_TRUE(r.bits() == ((5u << 29) | (17u << 24) | (0xABu << 16) | 0xBEEF));
+}
+
+CPP_TEST( hotFields )
+{
+    DEFINE_BITFIELD_ENUM(E, Flag, Len, Kind, Mode, Seq);
+    DEFINE_BITFIELD_SIZES(S, 3, 5, 8, 2, 6);
+    DEFINE_OPTIMIZED_BITFIELDS(R, E, S, E::Flag, E::Kind);
+
+    // Flag and Kind start a byte each; Len fills the gap above Flag and the
+    // rest follow Kind, so the record stays 24 bits
+    static_assert(R::NumBits == 24, "gap filled");
+    static_assert(cppbitfield::OptimizedLayout<S, BitFieldHints<E, E::Flag, E::Kind> >::NumAligned == 2, "both aligned");
+    TEST_TRUE(R::FieldOffset<0>::value == 0);
+    TEST_TRUE(R::FieldOffset<2>::value == 8);
+    TEST_TRUE(R::FieldOffset<4>::value == 16);
+    TEST_TRUE(R::FieldOffset<1>::value == 3);
+    TEST_TRUE(R::FieldOffset<3>::value == 22);
+    TEST_TRUE(FieldLayout<R>::Field<E::Kind>::byteAligned);
+
+    DEFINE_BITFIELDS(Plain, E, S);
+    uint64_t seed = 11;
+    for (int i = 0; i < 1000; ++i) {
+        Plain p;
+        R r;
+        const uint64_t v = nextRand(seed);
+        p.set<E::Flag>(v & 7);
+        p.set<E::Len>((v >> 3) & 31);
+        p.set<E::Kind>((v >> 8) & 255);
+        p.set<E::Mode>((v >> 16) & 3);
+        p.set<E::Seq>((v >> 18) & 63);
+        r.set<E::Flag, E::Len, E::Kind, E::Mode, E::Seq>(p.get<E::Flag>(), p.get<E::Len>(), p.get<E::Kind>(),
+                                                         p.get<E::Mode>(), p.get<E::Seq>());
+        TEST_TRUE(r.get<E::Flag>() == p.get<E::Flag>());
+        TEST_TRUE(r.get<E::Len>() == p.get<E::Len>());
+        TEST_TRUE(r.get<E::Kind>() == p.get<E::Kind>());
+        TEST_TRUE(r.get<E::Mode>() == p.get<E::Mode>());
+        TEST_TRUE(r.get<E::Seq>() == p.get<E::Seq>());
+    }
+}
+
+CPP_TEST( storageBudget )
+{
+    DEFINE_BITFIELD_ENUM(E, A, B);
+    DEFINE_BITFIELD_SIZES(S, 9, 7);
+
+    // aligning A to 16 bits as well would need a uint32_t, so only B is
+    using Hints = BitFieldHints<E, E::B, E::A>;
+    using L = cppbitfield::OptimizedLayout<S, Hints>;
+    static_assert(L::NumAligned == 1, "second hint dropped");
+    DEFINE_OPTIMIZED_BITFIELDS(R, E, S, E::B, E::A);
+    static_assert(std::is_same<R::StorageType, uint16_t>::value, "declared storage kept");
+    TEST_TRUE(R::FieldOffset<1>::value == 0);
+    TEST_TRUE(R::FieldOffset<0>::value == 7);
+
+    // room to spare: both hot fields and the cold one aligned, with gaps
+    DEFINE_BITFIELD_ENUM(F, A, B, C);
+    DEFINE_BITFIELD_SIZES(T, 1, 12, 4);
+    DEFINE_OPTIMIZED_BITFIELDS(Q, F, T, F::C, F::B);
+    static_assert(std::is_same<Q::StorageType, uint32_t>::value, "storage");
+    TEST_TRUE(Q::FieldOffset<2>::value == 0);
+    TEST_TRUE(Q::FieldOffset<1>::value == 16);
+    TEST_TRUE(Q::FieldOffset<0>::value == 8);
+    TEST_TRUE(Q::NumBits == 28);
+    TEST_TRUE(FieldLayout<Q>::GapBits == 11);
+}
+
+CPP_TEST( multiWord )
+{
+    DEFINE_BITFIELD_ENUM(E, A, B, C);
+    DEFINE_BITFIELD_SIZES(S, 60, 8, 60);
+    DEFINE_OPTIMIZED_BITFIELDS(R, E, S, E::B);
+
+    // B first would push A or C across a word, so the declared order stays
+    static_assert(R::NumBits == 128, "two words");
+    TEST_TRUE(R::FieldOffset<0>::value == 0);
+    TEST_TRUE(R::FieldOffset<1>::value == 60);
+    TEST_TRUE(R::FieldOffset<2>::value == 68);
+    TEST_TRUE(!FieldLayout<R>::Field<E::A>::straddlesWord && !FieldLayout<R>::Field<E::C>::straddlesWord);
+
+    R r;
+    r.set<E::A>(0xFFFFFFFFFFFFFFFULL);
+    r.set<E::B>(0x5A);
+    r.set<E::C>(0x123456789ABCDEFULL);
+    TEST_TRUE(r.get<E::A>() == 0xFFFFFFFFFFFFFFFULL);
+    TEST_TRUE(r.get<E::B>() == 0x5A);
+    TEST_TRUE(r.get<E::C>() == 0x123456789ABCDEFULL);
+    TEST_TRUE((r.bits().words[0] >> 60) == 0xA);
+}
+
+CPP_TEST( coldAlignment )
+{
+    DEFINE_BITFIELD_ENUM(E, A, B, C, D, F, G);
+    DEFINE_BITFIELD_SIZES(S, 64, 64, 1, 2, 3, 4);
+    DEFINE_OPTIMIZED_BITFIELDS(R, E, S, E::D);
+
+    // hinting a small field keeps the wide ones on their words, and the
+    // other small ones on bytes of the first word's gap
+    static_assert(R::NumBits == 192, "declared storage kept");
+    TEST_TRUE(R::FieldOffset<3>::value == 0);
+    TEST_TRUE(R::FieldOffset<0>::value == 64);
+    TEST_TRUE(R::FieldOffset<1>::value == 128);
+    TEST_TRUE(R::FieldOffset<5>::value == 8);
+    TEST_TRUE(R::FieldOffset<4>::value == 16);
+    TEST_TRUE(R::FieldOffset<2>::value == 24);
+    TEST_TRUE(!FieldLayout<R>::Field<E::A>::straddlesWord && !FieldLayout<R>::Field<E::B>::straddlesWord);
+
+    R r;
+    r.set<E::A>(0x0123456789ABCDEFULL);
+    r.set<E::B>(0xFEDCBA9876543210ULL);
+    r.set<E::D>(2);
+    r.set<E::G>(9);
+    TEST_TRUE(r.get<E::A>() == 0x0123456789ABCDEFULL && r.get<E::B>() == 0xFEDCBA9876543210ULL);
+    TEST_TRUE(r.get<E::D>() == 2 && r.get<E::G>() == 9 && r.get<E::C>() == 0 && r.get<E::F>() == 0);
+    TEST_TRUE(r.bits().words[1] == 0x0123456789ABCDEFULL);
+}
+
+CPP_TEST( containers )
+{
+    DEFINE_BITFIELD_ENUM(E, A, B, C);
+    DEFINE_BITFIELD_SIZES(S, 3, 8, 2);
+    using L = cppbitfield::OptimizedLayout<S, BitFieldHints<E, E::B> >;
+
+    // arrays take the reordered layout like any other sizes type
+    cppbitfield::BitFieldArray<E, L> arr(100);
+    for (std::size_t i = 0; i < arr.size(); ++i) {
+        arr.set<E::A>(i, i % 8);
+        arr.set<E::B>(i, (i * 7) % 256);
+        arr.set<E::C>(i, i % 4);
+    }
+    for (std::size_t i = 0; i < arr.size(); ++i) {
+        TEST_TRUE(arr.get<E::A>(i) == i % 8);
+        TEST_TRUE(arr.get<E::B>(i) == (i * 7) % 256);
+        TEST_TRUE(arr.get<E::C>(i) == i % 4);
+    }
+}
@@ -0,0 +1,143 @@
+/**
+ * \file tBitfieldParallel.cpp
+ * \date Oct 16, 2026
+ */
+
+#include "unittest.hpp"
+
+#include <cppbitfield/bitfield_parallel.hpp>
+
+#include <atomic>
+#include <vector>
+
+using cppbitfield::ThreadPool;
+
+DEFINE_BITFIELD_ENUM(E, Id, State, Flag);
+DEFINE_BITFIELD_SIZES(S, 9, 3, 1);
+DEFINE_BITFIELD_ARRAY(Arr, E, S);
+DEFINE_BITFIELDS(Rec, E, S);
+
+DEFINE_BITFIELD_ENUM(F, Id, Live);
+DEFINE_BITFIELD_SIZES(T, 9, 1);
+DEFINE_BITFIELD_ARRAY(OutArr, F, T);
+
+CPP_TEST( chunks )
+{
+    // 13-bit records: a cache line starts with a record every 512 records
+    alignas(64) static uint64_t words[4];
+    for (int skew = 0; skew < 4; ++skew) {
+        const std::vector<std::size_t> b = cppbitfield::detail::packedChunks(words + skew, 13, 100000, 16, 1000);
+        TEST_TRUE(b.front() == 0 && b.back() == 100000);
+        for (std::size_t c = 1; c + 1 < b.size(); ++c) {
+            TEST_TRUE(b[c] > b[c - 1]);
+            TEST_TRUE((skew * 64 + b[c] * 13) % 512 == 0);
+        }
+    }
+
+    // 128-bit records one word into a line never start one: chunks keep
+    // the base's alignment and whole lines' worth of records
+    const std::vector<std::size_t> w = cppbitfield::detail::packedChunks(words + 1, 128, 1000, 8, 10);
+    TEST_TRUE(w.size() == 9);
+    for (std::size_t c = 1; c + 1 < w.size(); ++c) {
+        TEST_TRUE(w[c] % 4 == 0 && w[c] - w[c - 1] >= 10);
+    }
+
+    TEST_TRUE(cppbitfield::detail::packedChunks(words, 13, 0, 4, 100).size() == 2);
+}
+
+CPP_TEST( pool )
+{
+    ThreadPool pool(4);
+    TEST_TRUE(pool.concurrency() == 4);
+
+    std::vector<std::atomic<int> > hits(1000);
+    for (std::size_t i = 0; i < hits.size(); ++i) {
+        hits[i] = 0;
+    }
+    pool.run(hits.size(), [&hits](std::size_t i) { ++hits[i]; });
+    bool once = true;
+    for (std::size_t i = 0; i < hits.size(); ++i) {
+        once = once && hits[i] == 1;
+    }
+    TEST_TRUE(once);
+
+    // tasks may run() again on the same pool
+    std::atomic<int> inner(0);
+    pool.run(8, [&pool, &inner](std::size_t) {
+        pool.run(16, [&inner](std::size_t) { ++inner; });
+    });
+    TEST_TRUE(inner == 8 * 16);
+
+    ThreadPool single(1);
+    int sum = 0;
+    single.run(10, [&sum](std::size_t i) { sum += static_cast<int>(i); });
+    TEST_TRUE(sum == 45);
+}
+
+CPP_TEST( forEach )
+{
+    const std::size_t n = 300001;
+    Arr arr(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        arr[i] = Rec::make(E::Id, i % 512, E::State, i % 5 % 4, E::Flag, 1);
+    }
+
+    ThreadPool pool(3);
+    cppbitfield::parallelForEach(arr, [](Rec & r) {
+        if (r.get<E::State>() == 2) {
+            r.set<E::Flag>(0);
+        }
+    }, pool);
+
+    bool ok = true;
+    for (std::size_t i = 0; i < n; ++i) {
+        const Rec r = arr[i];
+        ok = ok && r.get<E::Id>() == i % 512 && r.get<E::State>() == i % 5 % 4 &&
+             r.get<E::Flag>() == (i % 5 % 4 == 2 ? 0u : 1u);
+    }
+    TEST_TRUE(ok);
+
+    // unpacked records, shared pool
+    std::vector<Rec> recs(n);
+    cppbitfield::parallelForEach(recs.data(), n, [](Rec & r) { r.set<E::State>(7); });
+    bool all = true;
+    for (std::size_t i = 0; i < n; ++i) {
+        all = all && recs[i].get<E::State>() == 7;
+    }
+    TEST_TRUE(all);
+}
+
+CPP_TEST( transform )
+{
+    const std::size_t n = 200003;
+    Arr in(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        in[i] = Rec::make(E::Id, i % 512, E::Flag, i % 3 == 0);
+    }
+
+    ThreadPool pool(4);
+    OutArr out;
+    cppbitfield::parallelTransform(in, out, [](const Rec & r) {
+        return OutArr::value_type::make(F::Id, r.get<E::Id>(), F::Live, r.get<E::Flag>());
+    }, pool);
+    TEST_TRUE(out.size() == n);
+    bool ok = true;
+    for (std::size_t i = 0; i < n; ++i) {
+        ok = ok && out.get<F::Id>(i) == i % 512 && out.get<F::Live>(i) == (i % 3 == 0 ? 1u : 0u);
+    }
+    TEST_TRUE(ok);
+
+    std::vector<Rec> recs(n);
+    std::vector<uint16_t> ids(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        recs[i] = in[i];
+    }
+    cppbitfield::parallelTransform(recs.data(), n, ids.data(), [](const Rec & r) {
+        return static_cast<uint16_t>(r.get<E::Id>());
+    }, pool);
+    bool same = true;
+    for (std::size_t i = 0; i < n; ++i) {
+        same = same && ids[i] == i % 512;
+    }
+    TEST_TRUE(same);
+}
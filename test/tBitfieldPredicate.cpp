@@ -0,0 +1,147 @@
+/**
+ * \file tBitfieldPredicate.cpp
+ * \date Oct 16, 2026
+ */
+
+#include "unittest.hpp"
+#include "testutil.hpp"
+
+#include <cppbitfield/bitfield_predicate.hpp>
+
+#include <vector>
+
+namespace {
+
+    using testutil::randomRecords;
+
+    // Checks filter/select at every SIMD level against `expected`.
+    template <class Record, class Pred, class Ref>
+    bool checkFilter(const std::vector<Record> & recs, const Pred & pred, Ref expected)
+    {
+        const std::size_t n = recs.size();
+        bool ok = true;
+        testutil::forEachSimdLevel([&](cppbitfield::SimdLevel level) {
+            std::vector<uint64_t> bitmap((n + 63) / 64, ~0ULL);
+            std::vector<uint32_t> sel(n);
+            cppbitfield::filter(recs.data(), n, pred, bitmap.data(), level);
+            const std::size_t count = cppbitfield::select(recs.data(), n, pred, sel.data(), level);
+            std::size_t k = 0;
+            for (std::size_t i = 0; ok && i < n; ++i) {
+                const bool want = expected(recs[i]);
+                ok = pred(recs[i]) == want && ((bitmap[i / 64] >> (i % 64)) & 1) == (want ? 1u : 0u);
+                if (ok && want) {
+                    ok = k < count && sel[k++] == i;
+                }
+            }
+            ok = ok && k == count && ((n % 64) == 0 || (bitmap.back() >> (n % 64)) == 0);
+        });
+        return ok;
+    }
+
+} // namespace
+
+DEFINE_BITFIELD_ENUM(
+     TaskEnum,
+           State,
+           Flags,
+           Prio,
+           Owner);
+
+DEFINE_BITFIELD_SIZES(
+    TaskSizes,
+           3,
+           4,
+           2,
+           7);
+
+DEFINE_BITFIELDS(
+    Task,
+    TaskEnum,
+    TaskSizes);
+
+CPP_TEST( folding )
+{
+    using cppbitfield::field;
+    const auto state = field<Task, TaskEnum::State>();
+    const auto prio = field<Task, TaskEnum::Prio>();
+    const auto flags = field<Task, TaskEnum::Flags>();
+
+    // equality, single bit and range terms collapse into one test
+    const auto p = state == 3 && (flags & 0x4) && prio < 2;
+    TEST_TRUE(p.conj().eqMask == (0x7u | (0x4u << 3)));
+    TEST_TRUE(p.conj().eqValue == (3u | (0x4u << 3)));
+    TEST_TRUE(p.conj().topA == (1u << 8));
+
+    Task x;
+    x.set<TaskEnum::State, TaskEnum::Flags, TaskEnum::Prio>(3, 0x5, 1);
+    TEST_TRUE(p(x));
+    x.set<TaskEnum::Prio>(2);
+    TEST_TRUE(!p(x));
+
+    // tightening and contradictions
+    TEST_TRUE((prio < 3 && prio < 2).conj().constA == (2u << 7));
+    TEST_TRUE((state == 1 && state == 2).conj().never);
+    TEST_TRUE((state == 8).conj().never);
+    TEST_TRUE((prio > 3).conj().never);
+    TEST_TRUE((prio <= 3)(x));
+}
+
+CPP_TEST( filter8 )
+{
+    DEFINE_BITFIELD_ENUM(E, A, B, C);
+    DEFINE_BITFIELD_SIZES(S, 3, 2, 3);
+    DEFINE_BITFIELDS(R, E, S);
+
+    using cppbitfield::field;
+    const std::vector<R> recs = randomRecords<R>(3000 + 5, 1);
+    TEST_TRUE(checkFilter(recs, field<R, E::A>() >= 2 && field<R, E::C>() < 5 && field<R, E::B>() != 1,
+                          [](const R & r) {
+                              return r.get<E::A>() >= 2 && r.get<E::C>() < 5 && r.get<E::B>() != 1;
+                          }));
+}
+
+CPP_TEST( filter16 )
+{
+    using cppbitfield::field;
+    const std::vector<Task> recs = randomRecords<Task>(2500 + 3, 2);
+    TEST_TRUE(checkFilter(recs, field<Task, TaskEnum::State>() == 3 && (field<Task, TaskEnum::Flags>() & 0x6) &&
+                                field<Task, TaskEnum::Prio>() > 0 && field<Task, TaskEnum::Owner>() <= 100,
+                          [](const Task & r) {
+                              return r.get<TaskEnum::State>() == 3 && (r.get<TaskEnum::Flags>() & 0x6) &&
+                                     r.get<TaskEnum::Prio>() > 0 && r.get<TaskEnum::Owner>() <= 100;
+                          }));
+    TEST_TRUE(checkFilter(recs, field<Task, TaskEnum::State>() == 3 || !(field<Task, TaskEnum::Owner>() > 20),
+                          [](const Task & r) {
+                              return r.get<TaskEnum::State>() == 3 || !(r.get<TaskEnum::Owner>() > 20);
+                          }));
+}
+
+CPP_TEST( filter32 )
+{
+    DEFINE_BITFIELD_ENUM(E, A, B, C);
+    DEFINE_BITFIELD_SIZES(S, 5, 17, 10);
+    DEFINE_BITFIELDS(R, E, S);
+
+    using cppbitfield::field;
+    const std::vector<R> recs = randomRecords<R>(2000 + 17, 3);
+    TEST_TRUE(checkFilter(recs, field<R, E::B>() > 60000 && field<R, E::B>() < 120000 && field<R, E::C>() >= 512,
+                          [](const R & r) {
+                              return r.get<E::B>() > 60000 && r.get<E::B>() < 120000 && r.get<E::C>() >= 512;
+                          }));
+}
+
+CPP_TEST( filter64 )
+{
+    DEFINE_BITFIELD_ENUM(E, A, B, C, D);
+    DEFINE_BITFIELD_SIZES(S, 7, 32, 20, 5);
+    DEFINE_BITFIELDS(R, E, S);
+
+    using cppbitfield::field;
+    const std::vector<R> recs = randomRecords<R>(2000 + 9, 4);
+    TEST_TRUE(checkFilter(recs, field<R, E::B>() < 0x80000000u && (field<R, E::C>() & 0xF0) && field<R, E::D>() > 7 &&
+                                (field<R, E::A>() & 0x41),
+                          [](const R & r) {
+                              return r.get<E::B>() < 0x80000000u && (r.get<E::C>() & 0xF0) && r.get<E::D>() > 7 &&
+                                     (r.get<E::A>() & 0x41);
+                          }));
+}
@@ -0,0 +1,105 @@
+/**
+ * \file tBitfieldProfile.cpp
+ * \date Oct 16, 2026
+ */
+
+#if !defined(CPPBITFIELD_PROFILE)
+#  define CPPBITFIELD_PROFILE
+#endif
+
+#include "unittest.hpp"
+
+#include <cppbitfield/bitfield_profile.hpp>
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using cppbitfield::ProfileFormat;
+using cppbitfield::RecordProfile;
+
+DEFINE_BITFIELD_ENUM(PacketEnum, Id, State, Flag);
+DEFINE_BITFIELD_SIZES(PacketSizes, 9, 3, 1);
+DEFINE_BITFIELDS(Packet, PacketEnum, PacketSizes);
+
+DEFINE_BITFIELD_ENUM(WideEnum, Lo, Hi);
+DEFINE_BITFIELD_SIZES(WideSizes, 60, 60);
+DEFINE_BITFIELDS(Wide, WideEnum, WideSizes);
+
+CPP_TEST( counts )
+{
+    cppbitfield::resetProfile();
+    Packet p;
+    for (int i = 0; i < 10; ++i) {
+        p.set<PacketEnum::Id>(i);
+        p.set<PacketEnum::Flag>(i % 2 == 0);
+    }
+    unsigned sum = 0;
+    for (int i = 0; i < 25; ++i) {
+        sum += p.get<PacketEnum::Id>();
+    }
+    p.set<PacketEnum::State, PacketEnum::Flag>(3, 1);
+    const std::tuple<uint16_t, uint16_t> both = p.get<PacketEnum::Id, PacketEnum::State>();
+    TEST_TRUE(sum == 25 * 9 && std::get<1>(both) == 3);
+
+    const RecordProfile prof = cppbitfield::profileOf<Packet>();
+    TEST_TRUE(prof.name == "PacketEnum");
+    TEST_TRUE(prof.numBits == 13 && prof.fields.size() == 3);
+    TEST_TRUE(prof.fields[0].reads == 26 && prof.fields[0].writes == 10);
+    TEST_TRUE(prof.fields[1].reads == 1 && prof.fields[1].writes == 1);
+    TEST_TRUE(prof.fields[2].reads == 0 && prof.fields[2].writes == 11);
+    TEST_TRUE(prof.fields[1].offset == 9 && prof.fields[1].length == 3);
+    TEST_TRUE(prof.hottest() == std::vector<int>({ 0, 2, 1 }));
+
+    // constant evaluation neither counts nor stops being constant
+    constexpr Packet c = Packet::make(PacketEnum::State, 5);
+    static_assert(c.get<PacketEnum::State>() == 5, "constexpr get");
+    TEST_TRUE(cppbitfield::profileOf<Packet>().fields[1].reads == 1);
+
+    cppbitfield::resetProfile();
+    TEST_TRUE(cppbitfield::profileOf<Packet>().accesses() == 0);
+}
+
+CPP_TEST( threads )
+{
+    cppbitfield::resetProfile();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.push_back(std::thread([] {
+            Wide w;
+            for (int i = 0; i < 1000; ++i) {
+                w.set<WideEnum::Hi>(i);
+                w.set<WideEnum::Lo>(w.get<WideEnum::Hi>());
+            }
+        }));
+    }
+    for (std::size_t t = 0; t < threads.size(); ++t) {
+        threads[t].join();
+    }
+
+    // the threads have exited; their counts were kept
+    const RecordProfile prof = cppbitfield::profileOf<Wide>();
+    TEST_TRUE(prof.fields[0].writes == 4000 && prof.fields[0].reads == 0);
+    TEST_TRUE(prof.fields[1].writes == 4000 && prof.fields[1].reads == 4000);
+    TEST_TRUE(prof.fields[1].offset == 60 && prof.numBits == 120);
+}
+
+CPP_TEST( report )
+{
+    cppbitfield::resetProfile();
+    Packet p;
+    p.set<PacketEnum::State>(2);
+    p.set<PacketEnum::State>(p.get<PacketEnum::State>() + 1);
+
+    std::ostringstream text;
+    cppbitfield::writeProfile(text);
+    TEST_TRUE(text.str().find("PacketEnum: 13 bits, 3 accesses") != std::string::npos);
+    TEST_TRUE(text.str().find("WideEnum: 120 bits, 0 accesses") != std::string::npos);
+
+    std::ostringstream json;
+    cppbitfield::writeProfile(json, ProfileFormat::Json);
+    TEST_TRUE(json.str().find("{\"index\": 1, \"offset\": 9, \"length\": 3, \"reads\": 1, \"writes\": 2, "
+                              "\"share\": 1.000, \"readRatio\": 0.333}") != std::string::npos);
+    TEST_TRUE(json.str().find("\"hottest\": [1, 0, 2]") != std::string::npos);
+    TEST_TRUE(cppbitfield::profileSnapshot().size() == 2);
+}
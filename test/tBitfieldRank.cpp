@@ -0,0 +1,175 @@
+/**
+ * \file tBitfieldRank.cpp
+ * \date Oct 16, 2026
+ */
+
+#include "unittest.hpp"
+#include "testutil.hpp"
+
+#include <cppbitfield/bitfield_rank.hpp>
+
+#include <cstring>
+#include <new>
+#include <vector>
+
+namespace {
+
+    using testutil::nextRand;
+
+    // every rank, and every select, checked against a scan
+    bool matchesScan(const std::vector<bool> & bits)
+    {
+        std::vector<uint64_t> words((bits.size() + 63) / 64 + 1, ~0ULL);
+        for (std::size_t i = 0; i < bits.size(); ++i) {
+            if (!bits[i]) {
+                words[i / 64] &= ~(1ULL << (i % 64));
+            }
+        }
+        const cppbitfield::RankSelect rs(words.data(), bits.size());
+        bool ok = rs.size() == bits.size();
+        std::size_t ones = 0;
+        for (std::size_t i = 0; i < bits.size(); ++i) {
+            ok = ok && rs.rank1(i) == ones && rs.rank0(i) == i - ones && rs.get(i) == bits[i];
+            if (bits[i]) {
+                ok = ok && rs.select1(ones) == i;
+            }
+            else {
+                ok = ok && rs.select0(i - ones) == i;
+            }
+            ones += bits[i] ? 1 : 0;
+        }
+        return ok && rs.rank1(bits.size()) == ones && rs.count() == ones;
+    }
+
+} // namespace
+
+CPP_TEST( rankSelect )
+{
+    uint64_t seed = 3;
+    const std::size_t sizes[] = { 0, 1, 63, 64, 65, 511, 512, 2047, 2048, 2049, 100000 };
+    const int densities[] = { 0, 1, 50, 99, 100 };
+    bool ok = true;
+    for (std::size_t n : sizes) {
+        for (int d : densities) {
+            std::vector<bool> bits(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                bits[i] = static_cast<int>(nextRand(seed) % 100) < d;
+            }
+            ok = ok && matchesScan(bits);
+        }
+    }
+    TEST_TRUE(ok);
+
+    // sparse and clustered ones: long stretches between select samples
+    std::vector<bool> bits(300000);
+    for (std::size_t i = 0; i < bits.size(); ++i) {
+        bits[i] = (i % 9973 == 0) || (i > 150000 && i < 170000);
+    }
+    TEST_TRUE(matchesScan(bits));
+
+    TEST_TRUE(cppbitfield::RankSelect().rank1(0) == 0);
+}
+
+CPP_TEST( sparse )
+{
+    // one bit in 700: two samples far apart, searched through a position
+    // every 128 bits; one in 2500: subgroups wide enough to store every
+    // position. The complements check select0 the same way.
+    const std::size_t n = 1 << 23;
+    const std::size_t gaps[] = { 700, 2500 };
+    bool ok = true;
+    for (std::size_t gap : gaps) {
+        std::vector<bool> bits(n);
+        std::vector<bool> flipped(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            bits[i] = i % gap == 3;
+            flipped[i] = !bits[i];
+        }
+        ok = ok && matchesScan(bits) && matchesScan(flipped);
+    }
+    TEST_TRUE(ok);
+
+    // dense and sparse stretches in one vector
+    uint64_t seed = 13;
+    std::vector<bool> mixed(3 << 20);
+    for (std::size_t i = 0; i < mixed.size(); ++i) {
+        mixed[i] = i / 500000 % 2 == 0 ? nextRand(seed) % 2 == 0 : nextRand(seed) % 4000 == 0;
+    }
+    TEST_TRUE(matchesScan(mixed));
+}
+
+CPP_TEST( overhead )
+{
+    const std::size_t n = 1 << 24;
+    std::vector<uint64_t> words(n / 64);
+    uint64_t seed = 5;
+    for (std::size_t i = 0; i < words.size(); ++i) {
+        words[i] = nextRand(seed) ^ (nextRand(seed) << 40);
+    }
+    const cppbitfield::RankSelect rs(words.data(), n);
+    TEST_TRUE(rs.indexSizeInBytes() * 100 < n / 8 * 5);
+    TEST_TRUE(rs.select1(rs.count() - 1) < n && rs.rank1(rs.select1(12345)) == 12345);
+}
+
+CPP_TEST( emptyValueRank )
+{
+    // built over dirty memory, an empty index still answers every value
+    using Index = cppbitfield::ValueRank<4>;
+    alignas(Index) unsigned char buf[sizeof(Index)];
+    std::memset(buf, 0xA5, sizeof(buf));
+    const Index * empty = new (buf) Index();
+    TEST_TRUE(empty->size() == 0 && empty->count(15) == 0 && empty->count(0) == 0 && empty->rank(9, 0) == 0);
+    empty->~Index();
+
+    const uint32_t none[1] = { 0 };
+    const Index fromNone(none, 0);
+    TEST_TRUE(fromNone.size() == 0 && fromNone.count(15) == 0 && fromNone.rank(6, 0) == 0);
+}
+
+CPP_TEST( fields )
+{
+    DEFINE_BITFIELD_ENUM(E, Flag, State, Id);
+    DEFINE_BITFIELD_SIZES(S, 1, 3, 20);
+    DEFINE_BITFIELD_ARRAY(Arr, E, S);
+    DEFINE_BITFIELD_COLUMNS(Cols, E, S);
+
+    const std::size_t n = 20000;
+    Arr arr(n);
+    Cols cols(n);
+    uint64_t seed = 11;
+    for (std::size_t i = 0; i < n; ++i) {
+        const uint64_t r = nextRand(seed);
+        arr[i].set<E::Flag>(r % 3 == 0);
+        arr[i].set<E::State>((r >> 8) % 5);
+        arr[i].set<E::Id>(i);
+        cols.set(i, arr.get(i));
+    }
+
+    const cppbitfield::RankSelect flags = cppbitfield::rankSelectField<Arr, E::Flag>(arr);
+    const cppbitfield::RankSelect flagCol(cols.column<E::Flag>());
+    bool ok = flags.count() == flagCol.count();
+    std::size_t seen = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        ok = ok && flags.rank1(i) == seen && flagCol.rank1(i) == seen;
+        if (arr[i].get<E::Flag>() != 0) {
+            ok = ok && flags.select1(seen) == i;
+            ++seen;
+        }
+    }
+    TEST_TRUE(ok);
+
+    const cppbitfield::ValueRank<3> states = cppbitfield::valueRankField<Arr, E::State>(arr);
+    const cppbitfield::ValueRank<3> stateCol(cols.column<E::State>());
+    std::size_t counts[8] = { 0 };
+    ok = states.size() == n;
+    for (std::size_t i = 0; i < n; ++i) {
+        const uint32_t v = arr[i].get<E::State, uint32_t>();
+        for (uint32_t u = 0; u < 8; ++u) {
+            ok = ok && states.rank(u, i) == counts[u];
+        }
+        ok = ok && states.get(i) == v && stateCol.get(i) == v && states.select(v, counts[v]) == i;
+        ++counts[v];
+    }
+    TEST_TRUE(ok);
+    TEST_TRUE(states.count(4) == counts[4] && states.count(7) == 0 && stateCol.count(2) == counts[2]);
+}
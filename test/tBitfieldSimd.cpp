@@ -0,0 +1,105 @@
+/**
+ * \file tBitfieldSimd.cpp
+ * \date Oct 16, 2026
+ */
+
+#include "unittest.hpp"
+#include "testutil.hpp"
+
+#include <cppbitfield/bitfield_simd.hpp>
+
+#include <vector>
+
+namespace {
+
+    using testutil::nextRand;
+    using testutil::randomRecords;
+
+    // Compares every SIMD level against the scalar get/set for field X.
+    template <class Record, typename Record::FieldEnum X>
+    bool checkField()
+    {
+        using Batch = cppbitfield::BitFieldBatch<Record>;
+        using F = cppbitfield::detail::FieldPos<Record, Record::template AsInt<X>::value>;
+
+        // odd size so that every kernel leaves a scalar tail
+        const std::size_t n = 1000 + 13;
+        const std::vector<Record> recs = randomRecords<Record>(n, 42);
+        uint64_t seed = 7;
+        std::vector<uint32_t> vals(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            vals[i] = static_cast<uint32_t>(nextRand(seed) & cppbitfield::detail::LowMask<uint64_t, F::length>::value);
+        }
+
+        std::vector<Record> expected(recs);
+        for (std::size_t i = 0; i < n; ++i) {
+            expected[i].template set<X>(vals[i]);
+        }
+
+        bool ok = true;
+        testutil::forEachSimdLevel([&](cppbitfield::SimdLevel level) {
+            std::vector<uint32_t> out(n, 0xDEADBEEF);
+            Batch::template extract<X>(recs.data(), n, out.data(), level);
+            for (std::size_t i = 0; ok && i < n; ++i) {
+                ok = out[i] == recs[i].template get<X>();
+            }
+
+            std::vector<Record> ins(recs);
+            Batch::template insert<X>(ins.data(), n, vals.data(), level);
+            for (std::size_t i = 0; ok && i < n; ++i) {
+                ok = ins[i].bits() == expected[i].bits();
+            }
+        });
+        return ok;
+    }
+
+} // namespace
+
+CPP_TEST( width8 )
+{
+    DEFINE_BITFIELD_ENUM(E, A, B, C);
+    DEFINE_BITFIELD_SIZES(S, 1, 4, 3);
+    DEFINE_BITFIELDS(R, E, S);
+
+    TEST_TRUE(sizeof(R::StorageType) == 1);
+    TEST_TRUE((checkField<R, E::A>()));
+    TEST_TRUE((checkField<R, E::B>()));
+    TEST_TRUE((checkField<R, E::C>()));
+}
+
+CPP_TEST( width16 )
+{
+    DEFINE_BITFIELD_ENUM(E, A, B, C);
+    DEFINE_BITFIELD_SIZES(S, 3, 9, 4);
+    DEFINE_BITFIELDS(R, E, S);
+
+    TEST_TRUE(sizeof(R::StorageType) == 2);
+    TEST_TRUE((checkField<R, E::A>()));
+    TEST_TRUE((checkField<R, E::B>()));
+    TEST_TRUE((checkField<R, E::C>()));
+}
+
+CPP_TEST( width32 )
+{
+    DEFINE_BITFIELD_ENUM(E, A, B, C);
+    DEFINE_BITFIELD_SIZES(S, 5, 17, 10);
+    DEFINE_BITFIELDS(R, E, S);
+
+    TEST_TRUE(sizeof(R::StorageType) == 4);
+    TEST_TRUE((checkField<R, E::A>()));
+    TEST_TRUE((checkField<R, E::B>()));
+    TEST_TRUE((checkField<R, E::C>()));
+}
+
+CPP_TEST( width64 )
+{
+    DEFINE_BITFIELD_ENUM(E, A, B, C, D);
+    DEFINE_BITFIELD_SIZES(S, 7, 32, 20, 5);
+    DEFINE_BITFIELDS(R, E, S);
+
+    TEST_TRUE(sizeof(R::StorageType) == 8);
+    TEST_TRUE((checkField<R, E::A>()));
+    TEST_TRUE((checkField<R, E::B>()));
+    TEST_TRUE((checkField<R, E::C>()));
+    TEST_TRUE((checkField<R, E::D>()));
+}
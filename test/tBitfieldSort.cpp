@@ -0,0 +1,114 @@
+/**
+ * \file tBitfieldSort.cpp
+ * \date Oct 16, 2026
+ */
+
+#include "unittest.hpp"
+#include "testutil.hpp"
+
+#include <cppbitfield/bitfield_sort.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+    using testutil::nextRand;
+
+    // radixSort against std::stable_sort on the key, bit for bit, so ties
+    // must keep their input order
+    template <class Record, typename Record::FieldEnum... Xs>
+    bool sortsLikeStable(const std::vector<Record> & input, unsigned threads)
+    {
+        std::vector<Record> expected(input), actual(input);
+        std::stable_sort(expected.begin(), expected.end(), [](const Record & a, const Record & b) {
+            return cppbitfield::sortKey<Record, Xs...>(a) < cppbitfield::sortKey<Record, Xs...>(b);
+        });
+        cppbitfield::radixSort<Record, Xs...>(actual.data(), actual.size(), threads);
+        bool ok = true;
+        for (std::size_t i = 0; i < input.size(); ++i) {
+            ok = ok && actual[i].bits() == expected[i].bits();
+        }
+        return ok;
+    }
+
+} // namespace
+
+CPP_TEST( plan )
+{
+    using cppbitfield::detail::RadixPlan;
+    static_assert(RadixPlan<3>::Passes == 1 && RadixPlan<3>::DigitBits == 3, "one narrow pass");
+    static_assert(RadixPlan<13>::Passes == 2 && RadixPlan<13>::DigitBits == 7, "two even passes");
+    static_assert(RadixPlan<32>::Passes == 3 && RadixPlan<32>::DigitBits == 11, "three passes");
+    static_assert(RadixPlan<64>::Passes == 6 && RadixPlan<64>::DigitBits == 11, "six passes");
+
+    DEFINE_BITFIELD_ENUM(E, Id, State, Prio);
+    DEFINE_BITFIELD_SIZES(S, 20, 3, 2);
+    DEFINE_BITFIELDS(R, E, S);
+    const R r = R::make(E::Id, 77, E::State, 5, E::Prio, 2);
+    TEST_TRUE((cppbitfield::sortKey<R, E::Prio, E::State, E::Id>(r) == ((2u << 23) | (5u << 20) | 77u)));
+    TEST_TRUE((cppbitfield::sortKey<R, E::State>(r) == 5));
+}
+
+CPP_TEST( priorities )
+{
+    DEFINE_BITFIELD_ENUM(E, Id, State, Prio, Pad);
+    DEFINE_BITFIELD_SIZES(S, 20, 3, 2, 7);
+    DEFINE_BITFIELDS(R, E, S);
+
+    uint64_t seed = 29;
+    bool ok = true;
+    const std::size_t sizes[] = { 0, 1, 100, 255, 256, 5000 };
+    for (std::size_t n : sizes) {
+        std::vector<R> recs(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            recs[i] = R::fromBits(static_cast<uint32_t>(nextRand(seed)));
+        }
+        ok = ok && sortsLikeStable<R, E::Prio, E::State, E::Id>(recs, 1);
+        ok = ok && sortsLikeStable<R, E::State>(recs, 1);
+        ok = ok && sortsLikeStable<R, E::Id, E::Prio>(recs, 1);
+        ok = ok && sortsLikeStable<R, E::Pad, E::Prio, E::State, E::Id>(recs, 1);
+    }
+    TEST_TRUE(ok);
+}
+
+CPP_TEST( storages )
+{
+    DEFINE_BITFIELD_ENUM(E8, Lo, Hi);
+    DEFINE_BITFIELD_SIZES(S8, 3, 5);
+    DEFINE_BITFIELDS(R8, E8, S8);
+
+    DEFINE_BITFIELD_ENUM(E64, A, B, C);
+    DEFINE_BITFIELD_SIZES(S64, 30, 30, 4);
+    DEFINE_BITFIELDS(R64, E64, S64);
+
+    uint64_t seed = 31;
+    std::vector<R8> r8(3000);
+    std::vector<R64> r64(3000);
+    for (std::size_t i = 0; i < r8.size(); ++i) {
+        r8[i] = R8::fromBits(static_cast<uint8_t>(nextRand(seed)));
+        r64[i] = R64::fromBits(nextRand(seed) ^ (nextRand(seed) << 40));
+    }
+    TEST_TRUE((sortsLikeStable<R8, E8::Hi, E8::Lo>(r8, 1)));
+    TEST_TRUE((sortsLikeStable<R64, E64::C, E64::B, E64::A>(r64, 1)));
+    TEST_TRUE((sortsLikeStable<R64, E64::A>(r64, 1)));
+}
+
+CPP_TEST( parallel )
+{
+    DEFINE_BITFIELD_ENUM(E, Id, State, Prio);
+    DEFINE_BITFIELD_SIZES(S, 24, 3, 2);
+    DEFINE_BITFIELDS(R, E, S);
+
+    // enough records for three slices; Prio is constant, so its digit is
+    // skipped, and State repeats in long runs
+    const std::size_t n = (1 << 20) - 3;
+    std::vector<R> recs(n);
+    uint64_t seed = 37;
+    for (std::size_t i = 0; i < n; ++i) {
+        recs[i] = R::make(E::Id, nextRand(seed) & 0xFFFFFF, E::State, (i / 1000) % 8, E::Prio, 1);
+    }
+    TEST_TRUE((sortsLikeStable<R, E::Prio, E::State, E::Id>(recs, 3)));
+    TEST_TRUE((sortsLikeStable<R, E::Prio, E::State>(recs, 3)));
+    TEST_TRUE((sortsLikeStable<R, E::State, E::Id>(recs, 0)));
+}
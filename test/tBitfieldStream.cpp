@@ -0,0 +1,148 @@
+/**
+ * \file tBitfieldStream.cpp
+ * \date Oct 16, 2026
+ */
+
+#include "unittest.hpp"
+
+#include <cppbitfield/bitfield_stream.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+DEFINE_BITFIELD_ENUM(E, A, B, C);
+DEFINE_BITFIELD_SIZES(S, 9, 30, 11);
+DEFINE_BITFIELDS(R, E, S);
+DEFINE_BITFIELD_STREAM_WRITER(Writer, E, S);
+DEFINE_BITFIELD_STREAM_READER(Reader, E, S);
+
+namespace {
+
+    const char * const PATH = "tBitfieldStream.bin";
+
+    R record(uint64_t i)
+    {
+        return R::make(E::A, i & 0x1FF, E::B, (i * 2654435761u) & 0x3FFFFFFF, E::C, (i >> 9) & 0x7FF);
+    }
+
+    bool writeRecords(uint64_t n, std::size_t perBlock)
+    {
+        Writer w;
+        bool ok = w.open(PATH, perBlock) == cppbitfield::BitFieldFileStatus::Ok;
+        for (uint64_t i = 0; i < n; ++i) {
+            w.push(record(i));
+        }
+        ok = ok && w.numRecords() == n;
+        return w.close() == cppbitfield::BitFieldFileStatus::Ok && ok;
+    }
+
+    void patchHeader(std::size_t offset, uint64_t value)
+    {
+        std::FILE * f = std::fopen(PATH, "r+b");
+        std::fseek(f, static_cast<long>(offset), SEEK_SET);
+        std::fwrite(&value, sizeof(value), 1, f);
+        std::fclose(f);
+    }
+
+} // namespace
+
+CPP_TEST( roundTrip )
+{
+    const uint64_t n = 10000 + 17;
+    TEST_TRUE(writeRecords(n, 512));
+
+    const unsigned workers[] = { 1, 3 };
+    for (int w = 0; w < 2; ++w) {
+        Reader r;
+        TEST_TRUE(r.open(PATH, workers[w], w == 0 ? 2 : 0) == cppbitfield::BitFieldFileStatus::Ok);
+        TEST_TRUE(r.size() == n);
+        uint64_t i = 0;
+        bool same = true;
+        for (Reader::iterator it = r.begin(); it != r.end(); ++it, ++i) {
+            same = same && it->bits() == record(i).bits();
+        }
+        TEST_TRUE(same);
+        TEST_TRUE(i == n);
+        TEST_TRUE(r.status() == cppbitfield::BitFieldFileStatus::Ok);
+    }
+
+    // blocks, and closing before the end
+    Reader r;
+    TEST_TRUE(r.open(PATH, 2) == cppbitfield::BitFieldFileStatus::Ok);
+    const R * recs = nullptr;
+    std::size_t count = 0;
+    TEST_TRUE(r.nextBlock(recs, count));
+    TEST_TRUE(count == 512 && recs[511].bits() == record(511).bits());
+    r.close();
+
+    TEST_TRUE(writeRecords(0, 64));
+    TEST_TRUE(r.open(PATH) == cppbitfield::BitFieldFileStatus::Ok);
+    TEST_TRUE(r.begin() == r.end());
+    std::remove(PATH);
+}
+
+CPP_TEST( corrupt )
+{
+    TEST_TRUE(writeRecords(3000, 1000));
+
+    DEFINE_BITFIELD_SIZES(Other, 9, 31, 10);
+    cppbitfield::BitFieldStreamReader<E, Other> other;
+    TEST_TRUE(other.open(PATH) == cppbitfield::BitFieldFileStatus::LayoutMismatch);
+    cppbitfield::BitFields<E, Other> otherRec;
+    TEST_TRUE(!other.next(otherRec));
+
+    // flip one payload bit of the second block
+    std::FILE * f = std::fopen(PATH, "rb");
+    std::vector<char> buf(1 << 16);
+    const std::size_t n = std::fread(buf.data(), 1, buf.size(), f);
+    std::fclose(f);
+    const std::size_t blockBytes = sizeof(cppbitfield::BitFieldBlockHeader) + ((1000 * 50 + 63) / 64) * 8;
+    buf[sizeof(cppbitfield::BitFieldStreamHeader) + blockBytes + sizeof(cppbitfield::BitFieldBlockHeader) + 5] ^= 4;
+    f = std::fopen(PATH, "wb");
+    std::fwrite(buf.data(), 1, n, f);
+    std::fclose(f);
+
+    Reader r;
+    TEST_TRUE(r.open(PATH, 2) == cppbitfield::BitFieldFileStatus::Ok);
+    R rec;
+    uint64_t seen = 0;
+    while (r.next(rec)) {
+        ++seen;
+    }
+    TEST_TRUE(seen == 1000);
+    TEST_TRUE(r.status() == cppbitfield::BitFieldFileStatus::ChecksumMismatch);
+
+    f = std::fopen(PATH, "wb");
+    std::fwrite(buf.data(), 1, n - 8, f);
+    std::fclose(f);
+    TEST_TRUE(r.open(PATH) == cppbitfield::BitFieldFileStatus::Truncated);
+    std::remove(PATH);
+}
+
+CPP_TEST( badHeader )
+{
+    using cppbitfield::BitFieldFileStatus;
+    using cppbitfield::BitFieldStreamHeader;
+
+    // one short block: a huge recordsPerBlock is legal but must not size
+    // the read buffers
+    TEST_TRUE(writeRecords(10, 64));
+    patchHeader(offsetof(BitFieldStreamHeader, recordsPerBlock), uint64_t(1) << 42);
+    Reader r;
+    TEST_TRUE(r.open(PATH, 1, 2) == BitFieldFileStatus::Ok);
+    R rec;
+    uint64_t seen = 0;
+    while (r.next(rec)) {
+        seen += rec.bits() == record(seen).bits() ? 1 : 0;
+    }
+    TEST_TRUE(seen == 10 && r.status() == BitFieldFileStatus::Ok);
+
+    // block sizes that overflow, and more records than the file can hold
+    patchHeader(offsetof(BitFieldStreamHeader, recordsPerBlock), uint64_t(1) << 62);
+    TEST_TRUE(r.open(PATH, 1, 2) == BitFieldFileStatus::BadHeader);
+    patchHeader(offsetof(BitFieldStreamHeader, recordsPerBlock), uint64_t(1) << 42);
+    patchHeader(offsetof(BitFieldStreamHeader, numRecords), uint64_t(1) << 40);
+    TEST_TRUE(r.open(PATH, 1, 2) == BitFieldFileStatus::Truncated);
+    std::remove(PATH);
+}
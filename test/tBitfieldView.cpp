@@ -0,0 +1,251 @@
+/**
+ * \file tBitfieldView.cpp
+ * \date Oct 16, 2026
+ */
+
+#include "unittest.hpp"
+#include "testutil.hpp"
+
+#include <cppbitfield/bitfield_view.hpp>
+
+#include <cstring>
+#include <vector>
+
+namespace {
+
+    using testutil::nextRand;
+
+    // Serializes the low `size` bytes of the words least significant first,
+    // reversed for big-endian.
+    void toBytes(const uint64_t * words, int size, bool bigEndian, unsigned char * out)
+    {
+        for (int i = 0; i < size; ++i) {
+            const unsigned char b = static_cast<unsigned char>(words[i / 8] >> (8 * (i % 8)));
+            out[bigEndian ? size - 1 - i : i] = b;
+        }
+    }
+
+} // namespace
+
+DEFINE_BITFIELD_ENUM(NarrowE, A, B, C);
+DEFINE_BITFIELD_SIZES(NarrowS, 7, 12, 5);
+DEFINE_BITFIELDS(Narrow, NarrowE, NarrowS);
+
+DEFINE_BITFIELD_ENUM(WideE, A, B, C, D);
+DEFINE_BITFIELD_SIZES(WideS, 5, 60, 13, 9);
+DEFINE_BITFIELDS(Wide, WideE, WideS);
+
+namespace {
+
+    template <class View>
+    bool sameFields(const View & v, const Narrow & r)
+    {
+        return v.template get<NarrowE::A>() == r.get<NarrowE::A>() &&
+               v.template get<NarrowE::B>() == r.get<NarrowE::B>() &&
+               v.template get<NarrowE::C>() == r.get<NarrowE::C>();
+    }
+
+    template <class View>
+    bool sameFields(const View & v, const Wide & r)
+    {
+        return v.template get<WideE::A>() == r.get<WideE::A>() &&
+               v.template get<WideE::B>() == r.get<WideE::B>() &&
+               v.template get<WideE::C>() == r.get<WideE::C>() &&
+               v.template get<WideE::D>() == r.get<WideE::D>();
+    }
+
+    template <class Endian>
+    bool checkNarrow()
+    {
+        using View = cppbitfield::BitFieldsView<NarrowE, NarrowS, Endian>;
+        using MView = cppbitfield::MutableBitFieldsView<NarrowE, NarrowS, Endian>;
+        static_assert(View::SizeInBytes == 3, "24-bit record is 3 bytes");
+
+        const int n = 16;
+        uint64_t seed = 11;
+        std::vector<Narrow> recs(n);
+        // one byte of slack in front so every record is misaligned
+        std::vector<unsigned char> buf(1 + n * View::SizeInBytes);
+        for (int i = 0; i < n; ++i) {
+            const uint64_t word = nextRand(seed) & 0xFFFFFF;
+            recs[i] = Narrow::fromBits(static_cast<uint32_t>(word));
+            toBytes(&word, View::SizeInBytes, Endian::IsBig, &buf[1 + i * View::SizeInBytes]);
+        }
+
+        bool ok = true;
+        const View view(&buf[1]);
+        for (int i = 0; i < n; ++i) {
+            ok = ok && sameFields(view.at(i), recs[i]);
+            ok = ok && view.at(i).load().bits() == recs[i].bits();
+        }
+
+        const std::vector<unsigned char> before = buf;
+        MView rec = MView(&buf[1]).at(5);
+        rec.template set<NarrowE::B>(0xABC);
+        rec.template set<NarrowE::C>(true);
+        recs[5].set<NarrowE::B>(0xABC);
+        recs[5].set<NarrowE::C>(true);
+        ok = ok && sameFields(View(rec), recs[5]);
+        for (int i = 0; i < static_cast<int>(buf.size()); ++i) {
+            const bool inRecord = i >= 1 + 5 * View::SizeInBytes && i < 1 + 6 * View::SizeInBytes;
+            ok = ok && (inRecord || buf[i] == before[i]);
+        }
+
+        MView(&buf[1]).at(6).store(recs[5]);
+        ok = ok && std::memcmp(&buf[1 + 5 * View::SizeInBytes], &buf[1 + 6 * View::SizeInBytes], View::SizeInBytes) == 0;
+        return ok;
+    }
+
+    template <class Endian>
+    bool checkWide()
+    {
+        using View = cppbitfield::BitFieldsView<WideE, WideS, Endian>;
+        using MView = cppbitfield::MutableBitFieldsView<WideE, WideS, Endian>;
+        static_assert(View::SizeInBytes == 11, "87-bit record is 11 bytes");
+
+        const int n = 16;
+        uint64_t seed = 5;
+        std::vector<Wide> recs(n);
+        std::vector<unsigned char> buf(3 + n * View::SizeInBytes, 0xFF);
+        for (int i = 0; i < n; ++i) {
+            const uint64_t words[2] = { nextRand(seed) ^ (nextRand(seed) << 32), nextRand(seed) & 0x7FFFFF };
+            recs[i] = Wide::fromBits(Wide::StorageType{ { words[0], words[1] } });
+            toBytes(words, View::SizeInBytes, Endian::IsBig, &buf[3 + i * View::SizeInBytes]);
+        }
+
+        bool ok = true;
+        const View view(&buf[3]);
+        for (int i = 0; i < n; ++i) {
+            const Wide r = view.at(i).load();
+            ok = ok && sameFields(view.at(i), recs[i]);
+            ok = ok && r.bits().words[0] == recs[i].bits().words[0] && r.bits().words[1] == recs[i].bits().words[1];
+        }
+
+        // B starts mid-byte and spans nine bytes
+        MView rec = MView(&buf[3]).at(2);
+        rec.template set<WideE::B>(0xFEDCBA9876543210ULL & ((1ULL << 60) - 1));
+        rec.template set<WideE::D>(0x155);
+        recs[2].set<WideE::B>(0xFEDCBA9876543210ULL & ((1ULL << 60) - 1));
+        recs[2].set<WideE::D>(0x155);
+        ok = ok && sameFields(rec, recs[2]);
+        ok = ok && sameFields(view.at(1), recs[1]) && sameFields(view.at(3), recs[3]);
+        ok = ok && buf[0] == 0xFF && buf[1] == 0xFF && buf[2] == 0xFF;
+
+        MView(&buf[3]).at(7).store(recs[2]);
+        ok = ok && sameFields(view.at(7), recs[2]);
+        ok = ok && sameFields(view.at(6), recs[6]) && sameFields(view.at(8), recs[8]);
+        return ok;
+    }
+
+} // namespace
+
+CPP_TEST( narrow )
+{
+    TEST_TRUE(checkNarrow<cppbitfield::LittleEndian>());
+    TEST_TRUE(checkNarrow<cppbitfield::BigEndian>());
+}
+
+CPP_TEST( wide )
+{
+    TEST_TRUE(checkWide<cppbitfield::LittleEndian>());
+    TEST_TRUE(checkWide<cppbitfield::BigEndian>());
+}
+
+CPP_TEST( fullWidth )
+{
+    DEFINE_BITFIELD_ENUM(E, A, B, C);
+    DEFINE_BITFIELD_SIZES(S, 10, 12, 10);
+    DEFINE_BITFIELDS(R, E, S);
+    DEFINE_BITFIELDS_VIEW(LeView, E, S, LittleEndian);
+    DEFINE_BITFIELDS_VIEW(BeView, E, S, BigEndian);
+
+    // network order: 0x12345678
+    const unsigned char be[5] = { 0, 0x12, 0x34, 0x56, 0x78 };
+    const unsigned char le[5] = { 0, 0x78, 0x56, 0x34, 0x12 };
+    const R r = R::fromBits(0x12345678u);
+
+    TEST_TRUE(BeView(be + 1).get<E::A>() == r.get<E::A>());
+    TEST_TRUE(BeView(be + 1).get<E::B>() == r.get<E::B>());
+    TEST_TRUE(BeView(be + 1).get<E::C>() == r.get<E::C>());
+    TEST_TRUE(LeView(le + 1).load().bits() == r.bits());
+    TEST_TRUE(LeView(le + 1).get<E::B>() == r.get<E::B>());
+}
+
+CPP_TEST( byteFields )
+{
+    // 24-bit record: B is a whole byte in the middle; a 72-bit record has
+    // whole-byte fields in both words
+    DEFINE_BITFIELD_ENUM(E, A, B, C);
+    DEFINE_BITFIELD_SIZES(S, 8, 8, 8);
+    DEFINE_MUTABLE_BITFIELDS_VIEW(LeView, E, S, LittleEndian);
+    DEFINE_MUTABLE_BITFIELDS_VIEW(BeView, E, S, BigEndian);
+    unsigned char buf[3] = { 0x11, 0x22, 0x33 };
+    LeView(buf).set<E::A>(0xAA);
+    TEST_TRUE(buf[0] == 0xAA && buf[1] == 0x22 && buf[2] == 0x33);
+    BeView(buf).set<E::A>(0xBB);
+    TEST_TRUE(buf[0] == 0xAA && buf[1] == 0x22 && buf[2] == 0xBB);
+    TEST_TRUE(BeView(buf).get<E::B>() == 0x22 && BeView(buf).get<E::C>() == 0xAA);
+
+    DEFINE_BITFIELD_ENUM(F, A, B, C);
+    DEFINE_BITFIELD_SIZES(T, 4, 4, 64);
+    DEFINE_MUTABLE_BITFIELDS_VIEW(WideLe, F, T, LittleEndian);
+    DEFINE_MUTABLE_BITFIELDS_VIEW(WideBe, F, T, BigEndian);
+    unsigned char wide[9] = { 0x21, 0, 0, 0, 0, 0, 0, 0, 0 };
+    WideLe(wide).set<F::C>(0x0807060504030201ULL);
+    TEST_TRUE(wide[0] == 0x21 && wide[1] == 0x01 && wide[8] == 0x08);
+    TEST_TRUE(WideLe(wide).get<F::A>() == 1 && WideLe(wide).get<F::B>() == 2);
+    WideBe(wide).set<F::C>(0x1112131415161718ULL);
+    TEST_TRUE(wide[0] == 0x11 && wide[7] == 0x18 && wide[8] == 0x08);
+    TEST_TRUE(WideBe(wide).get<F::C>() == 0x1112131415161718ULL);
+}
+
+DEFINE_BITFIELD_ENUM(Ipv4E, Version, Ihl, Dscp, Ecn, TotalLength, Identification, Flags, FragmentOffset,
+                     Ttl, Protocol, Checksum, Source, Destination);
+DEFINE_BITFIELD_LAYOUT(Ipv4S, MsbFirst, 4, 4, 6, 2, 16, 16, 3, 13, 8, 8, 16, 32, 32);
+DEFINE_BITFIELDS_VIEW(Ipv4View, Ipv4E, Ipv4S, BigEndian);
+DEFINE_MUTABLE_BITFIELDS_VIEW(Ipv4MutableView, Ipv4E, Ipv4S, BigEndian);
+
+CPP_TEST( networkOrder )
+{
+    const unsigned char hdr[20] = { 0x45, 0x00, 0x00, 0x54, 0x1c, 0x46, 0x40, 0x00, 0x40, 0x01,
+                                    0xa1, 0x2b, 0xc0, 0xa8, 0x00, 0x01, 0x08, 0x08, 0x04, 0x04 };
+    const Ipv4View ip(hdr);
+    TEST_TRUE(Ipv4View::SizeInBytes == 20);
+    TEST_TRUE(ip.get<Ipv4E::Version>() == 4);
+    TEST_TRUE(ip.get<Ipv4E::Ihl>() == 5);
+    TEST_TRUE(ip.get<Ipv4E::Dscp>() == 0);
+    TEST_TRUE(ip.get<Ipv4E::TotalLength>() == 0x54);
+    TEST_TRUE(ip.get<Ipv4E::Identification>() == 0x1c46);
+    TEST_TRUE(ip.get<Ipv4E::Flags>() == 2);
+    TEST_TRUE(ip.get<Ipv4E::FragmentOffset>() == 0);
+    TEST_TRUE(ip.get<Ipv4E::Ttl>() == 64);
+    TEST_TRUE(ip.get<Ipv4E::Protocol>() == 1);
+    TEST_TRUE(ip.get<Ipv4E::Checksum>() == 0xa12b);
+    TEST_TRUE(ip.get<Ipv4E::Source>() == 0xc0a80001);
+    TEST_TRUE(ip.get<Ipv4E::Destination>() == 0x08080404);
+
+    // a record copy uses the same MSB-first offsets
+    TEST_TRUE(ip.load().get<Ipv4E::Ttl>() == 64);
+
+    unsigned char out[20] = { };
+    Ipv4MutableView(out).store(ip.load());
+    TEST_TRUE(std::memcmp(out, hdr, sizeof(hdr)) == 0);
+
+    Ipv4MutableView m(out);
+    m.set<Ipv4E::Ttl>(63);
+    m.set<Ipv4E::Ecn>(3);
+    TEST_TRUE(out[8] == 63 && out[1] == 0x03);
+    TEST_TRUE(std::memcmp(out + 9, hdr + 9, 11) == 0);
+
+    // 12-bit record: four padding bits below the last field on the wire
+    DEFINE_BITFIELD_ENUM(E, A, B, C);
+    DEFINE_BITFIELD_LAYOUT(S, MsbFirst, 3, 4, 5);
+    DEFINE_BITFIELDS_VIEW(V, E, S, BigEndian);
+    DEFINE_MUTABLE_BITFIELDS_VIEW(MV, E, S, BigEndian);
+    unsigned char small[2] = { 0xB5, 0xAF }; // 101 1010 11010 1111
+    TEST_TRUE(V(small).get<E::A>() == 5);
+    TEST_TRUE(V(small).get<E::B>() == 0xA);
+    TEST_TRUE(V(small).get<E::C>() == 0x1A);
+    MV(small).store(V(small).load().with<E::C>(1));
+    TEST_TRUE(small[0] == 0xB4 && small[1] == 0x1F);
+}
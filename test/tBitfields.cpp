@@ -81,3 +81,385 @@ CPP_TEST( t0 )
     TEST_TRUE(bVal == 2);
     TEST_TRUE(cVal == 4);
 }
+
+CPP_TEST( t1 )
+{
+    // 200 bits: B and F cross a word boundary, C and D do not
+    DEFINE_BITFIELD_ENUM(
+         HdrEnum,
+               A,
+               B,
+               C,
+               D,
+               E,
+               F);
+
+    DEFINE_BITFIELD_SIZES(
+        HdrSizes,
+               3,
+              64,
+              61,
+               7,
+              33,
+              32);
+
+    DEFINE_BITFIELDS(
+        Hdr,
+        HdrEnum,
+        HdrSizes);
+
+    TEST_TRUE(Hdr::NumBits == 200);
+    TEST_TRUE(sizeof(Hdr) == 4 * sizeof(uint64_t));
+
+    auto isCorrectType = std::is_same<uint64_t, Hdr::ValueType>::value;
+    TEST_TRUE(isCorrectType);
+
+    Hdr x;
+    TEST_TRUE(x.get<HdrEnum::A>() == 0);
+    TEST_TRUE(x.get<HdrEnum::B>() == 0);
+    TEST_TRUE(x.get<HdrEnum::F>() == 0);
+
+    const uint64_t b = 0xF0E1D2C3B4A59687ULL;
+    const uint64_t c = 0x1BCDEF0123456789ULL;
+    x.set<HdrEnum::A>(5);
+    x.set<HdrEnum::B>(b);
+    x.set<HdrEnum::C>(c);
+    x.set<HdrEnum::D>(127);
+    x.set<HdrEnum::E>(0x1FFFFFFFFULL);
+    x.set<HdrEnum::F>(0xDEADBEEF);
+
+    TEST_TRUE(x.get<HdrEnum::A>() == 5);
+    TEST_TRUE(x.get<HdrEnum::B>() == b);
+    TEST_TRUE(x.get<HdrEnum::C>() == c);
+    TEST_TRUE(x.get<HdrEnum::D>() == 127);
+    TEST_TRUE(x.get<HdrEnum::E>() == 0x1FFFFFFFFULL);
+    TEST_TRUE(x.get<HdrEnum::F>() == 0xDEADBEEF);
+
+    x.set<HdrEnum::B>(0);
+    x.set<HdrEnum::E>(true);
+    TEST_TRUE(x.get<HdrEnum::A>() == 5);
+    TEST_TRUE(x.get<HdrEnum::B>() == 0);
+    TEST_TRUE(x.get<HdrEnum::C>() == c);
+    TEST_TRUE(x.get<HdrEnum::D>() == 127);
+    TEST_TRUE(x.get<HdrEnum::E>() == 1);
+    TEST_TRUE(x.get<HdrEnum::F>() == 0xDEADBEEF);
+
+    Hdr y = Hdr::fromBits(x.bits());
+    TEST_TRUE(y.get<HdrEnum::C>() == c);
+    TEST_TRUE(y.get<HdrEnum::F>() == 0xDEADBEEF);
+}
+
+CPP_TEST( t2 )
+{
+    DEFINE_BITFIELD_ENUM(
+         FooEnum,
+               A,
+               B,
+               C,
+               D);
+
+    DEFINE_BITFIELD_SIZES(
+        FooSizes,
+               3,
+               9,
+               1,
+              12);
+
+    DEFINE_BITFIELDS(
+        Foo,
+        FooEnum,
+        FooSizes);
+
+    Foo x;
+    x.set<FooEnum::D>(4095);
+    x.set<FooEnum::A, FooEnum::B, FooEnum::C>(5, 300, true);
+    TEST_TRUE(x.get<FooEnum::A>() == 5);
+    TEST_TRUE(x.get<FooEnum::B>() == 300);
+    TEST_TRUE(x.get<FooEnum::C>() == 1);
+    TEST_TRUE(x.get<FooEnum::D>() == 4095);
+
+    // order of the field list is free
+    x.set<FooEnum::C, FooEnum::A>(false, 2);
+    std::tuple<uint32_t, uint32_t, uint32_t, uint32_t> all =
+        x.get<FooEnum::A, FooEnum::B, FooEnum::C, FooEnum::D>();
+    TEST_TRUE(std::get<0>(all) == 2);
+    TEST_TRUE(std::get<1>(all) == 300);
+    TEST_TRUE(std::get<2>(all) == 0);
+    TEST_TRUE(std::get<3>(all) == 4095);
+
+    DEFINE_BITFIELD_ENUM(
+         HdrEnum,
+               A,
+               B,
+               C);
+
+    DEFINE_BITFIELD_SIZES(
+        HdrSizes,
+              60,
+              10,
+              64);
+
+    DEFINE_BITFIELDS(
+        Hdr,
+        HdrEnum,
+        HdrSizes);
+
+    Hdr h;
+    h.set<HdrEnum::A, HdrEnum::B, HdrEnum::C>(1ULL << 59, 1023, ~0ULL);
+    uint64_t a, b, c;
+    std::tie(a, b, c) = h.get<HdrEnum::A, HdrEnum::B, HdrEnum::C>();
+    TEST_TRUE(a == (1ULL << 59));
+    TEST_TRUE(b == 1023);
+    TEST_TRUE(c == ~0ULL);
+}
+
+DEFINE_BITFIELD_ENUM(
+     OpEnum,
+           Code,
+           Size,
+           Signed,
+           Latency);
+
+DEFINE_BITFIELD_SIZES(
+    OpSizes,
+           7,
+           2,
+           1,
+           6);
+
+DEFINE_BITFIELDS(
+    Op,
+    OpEnum,
+    OpSizes);
+
+// constant initialized: no dynamic initialization at start up
+constexpr Op OP_TABLE[] = {
+    Op::make(OpEnum::Code, 1, OpEnum::Size, 3),
+    Op::make(OpEnum::Code, 2, OpEnum::Signed, true, OpEnum::Latency, 40),
+    Op().with<OpEnum::Code>(127).with<OpEnum::Latency>(63),
+    Op::fromBits(0xFFFF)
+};
+
+static_assert(OP_TABLE[0].get<OpEnum::Code>() == 1, "constexpr get");
+static_assert(OP_TABLE[0].get<OpEnum::Size>() == 3, "constexpr get");
+static_assert(OP_TABLE[1].get<OpEnum::Signed, bool>(), "constexpr get");
+static_assert(OP_TABLE[1].get<OpEnum::Latency>() == 40, "constexpr get");
+static_assert(OP_TABLE[2].bits() == (127 | (63 << 10)), "constexpr with");
+static_assert(Op::make(OpEnum::Code, 5, OpEnum::Code, 9).get<OpEnum::Code>() == 9, "later value wins");
+
+CPP_TEST( t3 )
+{
+    TEST_TRUE(OP_TABLE[3].get<OpEnum::Latency>() == 63);
+
+    Op x = OP_TABLE[1].with<OpEnum::Signed>(false);
+    TEST_TRUE(x.get<OpEnum::Signed>() == 0);
+    TEST_TRUE(x.get<OpEnum::Code>() == 2);
+    TEST_TRUE(OP_TABLE[1].get<OpEnum::Signed>() == 1);
+
+    DEFINE_BITFIELD_ENUM(
+         HdrEnum,
+               A,
+               B,
+               C);
+
+    DEFINE_BITFIELD_SIZES(
+        HdrSizes,
+              60,
+              10,
+              64);
+
+    DEFINE_BITFIELDS(
+        Hdr,
+        HdrEnum,
+        HdrSizes);
+
+    constexpr Hdr h = Hdr::make(HdrEnum::B, 1023, HdrEnum::C, 0x8000000000000001ULL).with<HdrEnum::A>(7);
+    static_assert(h.get<HdrEnum::A>() == 7, "multi-word constexpr");
+    static_assert(h.get<HdrEnum::B>() == 1023, "straddling field");
+    static_assert(h.get<HdrEnum::C>() == 0x8000000000000001ULL, "straddling field");
+    TEST_TRUE(h.bits().words[0] == (7 | (0xFULL << 60)));
+    TEST_TRUE(h.bits().words[1] == (0x3F | (1ULL << 6)));
+    TEST_TRUE(h.bits().words[2] == (1ULL << 5));
+}
+
+CPP_TEST( t4 )
+{
+    DEFINE_BITFIELD_ENUM(
+         MsbEnum,
+               A,
+               B,
+               C);
+
+    DEFINE_BITFIELD_LAYOUT(
+        MsbSizes,
+        MsbFirst,
+               1,
+               2,
+               3);
+
+    DEFINE_BITFIELDS(
+        Msb,
+        MsbEnum,
+        MsbSizes);
+
+    TEST_TRUE(Msb::NumBits == 6);
+    TEST_TRUE(Msb::FieldOffset<0>::value == 5);
+    TEST_TRUE(Msb::FieldOffset<1>::value == 3);
+    TEST_TRUE(Msb::FieldOffset<2>::value == 0);
+
+    Msb x;
+    x.set<MsbEnum::A>(1);
+    x.set<MsbEnum::B>(2);
+    x.set<MsbEnum::C>(5);
+    TEST_TRUE(x.bits() == ((1 << 5) | (2 << 3) | 5));
+
+    constexpr Msb y = Msb::make(MsbEnum::A, 1, MsbEnum::B, 2, MsbEnum::C, 5);
+    static_assert(y.get<MsbEnum::B>() == 2, "constexpr MSB-first offsets");
+    TEST_TRUE(y.bits() == x.bits());
+
+    DEFINE_BITFIELD_ENUM(
+         WideEnum,
+               A,
+               B);
+
+    DEFINE_BITFIELD_LAYOUT(
+        WideSizes,
+        MsbFirst,
+              10,
+              64);
+
+    DEFINE_BITFIELDS(
+        Wide,
+        WideEnum,
+        WideSizes);
+
+    // A holds the top bits of the second word, B straddles both words
+    constexpr Wide w = Wide::make(WideEnum::A, 0x3FF, WideEnum::B, 0x8000000000000001ULL);
+    static_assert(w.get<WideEnum::B>() == 0x8000000000000001ULL, "straddling field");
+    TEST_TRUE(w.bits().words[0] == 0x8000000000000001ULL);
+    TEST_TRUE(w.bits().words[1] == 0x3FF);
+}
+
+CPP_TEST( t5 )
+{
+    DEFINE_BITFIELD_ENUM(
+         ByteEnum,
+               A,
+               B,
+               C,
+               D);
+
+    // all but C are whole bytes/words: set is a narrow store to their bytes
+    DEFINE_BITFIELD_SIZES(
+        ByteSizes,
+               8,
+              16,
+               5,
+              32);
+
+    DEFINE_BITFIELDS(
+        Bytes,
+        ByteEnum,
+        ByteSizes);
+
+    Bytes x;
+    x.set<ByteEnum::A>(0xFF);
+    x.set<ByteEnum::C>(5);
+    x.set<ByteEnum::B>(0x1234);
+    x.set<ByteEnum::D>(0xFFFFFFFF);
+    x.set<ByteEnum::D>(0x89ABCDEF);
+    TEST_TRUE(x.bits() == (0xFFULL | (0x1234ULL << 8) | (5ULL << 24) | (0x89ABCDEFULL << 29)));
+    static_assert(!cppbitfield::detail::ByteAligned<29, 32>::value, "D follows a 5-bit field");
+
+    DEFINE_BITFIELD_SIZES(
+        AlignedSizes,
+               8,
+              16,
+               8,
+              32);
+
+    DEFINE_BITFIELDS(
+        Aligned,
+        ByteEnum,
+        AlignedSizes);
+
+    Aligned z = Aligned::fromBits(~0ULL);
+    z.set<ByteEnum::D>(0x89ABCDEF);
+    z.set<ByteEnum::B>(0);
+    TEST_TRUE(z.bits() == (0xFFULL | (0xFFULL << 24) | (0x89ABCDEFULL << 32)));
+    TEST_TRUE(x.get<ByteEnum::C>() == 5);
+
+    DEFINE_BITFIELD_ENUM(
+         ByteEnum2,
+               A,
+               B);
+
+    DEFINE_BITFIELD_SIZES(
+        ByteSizes2,
+              24,
+               8);
+
+    DEFINE_BITFIELDS(
+        Bytes2,
+        ByteEnum2,
+        ByteSizes2);
+
+    Bytes2 y = Bytes2::fromBits(0x00ABCDEF);
+    y.set<ByteEnum2::B>(0x5A);
+    TEST_TRUE(y.bits() == 0x5AABCDEF);
+
+    // multi-word: whole-byte fields of either word
+    DEFINE_BITFIELD_ENUM(
+         WideEnum,
+               A,
+               B,
+               C,
+               D);
+
+    DEFINE_BITFIELD_SIZES(
+        WideSizes,
+              56,
+               8,
+              64,
+               4);
+
+    DEFINE_BITFIELDS(
+        Wide,
+        WideEnum,
+        WideSizes);
+
+    Wide w;
+    w.set<WideEnum::A>(0xFFFFFFFFFFFFFFULL);
+    w.set<WideEnum::D>(0xF);
+    w.set<WideEnum::B>(0x42);
+    w.set<WideEnum::C>(0x0123456789ABCDEFULL);
+    TEST_TRUE(w.bits().words[0] == (0xFFFFFFFFFFFFFFULL | (0x42ULL << 56)));
+    TEST_TRUE(w.bits().words[1] == 0x0123456789ABCDEFULL);
+    TEST_TRUE(w.bits().words[2] == 0xF);
+}
+
+CPP_TEST( t6 )
+{
+    // 40 fields: offsets and lengths come from one table per sizes pack
+    DEFINE_BITFIELD_SIZES(
+        WideSizes,
+        1, 2, 3, 4, 5, 6, 7, 8, 1, 2, 3, 4, 5, 6, 7, 8, 1, 2, 3, 4,
+        5, 6, 7, 8, 1, 2, 3, 4, 5, 6, 7, 8, 1, 2, 3, 4, 5, 6, 7, 8);
+
+    static_assert(WideSizes::NumFields == 40, "fields");
+    static_assert(WideSizes::NumBits == 5 * 36, "bits");
+    static_assert(WideSizes::Get<39>::value == 8, "last length");
+    static_assert(WideSizes::SumTill<39>::value == 5 * 36 - 8, "last offset");
+    static_assert(WideSizes::offset(17) == 2 * 36 + 1, "constexpr offset");
+
+    int offset = 0;
+    for (int i = 0; i < WideSizes::NumFields; ++i) {
+        TEST_TRUE(WideSizes::length(i) == 1 + i % 8);
+        TEST_TRUE(WideSizes::offset(i) == offset);
+        offset += WideSizes::length(i);
+    }
+
+    using Msb = cppbitfield::BitFieldLayout<cppbitfield::MsbFirst, WideSizes>;
+    static_assert(Msb::SumTill<0>::value == 5 * 36 - 1, "mirrored first field");
+    TEST_TRUE(Msb::offset(39) == 0);
+}
@@ -0,0 +1,56 @@
+/**
+ * \file testutil.hpp
+ * \date Oct 16, 2026
+ *
+ * Helpers shared by the cppbitfield tests.
+ */
+
+#ifndef CPPBITFIELD_TESTUTIL_HPP
+#define CPPBITFIELD_TESTUTIL_HPP
+
+#include <cppbitfield/bitfield_simd.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace testutil {
+
+    // Seeded generator for random test data (splitmix64): every output
+    // bit is usable, so masking to any width up to 64 bits is fine.
+    inline uint64_t nextRand(uint64_t & state)
+    {
+        state += 0x9E3779B97F4A7C15ULL;
+        uint64_t z = state;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // n records of random bits, for records of up to 64 bits.
+    template <class Record>
+    std::vector<Record> randomRecords(std::size_t n, uint64_t seed)
+    {
+        std::vector<Record> ret(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            ret[i] = Record::fromBits(static_cast<typename Record::StorageType>(
+                nextRand(seed) & cppbitfield::detail::LowMask<uint64_t, Record::NumBits>::value));
+        }
+        return ret;
+    }
+
+    // Calls fn(level) for every SIMD level, available on this CPU or not:
+    // the library clamps each to what the CPU supports.
+    template <class Fn>
+    void forEachSimdLevel(Fn fn)
+    {
+        const cppbitfield::SimdLevel levels[] = { cppbitfield::SimdLevel::Scalar, cppbitfield::SimdLevel::Sse2,
+                                                  cppbitfield::SimdLevel::Avx2, cppbitfield::SimdLevel::Avx512 };
+        for (std::size_t l = 0; l < sizeof(levels) / sizeof(levels[0]); ++l) {
+            fn(levels[l]);
+        }
+    }
+
+} // namespace testutil
+
+#endif/*CPPBITFIELD_TESTUTIL_HPP*/